@@ -0,0 +1,77 @@
+set(LOGREPLAYER_ROOT_DIR "${BHUMAN_PREFIX}/Src")
+set(LOGREPLAYER_OUTPUT_DIR "${OUTPUT_PREFIX}/Build/${OS}/LogReplayer/$<CONFIG>")
+
+file(GLOB_RECURSE LOGREPLAYER_SOURCES
+    "${LOGREPLAYER_ROOT_DIR}/Modules/*.cpp" "${LOGREPLAYER_ROOT_DIR}/Modules/*.h")
+file(GLOB LOGREPLAYER_SOURCES_ADDITIONAL
+    "${LOGREPLAYER_ROOT_DIR}/Platform/*.cpp" "${LOGREPLAYER_ROOT_DIR}/Platform/*.h")
+list(APPEND LOGREPLAYER_SOURCES ${LOGREPLAYER_SOURCES_ADDITIONAL})
+file(GLOB_RECURSE LOGREPLAYER_SOURCES_ADDITIONAL
+    "${LOGREPLAYER_ROOT_DIR}/Representations/*.cpp" "${LOGREPLAYER_ROOT_DIR}/Representations/*.h"
+    "${LOGREPLAYER_ROOT_DIR}/Tools/*.c" "${LOGREPLAYER_ROOT_DIR}/Tools/*.cpp" "${LOGREPLAYER_ROOT_DIR}/Tools/*.h"
+    "${LOGREPLAYER_ROOT_DIR}/Platform/${OS}/*.cpp" "${LOGREPLAYER_ROOT_DIR}/Platform/${OS}/*.h"
+    "${LOGREPLAYER_ROOT_DIR}/Platform/${OS}/*.mm"
+    "${LOGREPLAYER_ROOT_DIR}/Threads/*.cpp" "${LOGREPLAYER_ROOT_DIR}/Threads/*.h"
+    "${LOGREPLAYER_ROOT_DIR}/Utils/LogReplayer/*.cpp" "${LOGREPLAYER_ROOT_DIR}/Utils/LogReplayer/*.h")
+list(APPEND LOGREPLAYER_SOURCES ${LOGREPLAYER_SOURCES_ADDITIONAL})
+list(APPEND LOGREPLAYER_SOURCES
+    "${LOGREPLAYER_ROOT_DIR}/Controller/LogPlayer.cpp" "${LOGREPLAYER_ROOT_DIR}/Controller/LogPlayer.h")
+
+add_executable(LogReplayer ${LOGREPLAYER_SOURCES})
+
+set_property(TARGET LogReplayer PROPERTY RUNTIME_OUTPUT_DIRECTORY "${LOGREPLAYER_OUTPUT_DIR}")
+set_property(TARGET LogReplayer PROPERTY FOLDER Utils)
+set_property(TARGET LogReplayer PROPERTY XCODE_GENERATE_SCHEME ON)
+
+if(APPLE)
+  target_include_directories(LogReplayer SYSTEM PRIVATE ${APP_KIT_FRAMEWORK} ${APP_KIT_FRAMEWORK}/Headers)
+  target_link_libraries(LogReplayer PRIVATE ${APP_KIT_FRAMEWORK})
+
+  target_include_directories(LogReplayer SYSTEM PRIVATE ${CORE_SERVICES_FRAMEWORK} ${CORE_SERVICES_FRAMEWORK}/Headers)
+  target_link_libraries(LogReplayer PRIVATE ${CORE_SERVICES_FRAMEWORK})
+
+  target_include_directories(LogReplayer SYSTEM PRIVATE ${IO_KIT_FRAMEWORK} ${IO_KIT_FRAMEWORK}/Headers)
+  target_link_libraries(LogReplayer PRIVATE ${IO_KIT_FRAMEWORK})
+endif()
+
+target_include_directories(LogReplayer PRIVATE "${LOGREPLAYER_ROOT_DIR}")
+target_include_directories(LogReplayer PRIVATE $<$<PLATFORM_ID:Windows>:${BHUMAN_PREFIX}/Util/Buildchain/Windows/include>)
+target_include_directories(LogReplayer PRIVATE "${BHUMAN_PREFIX}/Util/span-lite/include")
+target_include_directories(LogReplayer PRIVATE "${BHUMAN_PREFIX}/Util/bitpacker/include/bitpacker")
+target_include_directories(LogReplayer PRIVATE "${BHUMAN_PREFIX}/Util/bitproto/lib/c")
+target_include_directories(LogReplayer PRIVATE "${BHUMAN_PREFIX}/Util/rapidcsv")
+target_link_libraries(LogReplayer PRIVATE Eigen::Eigen)
+target_link_libraries(LogReplayer PRIVATE FFTW::FFTW FFTW::FFTWF)
+target_link_libraries(LogReplayer PRIVATE libjpeg::libjpeg)
+target_link_libraries(LogReplayer PRIVATE snappy::snappy)
+target_link_libraries(LogReplayer PRIVATE Qt5::Core Qt5::Gui)
+target_link_libraries(LogReplayer PRIVATE $<$<PLATFORM_ID:Windows>:winmm> $<$<PLATFORM_ID:Windows>:ws2_32>)
+target_link_libraries(LogReplayer PRIVATE $<$<PLATFORM_ID:Linux>:flite::flite_cmu_us_slt> $<$<PLATFORM_ID:Linux>:flite::flite_usenglish>
+    $<$<PLATFORM_ID:Linux>:flite::flite_cmulex> $<$<PLATFORM_ID:Linux>:flite::flite>)
+target_link_libraries(LogReplayer PRIVATE $<$<PLATFORM_ID:Linux>:ALSA::ALSA>)
+target_link_libraries(LogReplayer PRIVATE $<$<PLATFORM_ID:Linux>:-lpthread>)
+target_link_libraries(LogReplayer PRIVATE GameController::GameController)
+if(${PLATFORM} STREQUAL macOSarm64)
+  target_link_libraries(LogReplayer PRIVATE ONNXRuntime::ONNXRuntime)
+else()
+  target_link_libraries(LogReplayer PRIVATE asmjit)
+  target_link_libraries(LogReplayer PRIVATE CompiledNN)
+endif()
+target_compile_definitions(LogReplayer PRIVATE TARGET_SIM CONFIGURATION=$<CONFIG>)
+
+if(MSVC)
+  target_compile_options(LogReplayer PRIVATE /Zm200 $<$<CONFIG:Release>:/wd4101>)
+else()
+  target_compile_options(LogReplayer PRIVATE -Wno-return-stack-address -Wno-switch)
+endif()
+
+target_link_libraries(LogReplayer PRIVATE Flags::ForDevelop)
+target_precompile_headers(LogReplayer PRIVATE "${LOGREPLAYER_ROOT_DIR}/Tools/Precompiled/BHumanPch.h")
+
+source_group(TREE "${LOGREPLAYER_ROOT_DIR}" FILES ${LOGREPLAYER_SOURCES})
+
+if(WIN32)
+  add_custom_command(TARGET LogReplayer POST_BUILD
+      COMMAND ${CMAKE_COMMAND} -E copy_if_different
+      "$<TARGET_FILE:FFTW::FFTW>" "$<TARGET_FILE:FFTW::FFTWF>" "$<TARGET_FILE:Qt5::Core>" "$<TARGET_FILE:Qt5::Gui>" "$<TARGET_FILE_DIR:LogReplayer>")
+endif()
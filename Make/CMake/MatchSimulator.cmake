@@ -0,0 +1,78 @@
+set(MATCHSIMULATOR_ROOT_DIR "${BHUMAN_PREFIX}/Src")
+set(MATCHSIMULATOR_OUTPUT_DIR "${OUTPUT_PREFIX}/Build/${OS}/MatchSimulator/$<CONFIG>")
+
+file(GLOB_RECURSE MATCHSIMULATOR_SOURCES
+    "${MATCHSIMULATOR_ROOT_DIR}/Modules/*.cpp" "${MATCHSIMULATOR_ROOT_DIR}/Modules/*.h")
+file(GLOB MATCHSIMULATOR_SOURCES_ADDITIONAL
+    "${MATCHSIMULATOR_ROOT_DIR}/Platform/*.cpp" "${MATCHSIMULATOR_ROOT_DIR}/Platform/*.h")
+list(APPEND MATCHSIMULATOR_SOURCES ${MATCHSIMULATOR_SOURCES_ADDITIONAL})
+file(GLOB_RECURSE MATCHSIMULATOR_SOURCES_ADDITIONAL
+    "${MATCHSIMULATOR_ROOT_DIR}/Representations/*.cpp" "${MATCHSIMULATOR_ROOT_DIR}/Representations/*.h"
+    "${MATCHSIMULATOR_ROOT_DIR}/Tools/*.c" "${MATCHSIMULATOR_ROOT_DIR}/Tools/*.cpp" "${MATCHSIMULATOR_ROOT_DIR}/Tools/*.h"
+    "${MATCHSIMULATOR_ROOT_DIR}/Platform/${OS}/*.cpp" "${MATCHSIMULATOR_ROOT_DIR}/Platform/${OS}/*.h"
+    "${MATCHSIMULATOR_ROOT_DIR}/Platform/${OS}/*.mm"
+    "${MATCHSIMULATOR_ROOT_DIR}/Threads/*.cpp" "${MATCHSIMULATOR_ROOT_DIR}/Threads/*.h"
+    "${MATCHSIMULATOR_ROOT_DIR}/Utils/MatchSimulator/*.cpp" "${MATCHSIMULATOR_ROOT_DIR}/Utils/MatchSimulator/*.h")
+list(APPEND MATCHSIMULATOR_SOURCES ${MATCHSIMULATOR_SOURCES_ADDITIONAL})
+list(APPEND MATCHSIMULATOR_SOURCES
+    "${MATCHSIMULATOR_ROOT_DIR}/Controller/AbstractSimulatedRobot2D.cpp" "${MATCHSIMULATOR_ROOT_DIR}/Controller/AbstractSimulatedRobot2D.h"
+    "${MATCHSIMULATOR_ROOT_DIR}/Controller/GameController.cpp" "${MATCHSIMULATOR_ROOT_DIR}/Controller/GameController.h")
+
+add_executable(MatchSimulator ${MATCHSIMULATOR_SOURCES})
+
+set_property(TARGET MatchSimulator PROPERTY RUNTIME_OUTPUT_DIRECTORY "${MATCHSIMULATOR_OUTPUT_DIR}")
+set_property(TARGET MatchSimulator PROPERTY FOLDER Utils)
+set_property(TARGET MatchSimulator PROPERTY XCODE_GENERATE_SCHEME ON)
+
+if(APPLE)
+  target_include_directories(MatchSimulator SYSTEM PRIVATE ${APP_KIT_FRAMEWORK} ${APP_KIT_FRAMEWORK}/Headers)
+  target_link_libraries(MatchSimulator PRIVATE ${APP_KIT_FRAMEWORK})
+
+  target_include_directories(MatchSimulator SYSTEM PRIVATE ${CORE_SERVICES_FRAMEWORK} ${CORE_SERVICES_FRAMEWORK}/Headers)
+  target_link_libraries(MatchSimulator PRIVATE ${CORE_SERVICES_FRAMEWORK})
+
+  target_include_directories(MatchSimulator SYSTEM PRIVATE ${IO_KIT_FRAMEWORK} ${IO_KIT_FRAMEWORK}/Headers)
+  target_link_libraries(MatchSimulator PRIVATE ${IO_KIT_FRAMEWORK})
+endif()
+
+target_include_directories(MatchSimulator PRIVATE "${MATCHSIMULATOR_ROOT_DIR}")
+target_include_directories(MatchSimulator PRIVATE $<$<PLATFORM_ID:Windows>:${BHUMAN_PREFIX}/Util/Buildchain/Windows/include>)
+target_include_directories(MatchSimulator PRIVATE "${BHUMAN_PREFIX}/Util/span-lite/include")
+target_include_directories(MatchSimulator PRIVATE "${BHUMAN_PREFIX}/Util/bitpacker/include/bitpacker")
+target_include_directories(MatchSimulator PRIVATE "${BHUMAN_PREFIX}/Util/bitproto/lib/c")
+target_include_directories(MatchSimulator PRIVATE "${BHUMAN_PREFIX}/Util/rapidcsv")
+target_link_libraries(MatchSimulator PRIVATE Eigen::Eigen)
+target_link_libraries(MatchSimulator PRIVATE FFTW::FFTW FFTW::FFTWF)
+target_link_libraries(MatchSimulator PRIVATE libjpeg::libjpeg)
+target_link_libraries(MatchSimulator PRIVATE snappy::snappy)
+target_link_libraries(MatchSimulator PRIVATE Qt5::Core Qt5::Gui)
+target_link_libraries(MatchSimulator PRIVATE $<$<PLATFORM_ID:Windows>:winmm> $<$<PLATFORM_ID:Windows>:ws2_32>)
+target_link_libraries(MatchSimulator PRIVATE $<$<PLATFORM_ID:Linux>:flite::flite_cmu_us_slt> $<$<PLATFORM_ID:Linux>:flite::flite_usenglish>
+    $<$<PLATFORM_ID:Linux>:flite::flite_cmulex> $<$<PLATFORM_ID:Linux>:flite::flite>)
+target_link_libraries(MatchSimulator PRIVATE $<$<PLATFORM_ID:Linux>:ALSA::ALSA>)
+target_link_libraries(MatchSimulator PRIVATE $<$<PLATFORM_ID:Linux>:-lpthread>)
+target_link_libraries(MatchSimulator PRIVATE GameController::GameController)
+if(${PLATFORM} STREQUAL macOSarm64)
+  target_link_libraries(MatchSimulator PRIVATE ONNXRuntime::ONNXRuntime)
+else()
+  target_link_libraries(MatchSimulator PRIVATE asmjit)
+  target_link_libraries(MatchSimulator PRIVATE CompiledNN)
+endif()
+target_compile_definitions(MatchSimulator PRIVATE TARGET_SIM CONFIGURATION=$<CONFIG>)
+
+if(MSVC)
+  target_compile_options(MatchSimulator PRIVATE /Zm200 $<$<CONFIG:Release>:/wd4101>)
+else()
+  target_compile_options(MatchSimulator PRIVATE -Wno-return-stack-address -Wno-switch)
+endif()
+
+target_link_libraries(MatchSimulator PRIVATE Flags::ForDevelop)
+target_precompile_headers(MatchSimulator PRIVATE "${MATCHSIMULATOR_ROOT_DIR}/Tools/Precompiled/BHumanPch.h")
+
+source_group(TREE "${MATCHSIMULATOR_ROOT_DIR}" FILES ${MATCHSIMULATOR_SOURCES})
+
+if(WIN32)
+  add_custom_command(TARGET MatchSimulator POST_BUILD
+      COMMAND ${CMAKE_COMMAND} -E copy_if_different
+      "$<TARGET_FILE:FFTW::FFTW>" "$<TARGET_FILE:FFTW::FFTWF>" "$<TARGET_FILE:Qt5::Core>" "$<TARGET_FILE:Qt5::Gui>" "$<TARGET_FILE_DIR:MatchSimulator>")
+endif()
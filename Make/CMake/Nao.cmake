@@ -32,6 +32,7 @@ if(BUILD_NAO)
   target_link_libraries(Nao PRIVATE Eigen::Eigen)
   target_link_libraries(Nao PRIVATE Nao::FFTW::FFTW Nao::FFTW::FFTWF)
   target_link_libraries(Nao PRIVATE Nao::libjpeg::libjpeg)
+  target_link_libraries(Nao PRIVATE Nao::snappy::snappy)
   target_link_libraries(Nao PRIVATE Nao::flite::flite_cmu_us_slt Nao::flite::flite_usenglish Nao::flite::flite_cmulex Nao::flite::flite)
   target_link_libraries(Nao PRIVATE Nao::ALSA::ALSA)
   target_link_libraries(Nao PRIVATE GameController::GameController)
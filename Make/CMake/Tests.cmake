@@ -5,7 +5,17 @@ file(GLOB TESTS_SOURCES
     "${TESTS_ROOT_DIR}/Platform/${OS}/*.cpp" "${TESTS_ROOT_DIR}/Platform/${OS}/*.h" "${TESTS_ROOT_DIR}/Platform/${OS}/*.mm"
     "${TESTS_ROOT_DIR}/Platform/*.cpp" "${TESTS_ROOT_DIR}/Platform/*.h"
     "${TESTS_ROOT_DIR}/Tools/*.cpp" "${TESTS_ROOT_DIR}/Tools/*.h"
+    "${TESTS_ROOT_DIR}/Tools/Debugging/DebugDataTable.cpp" "${TESTS_ROOT_DIR}/Tools/Debugging/DebugDataTable.h"
+    "${TESTS_ROOT_DIR}/Tools/Debugging/DebugDrawings.cpp" "${TESTS_ROOT_DIR}/Tools/Debugging/DebugDrawings.h"
+    "${TESTS_ROOT_DIR}/Tools/Debugging/DebugRequest.cpp" "${TESTS_ROOT_DIR}/Tools/Debugging/DebugRequest.h"
     "${TESTS_ROOT_DIR}/Tools/Debugging/TimingManager.cpp" "${TESTS_ROOT_DIR}/Tools/Debugging/TimingManager.h"
+    "${TESTS_ROOT_DIR}/Tools/Debugging/Tracer.cpp" "${TESTS_ROOT_DIR}/Tools/Debugging/Tracer.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/ConnectedComponents.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/ConnectedComponents.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/CNS/CNSSSE.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/CNS/CNSSSE.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/CNS/CameraModelOpenCV.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/CNS/CameraModelOpenCV.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/CNS/CodedContour.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/CNS/CodedContour.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/CNS/LutRasterizer.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/CNS/LutRasterizer.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/CNS/TriangleMesh.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/CNS/TriangleMesh.h"
     "${TESTS_ROOT_DIR}/Tools/Math/Random.cpp" "${TESTS_ROOT_DIR}/Tools/Math/Random.h"
     "${TESTS_ROOT_DIR}/Tools/Math/RotationMatrix.cpp" "${TESTS_ROOT_DIR}/Tools/Math/RotationMatrix.h"
     "${TESTS_ROOT_DIR}/Tools/Logging/LoggingTools.cpp" "${TESTS_ROOT_DIR}/Tools/Logging/LoggingTools.h"
@@ -49,6 +59,7 @@ target_link_libraries(Tests PRIVATE $<$<PLATFORM_ID:Linux>:-lpthread>)
 
 target_link_libraries(Tests PRIVATE Eigen::Eigen)
 target_link_libraries(Tests PRIVATE GameController::GameController)
+target_link_libraries(Tests PRIVATE snappy::snappy)
 target_link_libraries(Tests PRIVATE GTest::GTest)
 
 target_compile_definitions(Tests PRIVATE TARGET_TOOL GTEST_DONT_DEFINE_FAIL GTEST_DONT_DEFINE_TEST GTEST_HAS_TR1_TUPLE=0)
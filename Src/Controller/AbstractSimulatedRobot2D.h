@@ -0,0 +1,132 @@
+/**
+ * @file AbstractSimulatedRobot2D.h
+ *
+ * This file declares the motion emulation of a robot in a 2D simulation.
+ * It does not depend on a simulation core. Instead, the core only has to
+ * provide the pose of the robot's body and accept velocities for it.
+ *
+ * @author Arne Hasselbring
+ */
+
+#pragma once
+
+#include "Representations/Configuration/BallSpecification.h"
+#include "Representations/Configuration/KickInfo.h"
+#include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/MotionControl/MotionRequest.h"
+#include "Tools/Streams/EnumIndexedArray.h"
+
+struct MotionInfo;
+
+class AbstractSimulatedRobot2D
+{
+public:
+  /** The constructor loads the kicks and cameras. The file search path must already be set. */
+  AbstractSimulatedRobot2D();
+
+  /** Virtual destructor for polymorphism. */
+  virtual ~AbstractSimulatedRobot2D() = default;
+
+  /**
+   * Does the abstract motion emulation for one simulation step.
+   * @param motionRequest The requested motion.
+   * @param motionInfo The actually executed motion.
+   * @param stepDuration The duration of the simulation step (in s).
+   */
+  void emulateMotion(const MotionRequest& motionRequest, MotionInfo& motionInfo, float stepDuration);
+
+protected:
+  /**
+   * Returns the rotation of the robot's body in the scene.
+   * @return The rotation (in radians).
+   */
+  virtual float getBodyRotation() const = 0;
+
+  /**
+   * Returns the position of the robot's body in the scene.
+   * @return The position (in m).
+   */
+  virtual Vector2f getBodyPosition() const = 0;
+
+  /**
+   * Sets the velocity of the robot's body until it is set again.
+   * @param linear The linear velocity in scene coordinates (in m/s).
+   * @param angular The angular velocity (in radians/s).
+   */
+  virtual void setBodyVelocity(const Vector2f& linear, float angular) = 0;
+
+  /**
+   * Moves the robot's body without changing its rotation.
+   * @param position The new position in the scene (in m).
+   */
+  virtual void moveBody(const Vector2f& position) = 0;
+
+  /**
+   * Kicks the ball, i.e. the ball is touched by this robot and gets a new velocity.
+   * @param velocity The velocity of the ball in scene coordinates (in m/s).
+   */
+  virtual void kickBall(const Vector2f& velocity) = 0;
+
+  ENUM_INDEXED_ARRAY(CameraInfo, CameraInfo::Camera) cameraInfos; /**< Information about the upper camera. */
+  CameraInfo::Camera currentCamera = CameraInfo::upper; /**< The camera from which the next camera info will be returned. */
+
+private:
+  void requestPlayDead();
+  void requestStand(bool high);
+  void requestWalkAtAbsoluteSpeed(const Pose2f& walkSpeed);
+  void requestWalkAtRelativeSpeed(const Pose2f& walkSpeed);
+  void requestWalkToPose(const Pose2f& walkTarget, const Pose2f& walkSpeed, bool keepTargetRotation, const MotionRequest::ObstacleAvoidance& obstacleAvoidance);
+  void requestWalkToBallAndKick(const BallState& ballEstimate, Angle targetDirection, KickInfo::KickType kickType, float kickPower, bool alignPrecisely, const Pose2f& walkSpeed, const MotionRequest::ObstacleAvoidance& obstacleAvoidance);
+  void requestWalkToBall(const Pose2f& kickPose, const Vector2f& ballPosition, const Pose2f& walkSpeed, const MotionRequest::ObstacleAvoidance& obstacleAvoidance);
+  void requestDribble(const BallState& ballEstimate, Angle targetDirection, const Pose2f& walkSpeed, const MotionRequest::ObstacleAvoidance& obstacleAvoidance);
+  void requestGetUp();
+  void requestKeyframeMotion(const KeyframeMotionRequest& keyframeMotionRequest);
+
+  void executePlayDead(MotionInfo& motionInfo);
+  void executeStand(MotionInfo& motionInfo);
+  void executeWalk(MotionInfo& motionInfo);
+  void executeKick(MotionInfo& motionInfo);
+  void executeFall(MotionInfo& motionInfo);
+  void executeGetUp(MotionInfo& motionInfo);
+  void executeKeyframeMotion(MotionInfo& motionInfo);
+
+  bool isNextLeftPhase(bool shouldBeLeft) const;
+  Rangea getRotationRange(bool isLeftPhase, const Pose2f& walkSpeedRatio) const;
+  void getTranslationRectangle(float rotation, const Pose2f& walkSpeedRatio, Vector2f& backRight, Vector2f& frontLeft) const;
+
+  struct KickDescriptor
+  {
+    KickInfo::KickType type;
+    float impactT; /**< The time within the phase when the ball gets the momentum. */
+    float duration; /**< The duration for actual kick phases. */
+    std::vector<Pose2f> steps; /**< The steps for in-walk-kicks (currently only one step is supported). */
+    Rangef distanceRange; /**< The range of distances that can be reached by this kick. */
+    float distanceDeviation; /**< The deviation of the distance as ratio of the actual distance. */
+    float direction; /**< The direction in which the ball travels. */
+    float directionDeviation; /**< The deviation of the direction. */
+  };
+
+  BallSpecification ballSpecification; /**< The ball specification. */
+  KickInfo kickInfo; /**< The kick info. */
+  std::array<KickDescriptor, KickInfo::numOfKickTypes> kicks; /**< How to model kicks. */
+
+  struct PhaseInfo
+  {
+    MotionPhase::Type motion = MotionPhase::playDead; /**< The motion phase type. */
+    float t = 0.f; /**< The current time within the phase. */
+    float duration = 0.f; /**< The duration of the phase. */
+    Pose2f step; /**< For walk phases: The step to make in this phase. */
+    bool isLeftPhase = false; /**< For walk phases: Is the left foot the swing foot? */
+    const KickDescriptor* kick = nullptr; /**< For walk-kick or kick phases: The kick descriptor in this phase. */
+    float kickPower = 1.f; /**< For walk-kick or kick phases: The kick power in this phase. */
+    bool performedAction = false; /**< For phases that do some action at a specific time point: Whether that action has been performed. */
+    KeyframeMotionRequest keyframeMotionRequest; /**< For keyframe motion phases: The keyframe motion. */
+  };
+
+  PhaseInfo currentPhase; /**< The current phase. */
+  float dt = 0.f; /**< The duration of the current simulation step (in s). */
+
+  const float baseWalkPeriod = 0.25f;
+  const Pose2f maxSpeed = Pose2f(70_deg, 250.f, 180.f); /**< The maximum speed of the robot. */
+  static constexpr float maxSpeedBackwards = 200.f; /**< The maximum backwards speed of the robot. */
+};
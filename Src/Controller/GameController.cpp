@@ -6,7 +6,6 @@
  */
 
 #include "GameController.h"
-#include "SimulatedRobot.h"
 #include "Platform/BHAssert.h"
 #include "Platform/Time.h"
 #include "Tools/Global.h"
@@ -44,7 +43,7 @@ GameController::GameController()
   fieldDimensions.xPosOwnPenaltyMark = 0.f;
 }
 
-void GameController::registerSimulatedRobot(int robot, SimulatedRobot& simulatedRobot)
+void GameController::registerSimulatedRobot(int robot, Player& simulatedRobot)
 {
   ASSERT(!robots[robot].simulatedRobot);
   robots[robot].simulatedRobot = &simulatedRobot;
@@ -53,7 +52,7 @@ void GameController::registerSimulatedRobot(int robot, SimulatedRobot& simulated
     robots[robot].info.penalty = robots[robot].lastPenalty = PENALTY_SUBSTITUTE;
   if(fieldDimensions.xPosOwnPenaltyMark == 0.f)
     fieldDimensions.load();
-  int team = gameInfo.playersPerTeam >= robot ? 0 : 1;
+  int team = robot < numOfRobots / 2 ? 0 : 1;
   teamInfos[team].players[robots[robot].info.number - 1].penalty = PENALTY_NONE;
 }
 
@@ -300,6 +299,23 @@ bool GameController::handleKickOffCommand(const std::string& command)
   return false;
 }
 
+bool GameController::handleHalfCommand(const std::string& command)
+{
+  if(gameInfo.state != STATE_INITIAL)
+    return false;
+  else if(command == "firstHalf")
+  {
+    gameInfo.firstHalf = 1;
+    return true;
+  }
+  else if(command == "secondHalf")
+  {
+    gameInfo.firstHalf = 0;
+    return true;
+  }
+  return false;
+}
+
 bool GameController::handleManualPlacementCommand(const std::string& command)
 {
   if(gameInfo.state != STATE_INITIAL && gameInfo.state != STATE_SET)
@@ -339,6 +355,8 @@ bool GameController::handleGlobalCommand(const std::string& command)
     return true;
   else if(handleKickOffCommand(command))
     return true;
+  else if(handleHalfCommand(command))
+    return true;
   else if(handleManualPlacementCommand(command))
     return true;
   else if(command == "gamePenaltyShootout")
@@ -606,9 +624,9 @@ void GameController::referee()
     if(automatic & bit(placeBall))
     {
       if(gameInfo.gamePhase == GAME_PHASE_PENALTYSHOOT || gameInfo.setPlay == SET_PLAY_PENALTY_KICK)
-        SimulatedRobot::moveBall(Vector3f(gameInfo.kickingTeam == 1 ? fieldDimensions.xPosOwnPenaltyMark : fieldDimensions.xPosOpponentPenaltyMark, 0.f, 50.f), true);
+        moveBall(Vector3f(gameInfo.kickingTeam == 1 ? fieldDimensions.xPosOwnPenaltyMark : fieldDimensions.xPosOpponentPenaltyMark, 0.f, 50.f));
       else
-        SimulatedRobot::moveBall(Vector3f(0.f, 0.f, 50.f), true);
+        moveBall(Vector3f(0.f, 0.f, 50.f));
     }
   }
   lastState = gameInfo.state;
@@ -714,7 +732,7 @@ void GameController::referee()
         //   - Players that clearly violate the rule by walking to or playing the ball before 10s
         //   - Players that are inside the circle after 10s because they are fallen or pushed
         Vector2f ballPos;
-        SimulatedRobot::getAbsoluteBallPosition(ballPos);
+        getBallPosition(ballPos);
         return Time::getTimeSince(timeWhenSetPlayBegan) > 10000 && (r.lastPose.translation - ballPos).squaredNorm() < sqr(750.f);
       };
 
@@ -758,7 +776,7 @@ void GameController::referee()
       else
       {
         Vector2f ballPos;
-        r.simulatedRobot->getAbsoluteBallPosition(ballPos);
+        getBallPosition(ballPos);
         placeForPenalty(i, fieldDimensions.xPosOpponentPenaltyMark,
                         ballPos.y() >= 0.f ? fieldDimensions.yPosRightSideline : fieldDimensions.yPosLeftSideline,
                         ballPos.y() >= 0.f ? pi_2 : -pi_2);
@@ -768,11 +786,11 @@ void GameController::referee()
     if(automatic & bit(clearBall) && r.simulatedRobot)
     {
       Vector2f ballPos;
-      r.simulatedRobot->getAbsoluteBallPosition(ballPos);
+      getBallPosition(ballPos);
       if((r.lastPose * Vector2f(50.f, 0.f) - ballPos).norm() > 50.f)
         r.timeWhenBallNotStuckBetweenLegs = Time::getCurrentSystemTime();
       else if(r.timeWhenBallNotStuckBetweenLegs && Time::getTimeSince(r.timeWhenBallNotStuckBetweenLegs) > 500)
-        SimulatedRobot::moveBall((Vector3f() << r.lastPose * Vector2f(150.f, 0.f), 50.f).finished(), true);
+        moveBall((Vector3f() << r.lastPose * Vector2f(150.f, 0.f), 50.f).finished());
     }
 
     r.lastPenalty = r.info.penalty;
@@ -859,11 +877,23 @@ void GameController::resetPenaltyTimes()
     robot.timeWhenPenalized = 0;
 }
 
+void GameController::getBallPosition(Vector2f& ballPosition) const
+{
+  if(ball)
+    ball->getPosition(ballPosition);
+}
+
+void GameController::moveBall(const Vector3f& pos)
+{
+  if(ball)
+    ball->move(pos, true);
+}
+
 GameController::BallOut GameController::updateBall()
 {
   BallOut result = notOut;
   Vector2f ballPos;
-  SimulatedRobot::getAbsoluteBallPosition(ballPos);
+  getBallPosition(ballPos);
   Vector2f ballInnerEdge(ballPos.x() - sgn(ballPos.x()) * (ballSpecification.radius + fieldDimensions.fieldLinesWidth / 2.f),
                          ballPos.y() - sgn(ballPos.y()) * (ballSpecification.radius + fieldDimensions.fieldLinesWidth / 2.f));
   if(!fieldDimensions.isInsideField(ballInnerEdge))
@@ -914,15 +944,15 @@ GameController::BallOut GameController::updateBall()
         result = lastBallContactPose.rotation == 0.f ? outBySecondTeam : outByFirstTeam;
       }
 
-      SimulatedRobot::moveBall(Vector3f(ballPos.x(), ballPos.y(), 100.f), true);
+      moveBall(Vector3f(ballPos.x(), ballPos.y(), 100.f));
     }
   }
   return result;
 }
 
-void GameController::setLastBallContactRobot(SimRobot::Object* robot)
+void GameController::setLastBallContactRobot(bool firstTeam, const Vector2f& position)
 {
-  lastBallContactPose = Pose2f(SimulatedRobot::isFirstTeam(robot) ? pi : 0.f, SimulatedRobot::getPosition(robot));
+  lastBallContactPose = Pose2f(firstTeam ? pi : 0.f, position);
   lastBallContactTime = Time::getCurrentSystemTime();
 }
 
@@ -1012,6 +1042,8 @@ void GameController::addCompletion(std::set<std::string>& completion) const
     "penaltyKickForSecondTeam",
     "kickOffFirstTeam",
     "kickOffSecondTeam",
+    "firstHalf",
+    "secondHalf",
     "gamePenaltyShootout",
     "gameNormal"
   };
@@ -16,12 +16,9 @@
 #include "Tools/Settings.h"
 #include "Tools/Streams/Enum.h"
 #include "Tools/Streams/InOut.h"
-#include <SimRobot.h>
 #include <set>
 #include <string>
 
-class SimulatedRobot;
-
 /**
  * The class simulates a console-based GameController.
  */
@@ -45,10 +42,56 @@ public:
 
   unsigned automatic = ~0u; /**< Which automatic features are active? */
 
+  static const int halfTime = 600; /**< The duration of a half (in s). */
+  static const int numOfRobots = 12; /**< The number of robots of both teams, including the substitutes. */
+
+  /** The interface through which the GameController accesses a simulated robot. */
+  class Player
+  {
+  public:
+    /** Virtual destructor for polymorphism. */
+    virtual ~Player() = default;
+
+    /**
+     * Determines the pose of the simulated robot.
+     * @param robotPose The determined pose of the robot.
+     */
+    virtual void getRobotPose(Pose2f& robotPose) const = 0;
+
+    /**
+     * Moves and rotates the robot to an absolute pose
+     * @param pos The position to move the robot to
+     * @param rot The target rotation (as euler angles; in radian)
+     * @param changeRotation Whether the rotation of the robot should be changed or not
+     */
+    virtual void moveRobot(const Vector3f& pos, const Vector3f& rot, bool changeRotation) = 0;
+  };
+
+  /** The interface through which the GameController accesses the simulated ball. */
+  class Ball
+  {
+  public:
+    /** Virtual destructor for polymorphism. */
+    virtual ~Ball() = default;
+
+    /**
+     * Determines the ball position in the scene (not considering the robot's color).
+     * @param ballPosition The position of the ball
+     */
+    virtual void getPosition(Vector2f& ballPosition) const = 0;
+
+    /**
+     * Moves the ball to the given position
+     * @param pos The position to move the ball to
+     * @param resetDynamics Reset dynamics of object after moving.
+     */
+    virtual void move(const Vector3f& pos, bool resetDynamics) = 0;
+  };
+
 private:
   struct Robot
   {
-    SimulatedRobot* simulatedRobot = nullptr;
+    Player* simulatedRobot = nullptr;
     RobotInfo info;
     unsigned timeWhenPenalized = 0;
     unsigned timeWhenBallNotStuckBetweenLegs = 0;
@@ -77,9 +120,7 @@ private:
   static const int numOfPenalties = numOfPenaltys; /**< Correct typo. */
 
   DECLARE_SYNC;
-  static const int numOfRobots = 12;
   static const int numOfFieldPlayers = numOfRobots / 2 - 2; // Keeper, Substitute
-  static const int halfTime = 600;
   static const int readyTime = 45;
   static const int penaltyKickReadyTime = 30;
   static const int kickOffTime = 10;
@@ -100,6 +141,7 @@ private:
   unsigned timeWhenStateBegan = 0;
   unsigned timeWhenSetPlayBegan = 0;
   Robot robots[numOfRobots];
+  Ball* ball = nullptr; /**< The simulated ball. */
 
   /** enum which declares the different types of balls leaving the field */
   enum BallOut
@@ -123,7 +165,13 @@ public:
    * @param robot The number of the robot [0 ... numOfRobots-1].
    * @param simulatedRobot The simulation interface of that robot.
    */
-  void registerSimulatedRobot(int robot, SimulatedRobot& simulatedRobot);
+  void registerSimulatedRobot(int robot, Player& simulatedRobot);
+
+  /**
+   * Sets the ball the automatic referee observes and places.
+   * @param ball The simulated ball.
+   */
+  void setBall(Ball& ball) { this->ball = &ball; }
 
   /**
    * Handles the parameters of the console command "gc".
@@ -145,9 +193,24 @@ public:
 
   /**
    * Proclaims which robot touched the ball at last
-   * @param robot The robot
+   * @param firstTeam Is the robot a member of the first team?
+   * @param position The position of the robot in the scene (in mm).
+   */
+  void setLastBallContactRobot(bool firstTeam, const Vector2f& position);
+
+  /**
+   * Returns the current game information. The remaining time is only
+   * updated when it is written to a robot.
+   * @return The game information.
    */
-  void setLastBallContactRobot(SimRobot::Object* robot);
+  const RawGameInfo& getGameInfo() const { return gameInfo; }
+
+  /**
+   * Returns the current information about a team.
+   * @param firstTeam The first team or the second team?
+   * @return The team information.
+   */
+  const TeamInfo& getTeamInfo(bool firstTeam) const { return teamInfos[firstTeam ? 0 : 1]; }
 
   /**
    * Write the current game information to the stream provided.
@@ -237,6 +300,12 @@ private:
    */
   bool handleKickOffCommand(const std::string& command);
 
+  /**
+   * Handles commands that select the half.
+   * @param command The second part of the command (without "gc").
+   */
+  bool handleHalfCommand(const std::string& command);
+
   /**
    * Handles commands that request manual placement.
    * @param command The second part of the command (without "gc").
@@ -303,4 +372,16 @@ private:
 
   /** Update the ball position based on the rules. */
   BallOut updateBall();
+
+  /**
+   * Determines the position of the ball if there is one.
+   * @param ballPosition The position of the ball in the scene (in mm).
+   */
+  void getBallPosition(Vector2f& ballPosition) const;
+
+  /**
+   * Moves the ball if there is one and stops it.
+   * @param pos The position to move the ball to (in mm).
+   */
+  void moveBall(const Vector3f& pos);
 };
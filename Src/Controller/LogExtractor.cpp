@@ -43,6 +43,13 @@
 #include "Tools/Streams/TypeInfo.h"
 #include <QImage>
 #include <QDir>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <type_traits>
 
 /**
@@ -73,6 +80,7 @@ bool LogExtractor::save(const std::string& fileName, const TypeInfo* typeInfo)
   if(logPlayer.state == LogPlayer::recording)
     logPlayer.recordStop();
 
+  logPlayer.loadAll();
   if(!logPlayer.getNumberOfMessages())
     return false;
 
@@ -101,6 +109,7 @@ bool LogExtractor::save(const std::string& fileName, const TypeInfo* typeInfo)
 
 bool LogExtractor::split(const std::string& fileName, const TypeInfo* typeInfo, const int& split)
 {
+  logPlayer.loadAll();
   int numberOfMessagesToWrite = static_cast<int>(std::ceil(logPlayer.getNumberOfMessages() / split));
   for(int i = 0; i < split; ++i)
   {
@@ -143,15 +152,15 @@ bool LogExtractor::saveAudioFile(const std::string& fileName)
 
   int frames = 0;
   AudioData audioData;
-  for(int currentMessageNumber = 0; currentMessageNumber < logPlayer.getNumberOfMessages(); ++currentMessageNumber)
+  logPlayer.forAllMessages([&](InMessage& message, int)
   {
-    logPlayer.queue.setSelectedMessageForReading(currentMessageNumber);
-    if(logPlayer.queue.getMessageID() == idAudioData)
+    if(message.getMessageID() == idAudioData)
     {
-      logPlayer.in.bin >> audioData;
+      message.bin >> audioData;
       frames += unsigned(audioData.samples.size()) / audioData.channels;
     }
-  }
+    return true;
+  }, {idAudioData});
 
   struct WAVHeader
   {
@@ -191,16 +200,16 @@ bool LogExtractor::saveAudioFile(const std::string& fileName)
   header->subchunk2Size = frames * audioData.channels * sizeof(AudioData::Sample);
 
   char* p = reinterpret_cast<char*>(header + 1);
-  for(int currentMessageNumber = 0; currentMessageNumber < logPlayer.getNumberOfMessages(); ++currentMessageNumber)
+  logPlayer.forAllMessages([&](InMessage& message, int)
   {
-    logPlayer.queue.setSelectedMessageForReading(currentMessageNumber);
-    if(logPlayer.queue.getMessageID() == idAudioData)
+    if(message.getMessageID() == idAudioData)
     {
-      logPlayer.in.bin >> audioData;
+      message.bin >> audioData;
       memcpy(p, audioData.samples.data(), audioData.samples.size() * sizeof(AudioData::Sample));
       p += audioData.samples.size() * sizeof(AudioData::Sample);
     }
-  }
+    return true;
+  }, {idAudioData});
 
   stream.write(header, length);
   delete[] header;
@@ -208,8 +217,9 @@ bool LogExtractor::saveAudioFile(const std::string& fileName)
   return true;
 }
 
-bool LogExtractor::saveImages(const std::string& path, const bool raw, const bool onlyPlaying, const int takeEachNthFrame = 1)
+namespace
 {
+  /** The lookup table for the CRC of PNG chunks. */
   class CRCLut : public std::array<unsigned int, 256>
   {
   public:
@@ -255,6 +265,155 @@ bool LogExtractor::saveImages(const std::string& path, const bool raw, const boo
     }
   };
 
+  /**
+   * Writes images together with their metadata as PNG files on a pool of
+   * worker threads. The log itself is still read sequentially, because a
+   * frame only contains the representations that were logged in it, i.e. the
+   * others keep their values from earlier frames. Therefore, only the expensive
+   * part, i.e. decompressing the JPEG images and encoding the PNG files, is done
+   * in parallel. As each image is written to a file of its own, the order in
+   * which the workers finish their jobs does not matter.
+   */
+  class ImageWriter
+  {
+  public:
+    /** Everything required to write a single image. */
+    struct Job
+    {
+      std::string filename; /**< The name of the PNG file. */
+      bool compressed; /**< Is the image in jpegImage (true) or in cameraImage (false)? */
+      JPEGImage jpegImage;
+      CameraImage cameraImage;
+      CameraInfo cameraInfo;
+      CameraMatrix cameraMatrix;
+      ImageCoordinateSystem imageCoordinateSystem;
+    };
+
+    /**
+     * Starts the workers.
+     * @param raw Save colors unconverted?
+     */
+    ImageWriter(bool raw) :
+      raw(raw)
+    {
+      const unsigned numOfWorkers = std::max(1u, std::thread::hardware_concurrency());
+      maxQueueSize = 2 * numOfWorkers;
+      for(unsigned i = 0; i < numOfWorkers; ++i)
+        workers.emplace_back(&ImageWriter::work, this);
+    }
+
+    ~ImageWriter()
+    {
+      finish();
+    }
+
+    /**
+     * Adds a job. If the workers are too far behind, this waits until one of
+     * them takes a job, so that no more than a few images are kept in memory.
+     * @param job The job. It is moved into the queue.
+     */
+    void push(std::unique_ptr<Job> job)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      spaceAvailable.wait(lock, [this] { return jobs.size() < maxQueueSize; });
+      jobs.emplace_back(std::move(job));
+      jobAvailable.notify_one();
+    }
+
+    /**
+     * Waits until all jobs are done and stops the workers.
+     * @return Were all images written successfully?
+     */
+    bool finish()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+      }
+      jobAvailable.notify_all();
+      for(std::thread& worker : workers)
+        worker.join();
+      workers.clear();
+      return !failed;
+    }
+
+  private:
+    const bool raw; /**< Save colors unconverted? */
+    const CRCLut crcLut;
+    std::vector<std::thread> workers;
+    std::mutex mutex; /**< Protects the members below. */
+    std::condition_variable jobAvailable; /**< Signals that there is a job or that no more jobs will come. */
+    std::condition_variable spaceAvailable; /**< Signals that a job was taken from the queue. */
+    std::deque<std::unique_ptr<Job>> jobs; /**< The jobs not yet taken by a worker. */
+    size_t maxQueueSize; /**< The maximum number of jobs waiting. */
+    bool done = false; /**< Will no more jobs be added? */
+    std::atomic<bool> failed{false}; /**< Could an image not be written? */
+
+    /** The main loop of a worker. */
+    void work()
+    {
+      while(true)
+      {
+        std::unique_ptr<Job> job;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          jobAvailable.wait(lock, [this] { return done || !jobs.empty(); });
+          if(jobs.empty())
+            return;
+          job = std::move(jobs.front());
+          jobs.pop_front();
+        }
+        spaceAvailable.notify_one();
+        if(!write(*job))
+          failed = true;
+      }
+    }
+
+    /**
+     * Writes a single image.
+     * @param job The image and its metadata.
+     * @return Was the file written successfully?
+     */
+    bool write(Job& job) const
+    {
+      if(job.compressed)
+        job.jpegImage.toCameraImage(job.cameraImage);
+
+      // Open PNG file
+      QFile qfile(job.filename.c_str());
+      if(!qfile.open(QIODevice::WriteOnly))
+        return false;
+
+      // Write image
+      if(!ImageExport::exportImage(job.cameraImage, qfile, raw ? ImageExport::raw : ImageExport::rgb))
+        return false;
+
+      // Remove IEND chunk
+      qfile.resize(qfile.size() - 12);
+
+      // Write metadata
+      OutBinaryMemory metaData;
+      metaData << job.cameraInfo;
+      metaData << job.cameraMatrix;
+      metaData << job.imageCoordinateSystem;
+      const unsigned int size = static_cast<unsigned int>(metaData.size());
+      for(size_t i = 0; i < 4; i++)
+        qfile.putChar(reinterpret_cast<const char*>(&size)[3 - i]);
+      qfile.write("bhMn");
+      qfile.write(metaData.data(), metaData.size());
+      const unsigned int crc = CRC().update(crcLut, "bhMn", 4).update(crcLut, metaData.data(), metaData.size()).finish();
+      for(size_t i = 0; i < 4; i++)
+        qfile.putChar(reinterpret_cast<const char*>(&crc)[3 - i]);
+
+      // Write IEND chunk
+      const std::array<char, 12> endChunk{ 0, 0, 0, 0, 'I', 'E', 'N', 'D', char(0xae), char(0x42), char(0x60), char(0x82) };
+      return qfile.write(endChunk.data(), endChunk.size()) == static_cast<qint64>(endChunk.size());
+    }
+  };
+}
+
+bool LogExtractor::saveImages(const std::string& path, const bool raw, const bool onlyPlaying, const int takeEachNthFrame = 1)
+{
   logPlayer.stop();
   DECLARE_REPRESENTATIONS_AND_MAP(
   {,
@@ -273,14 +432,14 @@ bool LogExtractor::saveImages(const std::string& path, const bool raw, const boo
 
   const std::string& folderPath = createNewFolder(path);
 
-  const CRCLut crcLut;
+  ImageWriter writer(raw);
 
   int skippedImageCount = 0;
 
   // Use DECLARE_REPRESENTATIONS_AND_MAP as soon as the hack is no longer needed
-  return goThroughLog(
-           representations,
-           [&](const std::string&)
+  const bool success = goThroughLog(
+                         representations,
+                         [&](const std::string&)
   {
     if(onlyPlaying &&
        (theGameInfo.state != STATE_PLAYING // isStateValid
@@ -289,19 +448,15 @@ bool LogExtractor::saveImages(const std::string& path, const bool raw, const boo
             && theFallDownState.state != FallDownState::staggering)/*isStanding*/))
       return true;
 
-    if(theJPEGImage.timestamp)
+    // Assume that CameraImage and JPEGImage are not logged at the same time.
+    const bool compressed = theJPEGImage.timestamp != 0;
+    const unsigned timestamp = compressed ? theJPEGImage.timestamp : theCameraImage.timestamp;
+
+    if(timestamp)
     {
-      theJPEGImage.toCameraImage(theCameraImage); // Assume that CameraImage and JPEGImage are not logged at the same time.
       theJPEGImage.timestamp = 0;
-    }
-
-    CameraImage* imageToExport = nullptr;
-
-    if(theCameraImage.timestamp)
-      imageToExport = &theCameraImage;
+      theCameraImage.timestamp = 0;
 
-    if(imageToExport)
-    {
       // Frame skipping: only count frames if they are from the upper camera so
       // that always a pair of lower and upper frames is saved
       if(theCameraInfo.camera == CameraInfo::upper && ++skippedImageCount == takeEachNthFrame)
@@ -309,40 +464,24 @@ bool LogExtractor::saveImages(const std::string& path, const bool raw, const boo
       if(skippedImageCount != 0)
         return true;
 
-      // Open PNG file
-      const std::string filename = ImageExport::expandImageFileName(folderPath + (theCameraInfo.camera == CameraInfo::upper ? "upper" : "lower"), imageToExport->timestamp);
-      QFile qfile(filename.c_str());
-      qfile.open(QIODevice::WriteOnly);
-
-      // Write image
-      ImageExport::exportImage(*imageToExport, qfile, raw ? ImageExport::raw : ImageExport::rgb);
-      imageToExport->timestamp = 0;
-
-      // Remove IEND chunk
-      qfile.resize(qfile.size() - 12);
-
-      // Write metadata
-      OutBinaryMemory metaData;
-      metaData << theCameraInfo;
-      metaData << theCameraMatrix;
-      metaData << theImageCoordinateSystem;
-      const unsigned int size = static_cast<unsigned int>(metaData.size());
-      for(size_t i = 0; i < 4; i++)
-        qfile.putChar(reinterpret_cast<const char*>(&size)[3 - i]);
-      qfile.write("bhMn");
-      qfile.write(metaData.data(), metaData.size());
-      const unsigned int crc = CRC().update(crcLut, "bhMn", 4).update(crcLut, metaData.data(), metaData.size()).finish();
-      for(size_t i = 0; i < 4; i++)
-        qfile.putChar(reinterpret_cast<const char*>(&crc)[3 - i]);
-
-      // Write IEND chunk
-      const std::array<char, 12> endChunk{ 0, 0, 0, 0, 'I', 'E', 'N', 'D', char(0xae), char(0x42), char(0x60), char(0x82) };
-      qfile.write(endChunk.data(), endChunk.size());
-      qfile.close();
+      // The image is decompressed by the worker.
+      std::unique_ptr<ImageWriter::Job> job = std::make_unique<ImageWriter::Job>();
+      job->filename = ImageExport::expandImageFileName(folderPath + (theCameraInfo.camera == CameraInfo::upper ? "upper" : "lower"), timestamp);
+      job->compressed = compressed;
+      if(compressed)
+        job->jpegImage = theJPEGImage;
+      else
+        job->cameraImage = theCameraImage;
+      job->cameraInfo = theCameraInfo;
+      job->cameraMatrix = theCameraMatrix;
+      job->imageCoordinateSystem = theImageCoordinateSystem;
+      writer.push(std::move(job));
     }
 
     return true;
   });
+
+  return writer.finish() && success;
 }
 
 bool LogExtractor::saveInertialSensorData(const std::string& path)
@@ -409,49 +548,49 @@ bool LogExtractor::writeTimingData(const std::string& fileName)
   std::map<unsigned short, std::string> names;/**<contains a mapping from watch id to watch name */
   std::map<unsigned, std::map<unsigned short, unsigned>> timings;/**<Contains a map from watch id to timing for each existing frame*/
   std::map<unsigned, unsigned> threadStartTimes;/**< After parsing this contains the start time of each frame (frames may be missing) */
-  for(int currentMessageNumber = 0; currentMessageNumber < logPlayer.getNumberOfMessages(); currentMessageNumber++)
+  logPlayer.forAllMessages([&](InMessage& message, int)
   {
-    logPlayer.queue.setSelectedMessageForReading(currentMessageNumber);
-    if(logPlayer.queue.getMessageID() == idStopwatch)
+    if(message.getMessageID() == idStopwatch)
     {
       //NOTE: this parser is a slightly modified version of the on in TimeInfo
       //first get the names
       unsigned short nameCount;
-      logPlayer.in.bin >> nameCount;
+      message.bin >> nameCount;
 
       for(unsigned short i = 0; i < nameCount; ++i)
       {
         std::string watchName;
         unsigned short watchId;
-        logPlayer.in.bin >> watchId;
-        logPlayer.in.bin >> watchName;
+        message.bin >> watchId;
+        message.bin >> watchName;
         if(names.find(watchId) == names.end()) //new name
           names[watchId] = watchName;
       }
 
       //now get timing data
       unsigned short dataCount;
-      logPlayer.in.bin >> dataCount;
+      message.bin >> dataCount;
 
       std::map<unsigned short, unsigned> frameTiming;
       for(unsigned short i = 0; i < dataCount; ++i)
       {
         unsigned short watchId;
         unsigned time;
-        logPlayer.in.bin >> watchId;
-        logPlayer.in.bin >> time;
+        message.bin >> watchId;
+        message.bin >> time;
 
         frameTiming[watchId] = time;
       }
       unsigned threadStartTime;
-      logPlayer.in.bin >> threadStartTime;
+      message.bin >> threadStartTime;
       unsigned frameNo;
-      logPlayer.in.bin >> frameNo;
+      message.bin >> frameNo;
 
       timings[frameNo] = frameTiming;
       threadStartTimes[frameNo] = threadStartTime;
     }
-  }
+    return true;
+  }, {idStopwatch});
 
   //now write the data to disk
   OutTextRawFile file(fileName);
@@ -759,28 +898,30 @@ bool LogExtractor::goThroughLog(const std::map<const MessageID, Streamable*>& re
 {
   std::string frameType;
   bool filled = false;
-  for(int currentMessageNumber = 0; currentMessageNumber < logPlayer.getNumberOfMessages(); currentMessageNumber++)
+
+  // Frames without any of the representations are never passed to executeAction,
+  // so they can be skipped.
+  std::vector<MessageID> ids;
+  for(const auto& representation : representations)
+    ids.push_back(representation.first);
+
+  return logPlayer.forAllMessages([&](InMessage& message, int)
   {
-    logPlayer.queue.setSelectedMessageForReading(currentMessageNumber);
-    MessageID message = logPlayer.queue.getMessageID();
-    auto repr = representations.find(message);
+    auto repr = representations.find(message.getMessageID());
     // repr == end() if not found
     if(repr != representations.end())
     {
       // Does not convert logs automatically now, can be found in LogDataProvider
-      logPlayer.in.bin >> *(repr->second);
+      message.bin >> *(repr->second);
       filled = true;
     }
-    else if(message == idFrameBegin)
+    else if(message.getMessageID() == idFrameBegin)
     {
-      frameType = logPlayer.in.readThreadIdentifier();
+      frameType = message.readThreadIdentifier();
       filled = false;
     }
-    else if(message == idFrameFinished && filled)
-    {
-      if(!executeAction(frameType))
-        return false;
-    }
-  }
-  return true;
+    else if(message.getMessageID() == idFrameFinished && filled)
+      return executeAction(frameType);
+    return true;
+  }, ids);
 }
@@ -64,6 +64,7 @@ public:
 
   /**
    * Writes all images in the log player queue to a bunch of image files (.png).
+   * The images are decompressed and encoded on a pool of worker threads.
    * @param path The path of the directory in which the images are created.
    * @param raw Save color unconverted
    * @param onlyPlaying Only save images from an upright, playing robot
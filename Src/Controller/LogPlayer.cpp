@@ -17,6 +17,7 @@
 #include "Tools/Debugging/DebugImages.h"
 #include "Tools/Logging/LoggingTools.h"
 
+#include <algorithm>
 #include <snappy-c.h>
 
 LogPlayer::LogPlayer(MessageQueue& targetQueue) :
@@ -37,6 +38,9 @@ void LogPlayer::init()
   typeInfo = nullptr;
   typeInfoReplayed = false;
   logfilePath = "";
+  chunkFile = nullptr;
+  loadedChunk = -1;
+  gcTimeIndexCreated = false;
 }
 
 bool LogPlayer::open(const std::string& fileName)
@@ -70,21 +74,24 @@ bool LogPlayer::open(const std::string& fileName)
     switch(magicByte)
     {
       case LoggingTools::logFileUncompressed: //regular log file
-        append(stream, stream.getFile()->getSize() - stream.getFile()->getPosition());
+        // Map the messages into memory instead of reading them. Skip the header of the queue.
+        if(!queue.map(stream.getFile()->getFullName(), stream.getFile()->getPosition() + 8))
+          append(stream, stream.getFile()->getSize() - stream.getFile()->getPosition());
         break;
       case LoggingTools::logFileCompressed: //compressed log file
+      {
+        std::vector<char> compressedBuffer;
+        std::vector<char> uncompressBuffer;
         while(!stream.eof())
         {
           unsigned compressedSize;
           stream >> compressedSize;
           ASSERT(compressedSize > 0);
-          std::vector<char> compressedBuffer;
           compressedBuffer.resize(compressedSize);
           stream.read(&compressedBuffer[0], compressedSize);
 
           size_t uncompressedSize = 0;
           snappy_uncompressed_length(&compressedBuffer[0], compressedSize, &uncompressedSize);
-          std::vector<char> uncompressBuffer;
           uncompressBuffer.resize(uncompressedSize);
           if(snappy_uncompress(&compressedBuffer[0], compressedSize, &uncompressBuffer[0], &uncompressedSize) != SNAPPY_OK)
             break;
@@ -92,15 +99,51 @@ bool LogPlayer::open(const std::string& fileName)
           mem >> *this;
         }
         break;
+      }
+      case LoggingTools::logFileIndexed: //chunked log file, possibly followed by an index
+      {
+        // Chunks are only decoded when their frames are needed. If the log file
+        // was not closed properly, the index is created from the chunk headers.
+        chunkFile = std::make_unique<InBinaryFile>(fileName);
+        if(chunkFile->exists()
+           && (LoggingTools::readIndex(*chunkFile, logIndex) || indexChunks(stream.getFile()->getPosition()))
+           && !logIndex.chunks.empty()
+           && std::all_of(logIndex.chunks.begin(), logIndex.chunks.end(), [this](const LoggingTools::ChunkInfo& chunk)
+                          {return chunk.header.thread < logIndex.threads.size();}))
+          break;
+        chunkFile = nullptr;
+        loadedChunk = -1;
+        queue.removeAllMessages();
+
+        const size_t fileSize = stream.getFile()->getSize();
+        while(!stream.eof())
+        {
+          LoggingTools::ChunkHeader header;
+          stream >> header;
+          if(!header.size || stream.getFile()->getPosition() + header.size > fileSize
+             || !readChunk(stream, header))
+            break; // end of chunks or truncated log file
+        }
+        break;
+      }
       default:
         logfilePath = "";
         return false; //unknown magic byte
     }
 
     stop();
-    countFrames();
-    createIndices();
-    upgradeFrames();
+    if(chunkFile)
+    {
+      // Indexed log files are never affected by upgradeFrames().
+      numberOfFrames = static_cast<int>(logIndex.chunks.size());
+      gcTimeIndex.fill(-1);
+    }
+    else
+    {
+      countFrames();
+      createIndices();
+      upgradeFrames();
+    }
     logfileMerged = false;
     loadLabels();
     return true;
@@ -108,6 +151,119 @@ bool LogPlayer::open(const std::string& fileName)
   return false;
 }
 
+void LogPlayer::loadAll()
+{
+  if(!chunkFile)
+    return;
+
+  const std::unique_ptr<InBinaryFile> file = std::move(chunkFile);
+  queue.removeAllMessages();
+  loadedChunk = -1;
+  for(size_t position : logIndex.positions)
+  {
+    file->getFile()->setPosition(position);
+    LoggingTools::ChunkHeader header;
+    *file >> header;
+    if(!readChunk(*file, header))
+      break;
+  }
+
+  // Keep the position, i.e. the end of the current frame.
+  countFrames();
+  createIndices();
+  currentFrameNumber = std::min(currentFrameNumber, numberOfFrames - 1);
+  currentMessageNumber = currentFrameNumber < 0 ? -1
+                         : currentFrameNumber + 1 < static_cast<int>(frameIndex.size()) ? frameIndex[currentFrameNumber + 1] - 1
+                         : numberOfMessagesWithinCompleteFrames - 1;
+}
+
+bool LogPlayer::readChunk(InBinaryFile& stream, const LoggingTools::ChunkHeader& header)
+{
+  if(header.compression == LoggingTools::uncompressed)
+    stream >> *this;
+  else
+  {
+    compressedBuffer.resize(header.size);
+    stream.read(compressedBuffer.data(), header.size);
+    uncompressedBuffer.resize(header.uncompressedSize);
+    if(!LoggingTools::decompress(compressedBuffer.data(), header.size, uncompressedBuffer.data(), header.uncompressedSize))
+      return false;
+    InBinaryMemory mem(uncompressedBuffer.data(), header.uncompressedSize);
+    mem >> *this;
+  }
+  return true;
+}
+
+bool LogPlayer::indexChunks(size_t position)
+{
+  File& file = *chunkFile->getFile();
+  const size_t fileSize = file.getSize();
+  logIndex = LoggingTools::LogIndex();
+
+  // Only the headers are read. The payloads are skipped.
+  while(true)
+  {
+    file.setPosition(position);
+    if(chunkFile->eof())
+      break;
+    LoggingTools::ChunkHeader header;
+    *chunkFile >> header;
+    const size_t payload = file.getPosition();
+    if(!header.size || payload + header.size > fileSize)
+      break; // end of chunks or truncated log file
+
+    LoggingTools::ChunkInfo& info = logIndex.chunks.emplace_back();
+    info.header = header;
+    std::memset(info.messageIDs, 0xff, sizeof(info.messageIDs)); // Nothing is known about the contents.
+    logIndex.positions.push_back(position);
+    if(header.thread >= logIndex.threads.size())
+      logIndex.threads.resize(header.thread + 1);
+    position = payload + header.size;
+  }
+
+  // The names of the threads are only stored in the index, but each frame begins with it.
+  for(size_t thread = 0; thread < logIndex.threads.size(); ++thread)
+  {
+    const auto chunk = std::find_if(logIndex.chunks.begin(), logIndex.chunks.end(), [thread](const LoggingTools::ChunkInfo& chunk)
+                                    {return chunk.header.thread == thread;});
+    if(chunk != logIndex.chunks.end() && loadChunk(static_cast<int>(chunk - logIndex.chunks.begin())) && !isEmpty())
+    {
+      queue.setSelectedMessageForReading(0);
+      if(queue.getMessageID() == idFrameBegin)
+        logIndex.threads[thread] = in.readThreadIdentifier();
+    }
+  }
+  return !logIndex.chunks.empty();
+}
+
+bool LogPlayer::loadChunk(int chunk)
+{
+  if(chunk != loadedChunk)
+  {
+    queue.removeAllMessages();
+    loadedChunk = -1;
+    chunkFile->getFile()->setPosition(logIndex.positions[chunk]);
+    LoggingTools::ChunkHeader header;
+    *chunkFile >> header;
+    if(!readChunk(*chunkFile, header))
+    {
+      queue.removeAllMessages();
+      return false;
+    }
+    loadedChunk = chunk;
+    numberOfMessagesWithinCompleteFrames = getNumberOfMessages();
+  }
+  return true;
+}
+
+bool LogPlayer::prepareFrame(int frame)
+{
+  if(!chunkFile)
+    return true;
+  currentMessageNumber = -1;
+  return loadChunk(frame) && !isEmpty();
+}
+
 void LogPlayer::play()
 {
   state = playing;
@@ -128,7 +284,7 @@ void LogPlayer::stop()
 
 void LogPlayer::pause()
 {
-  if(getNumberOfMessages() == 0)
+  if(getNumberOfMessages() == 0 && !chunkFile)
     state = initial;
   else
     state = paused;
@@ -145,10 +301,13 @@ void LogPlayer::stepBackward()
       currentFrameNumber = numberOfFrames - 1;
     else
       return;
-    ASSERT(currentFrameNumber < static_cast<int>(frameIndex.size()));
-    currentMessageNumber = frameIndex[currentFrameNumber];
+    if(!chunkFile)
+    {
+      ASSERT(currentFrameNumber < static_cast<int>(frameIndex.size()));
+      currentMessageNumber = frameIndex[currentFrameNumber];
 
-    queue.setSelectedMessageForReading(currentMessageNumber);
+      queue.setSelectedMessageForReading(currentMessageNumber);
+    }
     stepRepeat();
   }
 }
@@ -173,7 +332,7 @@ void LogPlayer::stepForward()
   pause();
   if(state == paused)
   {
-    if(currentFrameNumber >= numberOfFrames - 1 || currentMessageNumber >= numberOfMessagesWithinCompleteFrames - 1)
+    if(currentFrameNumber >= numberOfFrames - 1 || (!chunkFile && currentMessageNumber >= numberOfMessagesWithinCompleteFrames - 1))
     {
       if(loop && numberOfFrames > 0)
       {
@@ -186,15 +345,16 @@ void LogPlayer::stepForward()
 
     replayTypeInfo();
 
-    do
-    {
-      copyMessage(++currentMessageNumber, targetQueue);
-      if(queue.getMessageID() == idCameraImage
-         || queue.getMessageID() == idJPEGImage
-         || queue.getMessageID() == idThumbnail)
-        lastImageFrameNumber = currentFrameNumber + 1;
-    }
-    while(queue.getMessageID() != idFrameFinished);
+    if(prepareFrame(currentFrameNumber + 1))
+      do
+      {
+        copyMessage(++currentMessageNumber, targetQueue);
+        if(queue.getMessageID() == idCameraImage
+           || queue.getMessageID() == idJPEGImage
+           || queue.getMessageID() == idThumbnail)
+          lastImageFrameNumber = currentFrameNumber + 1;
+      }
+      while(queue.getMessageID() != idFrameFinished && currentMessageNumber < numberOfMessagesWithinCompleteFrames - 1);
 
     ++currentFrameNumber;
   }
@@ -221,7 +381,7 @@ void LogPlayer::stepRepeat()
   if(state == paused && currentFrameNumber >= 0)
   {
     --currentFrameNumber;
-    currentMessageNumber = currentFrameNumber >= 0 ? frameIndex[currentFrameNumber] - 1 : -1;
+    currentMessageNumber = currentFrameNumber >= 0 && !chunkFile ? frameIndex[currentFrameNumber] - 1 : -1;
     stepForward();
   }
 }
@@ -233,18 +393,21 @@ void LogPlayer::gotoFrame(int frame)
   if(state == paused && frame < numberOfFrames)
   {
     currentFrameNumber = frame - 1;
-    currentMessageNumber = currentFrameNumber >= 0 ? frameIndex[currentFrameNumber] - 1 : -1;
+    currentMessageNumber = currentFrameNumber >= 0 && !chunkFile ? frameIndex[currentFrameNumber] - 1 : -1;
     stepForward();
   }
 }
 
 int LogPlayer::getFrameForRemainingGCTime(int time)
 {
+  if(!gcTimeIndexCreated)
+    createGCTimeIndex();
   return time < 0 || time >= static_cast<int>(gcTimeIndex.size()) ? -1 : gcTimeIndex[time];
 }
 
 void LogPlayer::recordStart()
 {
+  loadAll();
   state = recording;
 }
 
@@ -283,15 +446,16 @@ bool LogPlayer::replay()
     {
       replayTypeInfo();
 
-      do
-      {
-        copyMessage(++currentMessageNumber, targetQueue);
-        if(queue.getMessageID() == idCameraImage
-           || queue.getMessageID() == idJPEGImage
-           || queue.getMessageID() == idThumbnail)
-          lastImageFrameNumber = currentFrameNumber + 1;
-      }
-      while(queue.getMessageID() != idFrameFinished && currentMessageNumber < numberOfMessagesWithinCompleteFrames - 1);
+      if(prepareFrame(currentFrameNumber + 1))
+        do
+        {
+          copyMessage(++currentMessageNumber, targetQueue);
+          if(queue.getMessageID() == idCameraImage
+             || queue.getMessageID() == idJPEGImage
+             || queue.getMessageID() == idThumbnail)
+            lastImageFrameNumber = currentFrameNumber + 1;
+        }
+        while(queue.getMessageID() != idFrameFinished && currentMessageNumber < numberOfMessagesWithinCompleteFrames - 1);
 
       ++currentFrameNumber;
       if(currentFrameNumber == numberOfFrames - 1)
@@ -316,10 +480,25 @@ bool LogPlayer::replay()
   return false;
 }
 
+bool LogPlayer::skipFrame()
+{
+  if(currentFrameNumber < numberOfFrames - 1)
+  {
+    // Chunks decoded on demand need not be decoded to be skipped.
+    if(!chunkFile)
+      do
+        queue.setSelectedMessageForReading(++currentMessageNumber);
+      while(queue.getMessageID() != idFrameFinished && currentMessageNumber < numberOfMessagesWithinCompleteFrames - 1);
+    ++currentFrameNumber;
+    return true;
+  }
+  return false;
+}
+
 MessageQueue LogPlayer::copyNextFrame()
 {
   MessageQueue copiedFrame;
-  if(currentFrameNumber < numberOfFrames - 1)
+  if(currentFrameNumber < numberOfFrames - 1 && prepareFrame(currentFrameNumber + 1))
   {
     int copyMessageNumber = currentMessageNumber;
     do
@@ -337,6 +516,7 @@ MessageQueue LogPlayer::copyNextFrame()
 
 void LogPlayer::keep(const std::function<bool(InMessage&)>& filter)
 {
+  loadAll();
   stop();
   LogPlayer temp(static_cast<MessageQueue&>(*this));
   temp.setSize(queue.getSize());
@@ -355,6 +535,7 @@ void LogPlayer::keep(const std::function<bool(InMessage&)>& filter)
 
 void LogPlayer::keepFrames(const std::function<bool(InMessage&)>& filter)
 {
+  loadAll();
   stop();
   LogPlayer temp(static_cast<MessageQueue&>(*this));
   temp.setSize(queue.getSize());
@@ -388,6 +569,7 @@ void LogPlayer::keepFrames(const std::function<bool(InMessage&)>& filter)
 
 void LogPlayer::keepFramesByThreadIdentifier(const std::function<bool(std::string)>& filter)
 {
+  loadAll();
   stop();
   LogPlayer temp(static_cast<MessageQueue&>(*this));
   temp.setSize(queue.getSize());
@@ -419,6 +601,7 @@ void LogPlayer::keepFramesByThreadIdentifier(const std::function<bool(std::strin
 
 void LogPlayer::trim(int startFrame, int endFrame)
 {
+  loadAll();
   stop();
   LogPlayer temp(static_cast<MessageQueue&>(*this));
   temp.setSize(queue.getSize());
@@ -437,6 +620,7 @@ void LogPlayer::trim(int startFrame, int endFrame)
 
 void LogPlayer::keep(const std::vector<int>& messageNumbers)
 {
+  loadAll();
   stop();
   LogPlayer temp(static_cast<MessageQueue&>(*this));
   temp.setSize(queue.getSize());
@@ -464,7 +648,22 @@ void LogPlayer::statistics(int frequencies[numOfDataMessageIDs], unsigned* sizes
         sizes[id] = 0;
   }
 
-  if(getNumberOfMessages() > 0)
+  if(chunkFile)
+  {
+    // The index tells which thread logged a chunk, so chunks of other threads are not decoded.
+    for(int chunk = 0; chunk < numberOfFrames; ++chunk)
+      if((threadIdentifier.empty() || threadIdentifier == logIndex.threads[logIndex.chunks[chunk].header.thread])
+         && loadChunk(chunk))
+        for(int i = 0; i < getNumberOfMessages(); ++i)
+        {
+          queue.setSelectedMessageForReading(i);
+          ASSERT(queue.getMessageID() < numOfDataMessageIDs);
+          ++frequencies[queue.getMessageID()];
+          if(sizes)
+            sizes[queue.getMessageID()] += queue.getMessageSize() + 4;
+        }
+  }
+  else if(getNumberOfMessages() > 0)
   {
     int current = queue.getSelectedMessageForReading();
     std::string currentThread;
@@ -487,33 +686,85 @@ void LogPlayer::statistics(int frequencies[numOfDataMessageIDs], unsigned* sizes
 
 void LogPlayer::createIndices()
 {
-  GameInfo gameInfo;
-  OutBinaryMemory gameInfoSize(256);
-  gameInfoSize << gameInfo;
-
   queue.createIndex();
   frameIndex.clear();
   frameIndex.reserve(numberOfFrames);
-  gcTimeIndex.fill(-1);
-  int frame = 0;
   for(int i = 0; i < getNumberOfMessages(); ++i)
   {
     queue.setSelectedMessageForReading(i);
-    const MessageID id = queue.getMessageID();
-    if(id == idFrameBegin)
+    if(queue.getMessageID() == idFrameBegin)
       frameIndex.push_back(i);
-    else if(id == idGameInfo && queue.getMessageSize() == static_cast<int>(gameInfoSize.size()))
+  }
+  createGCTimeIndex();
+}
+
+void LogPlayer::createGCTimeIndex()
+{
+  GameInfo gameInfo;
+  OutBinaryMemory gameInfoSize(256);
+  gameInfoSize << gameInfo;
+
+  gcTimeIndex.fill(-1);
+  forAllMessages([&](InMessage& message, int frame)
+  {
+    if(message.getMessageID() == idGameInfo && message.getMessageSize() == static_cast<int>(gameInfoSize.size()))
     {
-      in.bin >> gameInfo;
+      message.bin >> gameInfo;
       const int time = gameInfo.secsRemaining;
       if(time >= 0 && time < static_cast<int>(gcTimeIndex.size()) && gcTimeIndex[time] == -1)
       {
         gcTimeIndex[time] = frame;
       }
     }
-    else if(id == idFrameFinished)
-      ++frame;
+    return true;
+  }, {idGameInfo});
+  gcTimeIndexCreated = true;
+}
+
+bool LogPlayer::forAllMessages(const std::function<bool(InMessage& message, int frame)>& handler,
+                               const std::vector<MessageID>& ids)
+{
+  if(!chunkFile)
+  {
+    int frame = 0;
+    for(int i = 0; i < getNumberOfMessages(); ++i)
+    {
+      queue.setSelectedMessageForReading(i);
+      in.text.reset();
+      if(!handler(in, frame))
+        return false;
+      if(queue.getMessageID() == idFrameFinished)
+        ++frame;
+    }
+    return true;
+  }
+
+  // The index refers to the message ids as they are used in the log file.
+  std::vector<unsigned char> logIDs;
+  if(queue.numOfMappedIDs)
+  {
+    for(unsigned char i = 0; i < queue.numOfMappedIDs; ++i)
+      if(std::find(ids.begin(), ids.end(), queue.mappedIDs[i]) != ids.end())
+        logIDs.push_back(i);
   }
+  else
+    for(MessageID id : ids)
+      logIDs.push_back(static_cast<unsigned char>(id));
+
+  for(int frame = 0; frame < numberOfFrames; ++frame)
+  {
+    const LoggingTools::ChunkInfo& chunk = logIndex.chunks[frame];
+    if((ids.empty() || std::any_of(logIDs.begin(), logIDs.end(), [&chunk](unsigned char id) {return chunk.contains(id);}))
+       && loadChunk(frame))
+      for(int i = 0; i < getNumberOfMessages(); ++i)
+      {
+        queue.setSelectedMessageForReading(i);
+        in.text.reset();
+        if(!handler(in, frame))
+          return false;
+      }
+  }
+  return true;
 }
 
 void LogPlayer::countFrames()
@@ -543,6 +794,7 @@ void LogPlayer::replayTypeInfo()
 
 void LogPlayer::merge()
 {
+  loadAll();
   stop();
 
   if(logfileMerged || logfilePath.empty())
@@ -567,6 +819,7 @@ void LogPlayer::merge()
     OUTPUT_ERROR("Could not open " << logOtherFile);
     return;
   }
+  logOther.loadAll();
 
   //copy the currently loaded log file
   LogPlayer logCopy(static_cast<MessageQueue&>(*this));
@@ -718,6 +971,7 @@ void LogPlayer::loadLabels()
 
     if(imageSet.labelImages.size() > 0)
     {
+      loadAll();
       LogPlayer cognitionLog(static_cast<MessageQueue&>(*this));
       cognitionLog.setSize(queue.getSize());
 
@@ -817,6 +1071,12 @@ void LogPlayer::loadLabels()
 
 std::string LogPlayer::getThreadIdentifierOfNextFrame()
 {
+  if(chunkFile)
+  {
+    // At the end, the thread of the last frame is returned as for a complete queue.
+    const int frame = currentFrameNumber < numberOfFrames - 1 ? currentFrameNumber + 1 : currentFrameNumber;
+    return frame >= 0 ? logIndex.threads[logIndex.chunks[frame].header.thread] : "";
+  }
   if(currentMessageNumber < queue.numberOfMessages - 1)
   {
     queue.setSelectedMessageForReading(currentMessageNumber + 1);
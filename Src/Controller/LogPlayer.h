@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Tools/Function.h"
+#include "Tools/Logging/LoggingTools.h"
 #include "Tools/MessageQueue/MessageQueue.h"
 #include "Tools/Streams/TypeInfo.h"
 
@@ -56,7 +57,13 @@ private:
   int replayOffset;
   std::vector<int> frameIndex; /**< The message numbers the frames start at. */
   std::array<int, 601> gcTimeIndex; /**< The frames correspending to Game Controller times. */
+  bool gcTimeIndexCreated = false; /**< Was gcTimeIndex already filled? It is created lazily if chunks are decoded on demand. */
   std::unique_ptr<TypeInfo> typeInfo; /**< The type information of the log file entries. */
+  std::unique_ptr<InBinaryFile> chunkFile; /**< The log file if its chunks are decoded on demand. Then, the queue only contains the chunk loadedChunk. */
+  LoggingTools::LogIndex logIndex; /**< The index of the chunks in chunkFile. Each chunk contains exactly one frame. */
+  int loadedChunk = -1; /**< The chunk currently decoded into the queue or -1 if none is. */
+  std::vector<char> compressedBuffer; /**< Buffer for a compressed chunk, reused for all chunks. */
+  std::vector<char> uncompressedBuffer; /**< Buffer for a decompressed chunk, reused for all chunks. */
 
 public:
   /**
@@ -68,12 +75,34 @@ public:
   void init();
 
   /**
-   * Opens a log file and reads all messages into the queue.
+   * Opens a log file and reads all messages into the queue. If the log file
+   * has an index, the chunks are only decoded when their frames are replayed.
    * @param fileName the name of the file to open
    * @return if the reading was successful
    */
   bool open(const std::string& fileName);
 
+  /**
+   * Decodes all chunks of the log file into the queue if they are decoded on
+   * demand so far. This must be called before accessing the queue directly.
+   * All methods that edit the log file do that themselves.
+   */
+  void loadAll();
+
+  /**
+   * Calls a function for all messages of the log file in their order. If the
+   * chunks of the log file are decoded on demand, they are decoded one at a
+   * time and chunks that do not contain any of the given message ids are
+   * skipped based on the index.
+   * @param handler The function called for each message with the number of
+   *                the frame the message belongs to. Returning false stops.
+   * @param ids Only frames that contain at least one of these message ids must
+   *            be visited. If empty, all frames are visited.
+   * @return Were all messages visited, i.e. did the handler never return false?
+   */
+  bool forAllMessages(const std::function<bool(InMessage& message, int frame)>& handler,
+                      const std::vector<MessageID>& ids = {});
+
   /**
    * Plays the queue.
    * Note that you have to call replay() regularly if you want to use that function
@@ -136,6 +165,13 @@ public:
    */
   bool replay();
 
+  /**
+   * Skips the next frame without replaying it, e.g. because the thread it
+   * is meant for does not exist.
+   * @return Was a frame skipped?
+   */
+  bool skipFrame();
+
   /**
    *
    * @return
@@ -215,6 +251,45 @@ private:
    */
   void createIndices();
 
+  /** Creates the index of frames corresponding to Game Controller times. */
+  void createGCTimeIndex();
+
+  /**
+   * Decodes a chunk of a log file in the format logFileIndexed and appends its
+   * messages to the queue.
+   * @param stream The log file. Its position must be behind the header of the chunk.
+   * @param header The header of the chunk.
+   * @return Could the chunk be decoded?
+   */
+  bool readChunk(InBinaryFile& stream, const LoggingTools::ChunkHeader& header);
+
+  /**
+   * Creates logIndex for chunkFile if it has no index, e.g. because it was
+   * not closed properly. Only the headers of the chunks are read, except for
+   * the first chunk of each thread, from which the name of the thread is taken.
+   * As the contents of the chunks are unknown, they are assumed to contain all
+   * message ids.
+   * @param position The position of the first chunk in the file.
+   * @return Was at least one complete chunk found?
+   */
+  bool indexChunks(size_t position);
+
+  /**
+   * Replaces the messages in the queue by the ones of a chunk of chunkFile.
+   * @param chunk The number of the chunk, which is also the number of its frame.
+   * @return Could the chunk be decoded?
+   */
+  bool loadChunk(int chunk);
+
+  /**
+   * Prepares replaying a frame. If chunks are decoded on demand, the chunk of the
+   * frame is decoded and currentMessageNumber is set to the position in front of it.
+   * Otherwise, nothing has to be done, because the frame follows currentMessageNumber.
+   * @param frame The number of the frame.
+   * @return Are there messages to replay?
+   */
+  bool prepareFrame(int frame);
+
   /** Renames all frames called "Upper" that contain lower camera data to "Lower". */
   void upgradeFrames();
 };
@@ -125,7 +125,7 @@ void RemoteRobot::update()
                        (isConnected() ? QString(": connected to ") + QString::fromStdString(ip) + ", " + buf
                         : QString(": connection lost from ") + QString::fromStdString(ip));
 
-  if(logPlayer.getNumberOfMessages() != 0)
+  if(logPlayer.numberOfFrames != 0)
   {
     sprintf(buf, "%u", logPlayer.numberOfFrames);
     statusText += QString(", recorded ") + buf;
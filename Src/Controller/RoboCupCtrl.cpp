@@ -99,6 +99,7 @@ bool RoboCupCtrl::compile()
   if(balls)
   {
     SimulatedRobot::setBall(application->getObjectChild(*balls, 0));
+    gameController.setBall(ball);
     if(is2D)
     {
       SimRobotCore2D::Geometry* ballGeom = static_cast<SimRobotCore2D::Geometry*>(application->resolveObject("RoboCup.balls.ball.DiskGeometry", SimRobotCore2D::geometry));
@@ -257,7 +258,7 @@ void RoboCupCtrl::collided(SimRobotCore2::Geometry&, SimRobotCore2::Geometry& ge
   if(!body)
     return;
   body = body->getRootBody();
-  controller->gameController.setLastBallContactRobot(body);
+  controller->gameController.setLastBallContactRobot(SimulatedRobot::isFirstTeam(body), SimulatedRobot::getPosition(body));
 }
 
 void RoboCupCtrl::collided(SimRobotCore2D::Geometry&, SimRobotCore2D::Geometry& geom2)
@@ -266,5 +267,5 @@ void RoboCupCtrl::collided(SimRobotCore2D::Geometry&, SimRobotCore2D::Geometry&
   if(!body)
     return;
   body = body->getRootBody();
-  controller->gameController.setLastBallContactRobot(body);
+  controller->gameController.setLastBallContactRobot(SimulatedRobot::isFirstTeam(body), SimulatedRobot::getPosition(body));
 }
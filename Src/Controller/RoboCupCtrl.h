@@ -45,7 +45,15 @@ protected:
   std::array<std::string, 2> scenarios = {"Default", "Default"}; /**< The scenarios for simulated robots per team. */
 
 private:
+  /** Gives the GameController access to the simulated ball. */
+  class Ball : public GameController::Ball
+  {
+    void getPosition(Vector2f& ballPosition) const override { SimulatedRobot::getAbsoluteBallPosition(ballPosition); }
+    void move(const Vector3f& pos, bool resetDynamics) override { SimulatedRobot::moveBall(pos, resetDynamics); }
+  };
+
   QList<SimRobot::Object*> views; /**< List of registered views */
+  Ball ball; /**< The interface to the simulated ball for the GameController. */
 
 public:
   RoboCupCtrl(SimRobot::Application& application);
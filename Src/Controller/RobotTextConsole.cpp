@@ -1502,8 +1502,12 @@ bool RobotTextConsole::log(In& stream)
     logPlayer.statistics(frequencies, sizes);
 
     float size = 0;
+    unsigned total = 0;
     FOREACH_ENUM(MessageID, id, numOfDataMessageIDs)
+    {
       size += static_cast<float>(sizes[id]);
+      total += frequencies[id];
+    }
 
     char buf[100];
     FOREACH_ENUM(MessageID, id, numOfDataMessageIDs)
@@ -1512,7 +1516,7 @@ bool RobotTextConsole::log(In& stream)
         sprintf(buf, "%u\t%.2f%%", frequencies[id], static_cast<float>(sizes[id]) * 100.f / size);
         ctrl->list(std::string(buf) + "\t" + TypeRegistry::getEnumName(id), option, true);
       }
-    sprintf(buf, "%u", logPlayer.getNumberOfMessages());
+    sprintf(buf, "%u", total);
     ctrl->printLn(std::string(buf) + "\ttotal");
     return true;
   }
@@ -3189,34 +3193,17 @@ void RobotTextConsole::sendModuleRequest()
 
 void RobotTextConsole::updateAnnotationsFromLog()
 {
-  struct Handler : public MessageHandler
-  {
-    std::unordered_map<std::string, ThreadData>& threadData;
-    unsigned currentFrame = 0;
-    std::string threadIdentifier;
-
-  public:
-    explicit Handler(std::unordered_map<std::string, ThreadData>& threadData)
-      : threadData(threadData) {}
-
-    bool handleMessage(InMessage& message)
-    {
-      switch(message.getMessageID())
-      {
-        case idFrameBegin:
-          threadIdentifier = message.readThreadIdentifier();
-          ++currentFrame;
-          return true;
-        case idAnnotation:
-          threadData[threadIdentifier].annotationInfo.addMessage(message, currentFrame);
-          return true;
-        default:
-          return false;
-      }
-    }
-  } handler(threadData);
-
   for(auto& data : threadData)
     data.second.annotationInfo.clear();
-  logPlayer.handleAllMessages(handler);
+
+  // Only frames with annotations are visited. Annotations count frames starting with 1.
+  std::string threadIdentifier;
+  logPlayer.forAllMessages([&](InMessage& message, int frame)
+  {
+    if(message.getMessageID() == idFrameBegin)
+      threadIdentifier = message.readThreadIdentifier();
+    else if(message.getMessageID() == idAnnotation)
+      threadData[threadIdentifier].annotationInfo.addMessage(message, frame + 1);
+    return true;
+  }, {idAnnotation});
 }
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "Controller/GameController.h"
 #include "Tools/Math/Eigen.h"
 #include <SimRobot.h>
 #include <vector>
@@ -28,7 +29,7 @@ struct Pose3f;
 /**
  * An interface to a simulated robot (and its ball).
  */
-class SimulatedRobot
+class SimulatedRobot : public GameController::Player
 {
 private:
   int robotNumber = -1; /**< The number of this robot */
@@ -57,12 +58,6 @@ public:
    */
   static void setBall(SimRobot::Object* ball);
 
-  /**
-   * Determines the pose of the simulated robot.
-   * @param robotPose The determined pose of the robot.
-   */
-  virtual void getRobotPose(Pose2f& robotPose) const = 0;
-
   /**
    * Determines all robot states as well as the ball state.
    * @param worldState The determined world state.
@@ -133,14 +128,6 @@ public:
    */
   virtual void getAndSetMotionData(const MotionRequest& motionRequest, MotionInfo& motionInfo) = 0;
 
-  /**
-   * Moves and rotates the robot to an absolute pose
-   * @param pos The position to move the robot to
-   * @param rot The target rotation (as euler angles; in radian)
-   * @param changeRotation Whether the rotation of the robot should be changed or not
-   */
-  virtual void moveRobot(const Vector3f& pos, const Vector3f& rot, bool changeRotation) = 0;
-
   /**
    * Enables or disables the physics simulation of the body
    * @param enable Whether to enable or disable the physics simulation
@@ -34,8 +34,7 @@ FieldRatingProvider::FieldRatingProvider()
   otherSideDrawing = false;
   facingDrawing = false;
   ballNearDrawing = false;
-  lastTeammateUpdate = 0;
-  lastObstacleOnFieldUpdate = 0;
+  lastObstaclesAndTeammatesUpdate = 0;
 
   updateParameters();
 }
@@ -100,6 +99,28 @@ void FieldRatingProvider::update(FieldRating& fieldRating)
       pv.value -= std::max(0.f, ballNear.value);
   };
 
+  fieldRating.potentialForPoints = [this](const std::vector<Vector2f>& points, std::vector<PotentialValue>& pvs, const bool calculateFieldDirection)
+  {
+    Terms terms;
+    terms.fieldBorder = terms.goal = terms.goalAngle = terms.obstacles = terms.teammates = true;
+    pvs.resize(points.size());
+    evaluatePotentials(points.data(), points.size(), pvs.data(), terms, calculateFieldDirection);
+  };
+
+  fieldRating.potentialForGrid = [this](const Vector2f& min, const Vector2f& max, const Vector2i& size, std::vector<PotentialValue>& pvs, const bool calculateFieldDirection)
+  {
+    ASSERT(size.x() > 0 && size.y() > 0);
+    const Vector2f step((max.x() - min.x()) / std::max(size.x() - 1, 1), (max.y() - min.y()) / std::max(size.y() - 1, 1));
+    gridPoints.clear();
+    for(int y = 0; y < size.y(); ++y)
+      for(int x = 0; x < size.x(); ++x)
+        gridPoints.emplace_back(min.x() + step.x() * x, min.y() + step.y() * y);
+    Terms terms;
+    terms.fieldBorder = terms.goal = terms.goalAngle = terms.obstacles = terms.teammates = true;
+    pvs.resize(gridPoints.size());
+    evaluatePotentials(gridPoints.data(), gridPoints.size(), pvs.data(), terms, calculateFieldDirection);
+  };
+
   DECLARE_DEBUG_DRAWING("module:FieldRatingProvider:potentialField", "drawingOnField");
 
   MODIFY("module:FieldRatingProvider:drawing:field", fieldBorderDrawing);
@@ -149,6 +170,7 @@ void FieldRatingProvider::draw()
   const float xShift = (2.f * theFieldDimensions.xPosOpponentGroundLine) / drawGrid.x();
   const float yShift = (2.f * theFieldDimensions.yPosLeftSideline) / drawGrid.y();
 
+  gridPoints.clear();
   for(float y = drawMinY;
       y <= drawMaxY;
       y = y + yShift > drawMaxY && y < drawMaxY
@@ -160,63 +182,146 @@ void FieldRatingProvider::draw()
         x = x + xShift > drawMaxX && x < drawMaxX
             ? drawMaxX
             : x + xShift)
+      gridPoints.emplace_back(x, y);
+  }
+
+  Terms terms;
+  terms.fieldBorder = fieldBorderDrawing;
+  terms.goal = goalDrawing;
+  terms.goalAngle = goalAngleDrawing;
+  terms.obstacles = opponentDrawing;
+  terms.robotFacing = facingDrawing;
+  terms.ballNear = ballNearDrawing;
+  terms.teammates = teammateDrawing;
+  terms.otherSide = otherSideDrawing;
+  std::vector<PotentialValue> pvs(gridPoints.size());
+  evaluatePotentials(gridPoints.data(), gridPoints.size(), pvs.data(), terms, calculateFieldDirection);
+
+  for(size_t i = 0; i < gridPoints.size(); ++i)
+  {
+    const float x = gridPoints[i].x();
+    const float y = gridPoints[i].y();
+    PotentialValue& pv = pvs[i];
+    pv.value = Rangef(-1.5f, 1.f).limit(pv.value);
+    ColorRGBA color(0, 0, 0, 0);
+    if(pv.value >= 0.f)
     {
-      PotentialValue pv;
-      PotentialValue pvBallNear;
-      if(fieldBorderDrawing)
-        pv += getFieldBorderPotential(x, y, calculateFieldDirection);
-      if(goalDrawing)
-        pv += getGoalPotential(x, y, calculateFieldDirection);
-      if(goalAngleDrawing)
-        pv += getGoalAnglePotential(x, y, calculateFieldDirection);
-      if(opponentDrawing)
-        pv += getObstaclePotential(x, y, calculateFieldDirection);
-      if(facingDrawing)
-        pv += getRobotFacingPotential(x, y, calculateFieldDirection);
-      if(ballNearDrawing)
-      {
-        pvBallNear = getBallNearPotential(x, y, calculateFieldDirection);
-        pv += pvBallNear;
-      }
-      if(teammateDrawing)
-      {
-        PotentialValue teammate = getTeammatesPotential(x, y, calculateFieldDirection);
-        if(teammate.value < 0.f)
-          teammate.value -= std::max(0.f, pvBallNear.value);
-        pv += teammate;
-      }
-      if(otherSideDrawing)
-        pv += getPotentialOtherSide(x, y, calculateFieldDirection);
-      pv.value = Rangef(-1.5f, 1.f).limit(pv.value);
-      ColorRGBA color(0, 0, 0, 0);
-      if(pv.value >= 0.f)
-      {
-        color.r = static_cast<unsigned char>(pv.value * 255);
-        color.b = 0;
-        color.g = static_cast<unsigned char>((1.f - pv.value) * 255);
-        color.a = 100;
-      }
-      else
-      {
-        color.r = 0;
-        color.b = static_cast<unsigned char>(pv.value * -0.5f * 255);
-        color.g = static_cast<unsigned char>((1.f - pv.value * -0.5f) * 255);
-        color.a = 100;
-      }
+      color.r = static_cast<unsigned char>(pv.value * 255);
+      color.b = 0;
+      color.g = static_cast<unsigned char>((1.f - pv.value) * 255);
+      color.a = 100;
+    }
+    else
+    {
+      color.r = 0;
+      color.b = static_cast<unsigned char>(pv.value * -0.5f * 255);
+      color.g = static_cast<unsigned char>((1.f - pv.value * -0.5f) * 255);
+      color.a = 100;
+    }
 
-      FILLED_RECTANGLE("module:FieldRatingProvider:potentialField",
-                       static_cast<int>(x - xShift / 2.f), static_cast<int>(y - yShift / 2.f),
-                       static_cast<int>(x + xShift / 2.f), static_cast<int>(y + yShift / 2.f),
-                       1, Drawings::noPen, ColorRGBA(), Drawings::solidBrush, color);
-      if(pv.value != 0)
-      {
-        pv.direction /= pv.direction.norm();
-        if(std::isnan(pv.value) || std::isnan(pv.direction.x()) || std::isnan(pv.direction.y()))
-          continue;
-        ARROW("module:FieldRatingProvider:potentialField", x, y, x + pv.direction.x() * 50.f, y + pv.direction.y() * 50.f, 5, Drawings::arrow, ColorRGBA::black);
-      }
+    FILLED_RECTANGLE("module:FieldRatingProvider:potentialField",
+                     static_cast<int>(x - xShift / 2.f), static_cast<int>(y - yShift / 2.f),
+                     static_cast<int>(x + xShift / 2.f), static_cast<int>(y + yShift / 2.f),
+                     1, Drawings::noPen, ColorRGBA(), Drawings::solidBrush, color);
+    if(pv.value != 0)
+    {
+      pv.direction /= pv.direction.norm();
+      if(std::isnan(pv.value) || std::isnan(pv.direction.x()) || std::isnan(pv.direction.y()))
+        continue;
+      ARROW("module:FieldRatingProvider:potentialField", x, y, x + pv.direction.x() * 50.f, y + pv.direction.y() * 50.f, 5, Drawings::arrow, ColorRGBA::black);
+    }
+  }
+}
+
+void FieldRatingProvider::updateObstaclesAndTeammates()
+{
+  if(lastObstaclesAndTeammatesUpdate == theFrameInfo.time)
+    return;
+  lastObstaclesAndTeammatesUpdate = theFrameInfo.time;
+
+  obstaclesOnField.clear();
+  for(const Obstacle& o : theObstacleModel.obstacles)
+  {
+    if(o.type == Obstacle::goalpost)
+      continue;
+    const Vector2f obCenter = theRobotPose * o.center;
+    if(std::abs(obCenter.x()) > theFieldDimensions.xPosOpponentGroundLine)
+      continue;
+    obstaclesOnField.push_back(obCenter);
+  }
+
+  playerPositions.clear();
+  playerPositions.push_back(theRobotPose.translation);
+  size_t numOfTeammates = 0;
+  const Vector2f goal(theFieldDimensions.xPosOpponentGroundLine, 0.f);
+  for(const Teammate& player : theTeamData.teammates)
+  {
+    if(player.status == Teammate::PENALIZED)
+      continue;
+    playerPositions.push_back(player.theRobotPose.translation);
+    if(player.theRobotPose.translation.x() < theFieldDimensions.xPosOwnGroundLine / 2.f)
+      continue;
+
+    // The entries are reused to keep the memory of their obstacle lists
+    if(teammates.size() <= numOfTeammates)
+      teammates.emplace_back();
+    TeammateInfo& teammate = teammates[numOfTeammates++];
+    teammate.position = player.theRobotPose.translation;
+    teammate.angleToGoal = (goal - player.theRobotPose.translation).angle();
+    teammate.offsetToGoal = player.theRobotPose.translation + Vector2f::polar(bestRelativePose, (goal - player.theRobotPose.translation).angle());
+    teammate.rangeInterpolation = std::min(1.f, std::max(0.f, (player.theRobotPose.translation - theRobotPose.translation).norm() - minTeammatePassDistance) / maxTeammatePassDistance);
+    teammate.obstaclesOnField.clear();
+    for(const Obstacle& ob : player.theObstacleModel.obstacles)
+      teammate.obstaclesOnField.push_back(player.theRobotPose * ob.center);
+  }
+  teammates.resize(numOfTeammates);
+}
+
+void FieldRatingProvider::evaluatePotentials(const Vector2f* points, const size_t count, PotentialValue* pvs, const Terms& terms, const bool calculateFieldDirection)
+{
+  // The terms are added in the same order as the per-point functions are combined, so the results are identical.
+  for(size_t i = 0; i < count; ++i)
+  {
+    pvs[i] = PotentialValue();
+    if(terms.fieldBorder)
+      pvs[i] += getFieldBorderPotential(points[i].x(), points[i].y(), calculateFieldDirection);
+    if(terms.goal)
+      pvs[i] += getGoalPotential(points[i].x(), points[i].y(), calculateFieldDirection);
+    if(terms.goalAngle)
+      pvs[i] += getGoalAnglePotential(points[i].x(), points[i].y(), calculateFieldDirection);
+  }
+  if(terms.obstacles)
+  {
+    obstacleTerm.resize(count);
+    getObstaclePotentials(points, count, obstacleTerm.data(), calculateFieldDirection);
+    for(size_t i = 0; i < count; ++i)
+      pvs[i] += obstacleTerm[i];
+  }
+  ballNearTerm.assign(count, PotentialValue());
+  for(size_t i = 0; i < count; ++i)
+  {
+    if(terms.robotFacing)
+      pvs[i] += getRobotFacingPotential(points[i].x(), points[i].y(), calculateFieldDirection);
+    if(terms.ballNear)
+    {
+      ballNearTerm[i] = getBallNearPotential(points[i].x(), points[i].y(), calculateFieldDirection);
+      pvs[i] += ballNearTerm[i];
+    }
+  }
+  if(terms.teammates)
+  {
+    teammateTerm.resize(count);
+    getTeammatesPotentials(points, count, teammateTerm.data(), calculateFieldDirection);
+    for(size_t i = 0; i < count; ++i)
+    {
+      if(teammateTerm[i].value < 0.f)
+        teammateTerm[i].value -= std::max(0.f, ballNearTerm[i].value);
+      pvs[i] += teammateTerm[i];
     }
   }
+  if(terms.otherSide)
+    for(size_t i = 0; i < count; ++i)
+      pvs[i] += getPotentialOtherSide(points[i].x(), points[i].y(), calculateFieldDirection);
 }
 
 PotentialValue FieldRatingProvider::getFieldBorderPotential(const float x, const float y, const bool calculateFieldDirection)
@@ -277,73 +382,68 @@ PotentialValue FieldRatingProvider::getFieldBorderPotential(const float x, const
 
 PotentialValue FieldRatingProvider::getObstaclePotential(const float x, const float y, const bool calculateFieldDirection)
 {
-  float obstacleRepelRating = 0.f;
-  Vector2f obstacleRepelDirection(0.f, 0.f);
   const Vector2f fieldPoint(x, y);
-  if(x >= theFieldDimensions.xPosOpponentGroundLine && y < theFieldDimensions.yPosLeftGoal && y > theFieldDimensions.yPosRightGoal) // the goal is always good
-    return PotentialValue();
+  PotentialValue pv;
+  getObstaclePotentials(&fieldPoint, 1, &pv, calculateFieldDirection);
+  return pv;
+}
 
-  if(lastObstacleOnFieldUpdate != theFrameInfo.time)
+void FieldRatingProvider::getObstaclePotentials(const Vector2f* points, const size_t count, PotentialValue* pvs, const bool calculateFieldDirection)
+{
+  updateObstaclesAndTeammates();
+  nearestPlayerSquaredDistance.resize(count);
+  repelRange.resize(count);
+  for(size_t i = 0; i < count; ++i)
   {
-    lastObstacleOnFieldUpdate = theFrameInfo.time;
-    obstaclesOnField.clear();
-    for(const Obstacle& o : theObstacleModel.obstacles)
-    {
-      if(o.type == Obstacle::goalpost)
-        continue;
-      const Vector2f obCenter = theRobotPose * o.center;
-      if(std::abs(obCenter.x()) > theFieldDimensions.xPosOpponentGroundLine)
-        continue;
-      obstaclesOnField.push_back(obCenter);
-    }
+    pvs[i] = PotentialValue();
+    nearestPlayerSquaredDistance[i] = (playerPositions[0] - points[i]).squaredNorm();
   }
+  for(size_t j = 1; j < playerPositions.size(); ++j)
+    for(size_t i = 0; i < count; ++i)
+      nearestPlayerSquaredDistance[i] = std::min(nearestPlayerSquaredDistance[i], (playerPositions[j] - points[i]).squaredNorm());
 
-  float squardedDistance = (theRobotPose.translation - fieldPoint).squaredNorm();
-  for(const Teammate& player : theTeamData.teammates)
+  const Vector2f goal(theFieldDimensions.xPosOpponentGroundLine, 0.f);
+  for(size_t i = 0; i < count; ++i)
   {
-    if(player.status == Teammate::PENALIZED)
-      continue;
-    const float newSquaredDistance = (player.theRobotPose.translation - fieldPoint).squaredNorm();
-    if(newSquaredDistance < squardedDistance)
-      squardedDistance = newSquaredDistance;
+    const float distanceToGoalFactor = std::min(1.f, (goal - points[i]).norm() / opponentDistanceToGoal);
+    // useMaxRepelRange describes the range between the min and the max value. the max radius is determined by the distance overlap of vectorToOb and squardedDistance.
+    // the radius around the obstacle, that contains the max value is determined by the distance overlap minus useMaxRepelRange
+    repelRange[i] = distanceToGoalFactor * minRepelDifferenceRange + (1.f - distanceToGoalFactor) * maxRepelDifferenceRange;
   }
 
-  const Vector2f fieldPointToGoal = Vector2f(theFieldDimensions.xPosOpponentGroundLine, 0.f) - fieldPoint;
-  const float distanceToGoalFactor = std::min(1.f, fieldPointToGoal.norm() / opponentDistanceToGoal);
-  // useMaxRepelRange describes the range between the min and the max value. the max radius is determined by the distance overlap of vectorToOb and squardedDistance.
-  // the radius around the obstacle, that contains the max value is determined by the distance overlap minus useMaxRepelRange
-  const float useMaxRepelRange = distanceToGoalFactor * minRepelDifferenceRange + (1.f - distanceToGoalFactor) * maxRepelDifferenceRange;
-  const float teammateDistance = std::sqrt(squardedDistance);
-  const float radiusTimesValue = 1.f / useMaxRepelRange * repelValue;
   for(const Vector2f& obCenter : obstaclesOnField)
   {
-    Vector2f vectorToOb = obCenter - fieldPoint;
-    if(vectorToOb == Vector2f(0.f, 0.f))
-      vectorToOb.x() += 0.00001f;
-    float vectorToObNorm = vectorToOb.squaredNorm();
-    if(vectorToObNorm > squardedDistance)
-      continue;
+    for(size_t i = 0; i < count; ++i)
+    {
+      const Vector2f& fieldPoint = points[i];
+      if(fieldPoint.x() >= theFieldDimensions.xPosOpponentGroundLine && fieldPoint.y() < theFieldDimensions.yPosLeftGoal && fieldPoint.y() > theFieldDimensions.yPosRightGoal) // the goal is always good
+        continue;
 
-    vectorToObNorm = std::sqrt(vectorToObNorm);
-    const float malusForOpponentTurn = std::min(1.f, std::max(0.f, std::abs(vectorToOb.angle()) - 60_deg) / 90_deg);
-    const float realRadius = (vectorToObNorm + teammateDistance) / 2.f * (1.f - malusForOpponentTurn * malusForOpponentTurnFactor);
-    const float relativeRadius = realRadius - useMaxRepelRange;
-    const float realDistance = std::max(0.f, vectorToObNorm - relativeRadius);
-    const float singleObstacleRating = functionLinear(realDistance, useMaxRepelRange, radiusTimesValue);
-    obstacleRepelRating += singleObstacleRating;
+      Vector2f vectorToOb = obCenter - fieldPoint;
+      if(vectorToOb == Vector2f(0.f, 0.f))
+        vectorToOb.x() += 0.00001f;
+      float vectorToObNorm = vectorToOb.squaredNorm();
+      if(vectorToObNorm > nearestPlayerSquaredDistance[i])
+        continue;
 
-    if(calculateFieldDirection)
-    {
-      const Vector2f singleObstacleDirection = obCenter != fieldPoint && singleObstacleRating != 0.f ? vectorToOb.normalized(-1.f) : Vector2f(0.f, 0.f);
-      obstacleRepelDirection += singleObstacleDirection * std::abs(singleObstacleRating);
+      const float useMaxRepelRange = repelRange[i];
+      const float teammateDistance = std::sqrt(nearestPlayerSquaredDistance[i]);
+      const float radiusTimesValue = 1.f / useMaxRepelRange * repelValue;
+      vectorToObNorm = std::sqrt(vectorToObNorm);
+      const float malusForOpponentTurn = std::min(1.f, std::max(0.f, std::abs(vectorToOb.angle()) - 60_deg) / 90_deg);
+      const float realRadius = (vectorToObNorm + teammateDistance) / 2.f * (1.f - malusForOpponentTurn * malusForOpponentTurnFactor);
+      const float relativeRadius = realRadius - useMaxRepelRange;
+      const float realDistance = std::max(0.f, vectorToObNorm - relativeRadius);
+      const float singleObstacleRating = functionLinear(realDistance, useMaxRepelRange, radiusTimesValue);
+      pvs[i].value += singleObstacleRating;
+
+      if(calculateFieldDirection)
+      {
+        const Vector2f singleObstacleDirection = obCenter != fieldPoint && singleObstacleRating != 0.f ? vectorToOb.normalized(-1.f) : Vector2f(0.f, 0.f);
+        pvs[i].direction += singleObstacleDirection * std::abs(singleObstacleRating);
+      }
     }
   }
-
-  PotentialValue pv;
-  pv.value = obstacleRepelRating;
-  if(calculateFieldDirection)
-    pv.direction = obstacleRepelDirection;
-  return pv;
 }
 
 PotentialValue FieldRatingProvider::getGoalPotential(const float x, const float y, const bool calculateFieldDirection)
@@ -393,70 +493,55 @@ PotentialValue FieldRatingProvider::getGoalAnglePotential(const float x, const f
 
 PotentialValue FieldRatingProvider::getTeammatesPotential(const float x, const float y, const bool calculateFieldDirection)
 {
-  // calculate some values only once per frame
-  if(lastTeammateUpdate != theFrameInfo.time)
-  {
-    lastTeammateUpdate = theFrameInfo.time;
-    teammateAngleToGoal.clear();
-    teammateOffsetToGoal.clear();
-    teammateRangeInterpolation.clear();
-    teammateObstacleOnField.clear();
-    const Vector2f goal(theFieldDimensions.xPosOpponentGroundLine, 0.f);
-    for(const Teammate& player : theTeamData.teammates)
-    {
-      teammateAngleToGoal.push_back((goal - player.theRobotPose.translation).angle());
-      teammateOffsetToGoal.push_back(player.theRobotPose.translation + Vector2f::polar(bestRelativePose, (goal - player.theRobotPose.translation).angle()));
-      teammateRangeInterpolation.push_back(std::min(1.f, std::max(0.f, (player.theRobotPose.translation - theRobotPose.translation).norm() - minTeammatePassDistance) / maxTeammatePassDistance));
-      std::vector<Vector2f> obstacles;
-      for(const Obstacle& ob : player.theObstacleModel.obstacles)
-        obstacles.push_back(player.theRobotPose * ob.center);
-      teammateObstacleOnField.push_back(obstacles);
-    }
-  }
-  PotentialValue pv;
-  if(x >= theFieldDimensions.xPosOpponentGroundLine && y < theFieldDimensions.yPosLeftGoal && y > theFieldDimensions.yPosRightGoal) // the goal is always good
-    return pv;
-  size_t index = -1;
   const Vector2f fieldPoint(x, y);
-  for(const Teammate& player : theTeamData.teammates)
-  {
-    index++;
-    ASSERT(index < teammateAngleToGoal.size());
-    if(player.status == Teammate::PENALIZED)
-      continue;
-    if(player.theRobotPose.translation.x() < theFieldDimensions.xPosOwnGroundLine / 2.f)
-      continue;
-    const Angle angleToBall = (fieldPoint - player.theRobotPose.translation).angle();
-    if(std::abs(angleToBall - teammateAngleToGoal[index]) > 90_deg) // to safe some computation time
-      continue;
+  PotentialValue pv;
+  getTeammatesPotentials(&fieldPoint, 1, &pv, calculateFieldDirection);
+  return pv;
+}
 
-    Vector2f poseVector = teammateOffsetToGoal[index] - fieldPoint;
-    if(poseVector == Vector2f(0.f, 0.f))
-      poseVector.x() += 0.000001f;
-    const float poseDistance = poseVector.norm();
-    float rating = -functionLinear(poseDistance, teammateAttractRange, teammateRTV);
-    if(rating < 0.f)
+void FieldRatingProvider::getTeammatesPotentials(const Vector2f* points, const size_t count, PotentialValue* pvs, const bool calculateFieldDirection)
+{
+  updateObstaclesAndTeammates();
+  for(size_t i = 0; i < count; ++i)
+    pvs[i] = PotentialValue();
+  for(const TeammateInfo& teammate : teammates)
+  {
+    for(size_t i = 0; i < count; ++i)
     {
-      if(x > 0.f)  // if pass robot is standing far away while in the opponent half, a pass would be really good
-        rating += teammateRangeInterpolation[index] * -0.5f;
-      for(const Vector2f& ob : teammateObstacleOnField[index])
+      const Vector2f& fieldPoint = points[i];
+      if(fieldPoint.x() >= theFieldDimensions.xPosOpponentGroundLine && fieldPoint.y() < theFieldDimensions.yPosLeftGoal && fieldPoint.y() > theFieldDimensions.yPosRightGoal) // the goal is always good
+        continue;
+      const Angle angleToBall = (fieldPoint - teammate.position).angle();
+      if(std::abs(angleToBall - teammate.angleToGoal) > 90_deg) // to safe some computation time
+        continue;
+
+      Vector2f poseVector = teammate.offsetToGoal - fieldPoint;
+      if(poseVector == Vector2f(0.f, 0.f))
+        poseVector.x() += 0.000001f;
+      const float poseDistance = poseVector.norm();
+      float rating = -functionLinear(poseDistance, teammateAttractRange, teammateRTV);
+      if(rating < 0.f)
       {
-        const float squaredDistance = (fieldPoint - ob).squaredNorm();
-        if(squaredDistance < sqr(1000.f))
+        if(fieldPoint.x() > 0.f)  // if pass robot is standing far away while in the opponent half, a pass would be really good
+          rating += teammate.rangeInterpolation * -0.5f;
+        for(const Vector2f& ob : teammate.obstaclesOnField)
         {
-          rating = 0.f;
-          break;
+          const float squaredDistance = (fieldPoint - ob).squaredNorm();
+          if(squaredDistance < sqr(1000.f))
+          {
+            rating = 0.f;
+            break;
+          }
         }
       }
-    }
-    pv.value += rating;
-    if(calculateFieldDirection)
-    {
-      const Vector2f direction = functionLinearDer(poseVector, poseDistance, 1.f);
-      pv.direction += direction * std::abs(rating);
+      pvs[i].value += rating;
+      if(calculateFieldDirection)
+      {
+        const Vector2f direction = functionLinearDer(poseVector, poseDistance, 1.f);
+        pvs[i].direction += direction * std::abs(rating);
+      }
     }
   }
-  return pv;
 }
 
 PotentialValue FieldRatingProvider::getPotentialOtherSide(const float x, const float y, const bool calculateFieldDirection)
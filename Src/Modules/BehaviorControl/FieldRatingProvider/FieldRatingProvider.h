@@ -120,15 +120,42 @@ private:
   float ballRTV;
   Rangef bestBallPositionRange;
   float lowPassFilterFactor;
-
-  std::vector<Angle> teammateAngleToGoal;
-  std::vector<Vector2f> teammateOffsetToGoal;
-  std::vector<float> teammateRangeInterpolation;
-  std::vector<float> teammateObstacleInfluenceRange;
-  std::vector<std::vector<Vector2f>> teammateObstacleOnField;
-  std::vector<Vector2f> obstaclesOnField;
-  unsigned int lastTeammateUpdate;
-  unsigned int lastObstacleOnFieldUpdate;
+  unsigned int lastObstaclesAndTeammatesUpdate; /**< The frame time when the obstacles and teammates were precomputed last. */
+
+  /** The precomputed information about a teammate that influences the potential field. */
+  struct TeammateInfo
+  {
+    Vector2f position;
+    Angle angleToGoal;
+    Vector2f offsetToGoal;
+    float rangeInterpolation;
+    std::vector<Vector2f> obstaclesOnField;
+  };
+
+  /** The terms that are combined by evaluatePotentials. */
+  struct Terms
+  {
+    bool fieldBorder = false;
+    bool goal = false;
+    bool goalAngle = false;
+    bool obstacles = false;
+    bool robotFacing = false;
+    bool ballNear = false;
+    bool teammates = false;
+    bool otherSide = false;
+  };
+
+  std::vector<TeammateInfo> teammates; // Teammates that are neither penalized nor far back in the own half, updated when first needed in a frame
+  std::vector<Vector2f> obstaclesOnField; // Updated when first needed in a frame
+  std::vector<Vector2f> playerPositions; // The own position followed by the positions of all teammates that are not penalized
+
+  // Buffers reused by the batch evaluation
+  std::vector<float> nearestPlayerSquaredDistance;
+  std::vector<float> repelRange;
+  std::vector<PotentialValue> obstacleTerm;
+  std::vector<PotentialValue> ballNearTerm;
+  std::vector<PotentialValue> teammateTerm;
+  std::vector<Vector2f> gridPoints;
 
   Vector2f robotRotation;
 
@@ -149,6 +176,28 @@ private:
 
   void updateParameters();
 
+  /** Precomputes the obstacle and teammate terms for the current frame if this was not done yet. */
+  void updateObstaclesAndTeammates();
+
+  /**
+   * Evaluates the sum of some potential terms for many points.
+   * @param points The points.
+   * @param count The number of points.
+   * @param pvs The sums for each point.
+   * @param terms The terms to add.
+   * @param calculateFieldDirection Calculate the directions as well?
+   */
+  void evaluatePotentials(const Vector2f* points, const size_t count, PotentialValue* pvs, const Terms& terms, const bool calculateFieldDirection);
+
+  /**
+   * Evaluates the obstacle term for many points. The obstacles are iterated in the outer loop, so the
+   * per-point work is a tight loop over arrays.
+   */
+  void getObstaclePotentials(const Vector2f* points, const size_t count, PotentialValue* pvs, const bool calculateFieldDirection);
+
+  /** Evaluates the teammate term for many points, iterating the teammates in the outer loop. */
+  void getTeammatesPotentials(const Vector2f* points, const size_t count, PotentialValue* pvs, const bool calculateFieldDirection);
+
   PotentialValue getFieldBorderPotential(const float x, const float y, const bool calculateFieldDirection);
 
   PotentialValue getObstaclePotential(const float x, const float y, const bool calculateFieldDirection);
@@ -69,6 +69,16 @@ PathPlannerProvider::PathPlannerProvider()
   borders.emplace_back(theFieldDimensions.xPosOwnGroundLine - fieldBorderLimit, 0.f, 0.f, 1.f);
   borders.emplace_back(0.f, theFieldDimensions.yPosLeftSideline + fieldBorderLimit, 1.f, 0.f);
   borders.emplace_back(0.f, theFieldDimensions.yPosRightSideline - fieldBorderLimit, -1.f, 0.f);
+
+  // Add sides of the goal nets
+  goalNetBarriers.emplace_back(theFieldDimensions.xPosOpponentGoalPost, theFieldDimensions.yPosLeftGoal,
+                               theFieldDimensions.xPosOpponentFieldBorder, theFieldDimensions.yPosLeftGoal);
+  goalNetBarriers.emplace_back(theFieldDimensions.xPosOpponentGoalPost, theFieldDimensions.yPosRightGoal,
+                               theFieldDimensions.xPosOpponentFieldBorder, theFieldDimensions.yPosRightGoal);
+  goalNetBarriers.emplace_back(theFieldDimensions.xPosOwnGoalPost, theFieldDimensions.yPosLeftGoal,
+                               theFieldDimensions.xPosOwnFieldBorder, theFieldDimensions.yPosLeftGoal);
+  goalNetBarriers.emplace_back(theFieldDimensions.xPosOwnGoalPost, theFieldDimensions.yPosRightGoal,
+                               theFieldDimensions.xPosOwnFieldBorder, theFieldDimensions.yPosRightGoal);
 }
 
 void PathPlannerProvider::update(PathPlanner& pathPlanner)
@@ -137,18 +147,8 @@ void PathPlannerProvider::update(PathPlanner& pathPlanner)
 
 void PathPlannerProvider::createBarriers(const Pose2f& target, bool excludeOwnPenaltyArea, bool excludeOpponentPenaltyArea)
 {
-  barriers.clear();
-  barriers.reserve(8);
-
-  // Add sides of the goal nets
-  barriers.emplace_back(theFieldDimensions.xPosOpponentGoalPost, theFieldDimensions.yPosLeftGoal,
-                        theFieldDimensions.xPosOpponentFieldBorder, theFieldDimensions.yPosLeftGoal);
-  barriers.emplace_back(theFieldDimensions.xPosOpponentGoalPost, theFieldDimensions.yPosRightGoal,
-                        theFieldDimensions.xPosOpponentFieldBorder, theFieldDimensions.yPosRightGoal);
-  barriers.emplace_back(theFieldDimensions.xPosOwnGoalPost, theFieldDimensions.yPosLeftGoal,
-                        theFieldDimensions.xPosOwnFieldBorder, theFieldDimensions.yPosLeftGoal);
-  barriers.emplace_back(theFieldDimensions.xPosOwnGoalPost, theFieldDimensions.yPosRightGoal,
-                        theFieldDimensions.xPosOwnFieldBorder, theFieldDimensions.yPosRightGoal);
+  barriers.reserve(goalNetBarriers.size() + 7);
+  barriers.assign(goalNetBarriers.begin(), goalNetBarriers.end());
 
   if(excludeOwnPenaltyArea)
   {
@@ -228,6 +228,7 @@ class PathPlannerProvider : public PathPlannerProviderBase
   std::vector<Node> nodes; /**< All nodes of the visibility graph, i.e. all obstacles, and starting point (1st entry) and target (2nd entry). */
   std::vector<Candidate> candidates; /**< All open edges during the A* search. */
   std::vector<Barrier> barriers; /**< Barrier lines that cannot be crossed during planning. */
+  std::vector<Barrier> goalNetBarriers; /**< The barriers at the sides of the goal nets. They do not change. */
   std::vector<Geometry::Line> borders; /**< The border of the field plus a tolerance. */
   Rotation lastDir = cw; /**< Last direction selected when walking around first obstacle. */
   unsigned timeWhenLastPlayedSound = 0; /**< Used to limit frequency of sound playback. */
@@ -20,6 +20,8 @@ void ThumbnailProvider::update(Thumbnail& thumbnail)
 
   if(downScales == 0)
     thumbnail.imageY = theECImage.grayscaled;
+  else if(downScales == theECImage.shrinkDownScales)
+    thumbnail.imageY = theECImage.shrunkGrayscaled;
   else
     Resize::shrinkY(downScales, theECImage.grayscaled, thumbnail.imageY);
 
@@ -25,8 +25,6 @@ void UKFRobotPoseHypothesis::init(const Pose2f& pose, const Pose2f& poseDeviatio
   cov(0, 0) = sqr(poseDeviation.translation.x());
   cov(1, 1) = sqr(poseDeviation.translation.y());
   cov(2, 2) = sqr(poseDeviation.rotation);
-  for(int i = 0; i < 7; ++i)
-    sigmaPoints[i] = Vector3f::Zero();
 }
 
 void UKFRobotPoseHypothesis::mirror()
@@ -34,28 +34,62 @@ WhistleRecognizer::WhistleRecognizer()
     ASSERT(stream.exists());
     signatures.emplace_back();
     stream >> signatures.back();
+    signatureSpectra.emplace_back(toSingle(signatures.back()));
   }
 
-  // Allocate memory for FFTW plans
-  samples = fftw_alloc_real(bufferSize * 2);
-  std::memset(samples, 0, sizeof(double) * bufferSize * 2);
-  spectrum = fftw_alloc_complex(bufferSize + 1);
-  correlation = fftw_alloc_real(bufferSize * 2);
-
-  // Create FFTW plans
-  SYNC;
-  fft = fftw_plan_dft_r2c_1d(bufferSize * 2, samples, spectrum, FFTW_MEASURE);
-  ifft = fftw_plan_dft_c2r_1d(bufferSize * 2, spectrum, correlation, FFTW_MEASURE);
+  // Plan the transforms for the channels the audio data are expected to have. If they turn out
+  // to be different, the plans are replaced in update, but only estimated to not delay the frame.
+  createPlans(theAudioData.channels, FFTW_MEASURE);
 }
 
 WhistleRecognizer::~WhistleRecognizer()
 {
-  SYNC;
-  fftw_destroy_plan(ifft);
-  fftw_destroy_plan(fft);
-  fftw_free(correlation);
-  fftw_free(spectrum);
-  fftw_free(samples);
+  destroyPlans();
+}
+
+void WhistleRecognizer::createPlans(size_t numOfChannels, unsigned flags)
+{
+  if(numOfChannels == channels)
+    return;
+
+  destroyPlans();
+  channels = numOfChannels;
+  const int size = static_cast<int>(bufferSize * 2);
+  samples = fftwf_alloc_real(bufferSize * 2 * channels);
+  spectra = fftwf_alloc_complex((bufferSize + 1) * channels);
+  products = fftwf_alloc_complex((bufferSize + 1) * channels);
+  correlations = fftwf_alloc_real(bufferSize * 2 * channels);
+
+  // All channels are transformed together. FFTW_MEASURE overwrites the arrays while planning.
+  {
+    SYNC;
+    fft = fftwf_plan_many_dft_r2c(1, &size, static_cast<int>(channels), samples, nullptr, 1, size,
+                                  spectra, nullptr, 1, size / 2 + 1, flags);
+    ifft = fftwf_plan_many_dft_c2r(1, &size, static_cast<int>(channels), products, nullptr, 1, size / 2 + 1,
+                                   correlations, nullptr, 1, size, flags);
+  }
+
+  // The second half of the samples of each channel always remains 0.
+  std::memset(samples, 0, sizeof(float) * bufferSize * 2 * channels);
+  loudEnough.assign(channels, false);
+  channelCorrelations.assign(channels, 0.f);
+}
+
+void WhistleRecognizer::destroyPlans()
+{
+  if(channels)
+  {
+    {
+      SYNC;
+      fftwf_destroy_plan(ifft);
+      fftwf_destroy_plan(fft);
+    }
+    fftwf_free(correlations);
+    fftwf_free(products);
+    fftwf_free(spectra);
+    fftwf_free(samples);
+    channels = 0;
+  }
 }
 
 void WhistleRecognizer::update(Whistle& theWhistle)
@@ -121,17 +155,30 @@ void WhistleRecognizer::update(Whistle& theWhistle)
   {
     if(buffers[firstBuffer].full())
     {
+      createPlans(buffers.size());
+      transform(0.f);
+    }
+    if(buffers[firstBuffer].full() && loudEnough[firstBuffer])
+    {
+      // Store conjugate spectrum as signature and self-correlate input.
       Signature signature;
-      signature.selfCorrelation = correlate(signature.spectrum, buffers[firstBuffer], true);
+      signature.spectrum.resize(bufferSize + 1);
+      const fftwf_complex* spectrum = spectra + (bufferSize + 1) * firstBuffer;
+      for(size_t i = 0; i < signature.spectrum.size(); ++i)
+        signature.spectrum[i] = Vector2d(spectrum[i][0], -spectrum[i][1]);
+      const std::vector<std::complex<float>> signatureSpectrum = toSingle(signature);
+      signature.selfCorrelation = correlate(signatureSpectrum)[firstBuffer];
       if(signature.selfCorrelation > 0)
       {
         signature.name = selectedName;
         if(selectedIter == signatures.end())
         {
           signatures.emplace_back();
+          signatureSpectra.emplace_back();
           selectedIter = signatures.end() - 1;
         }
         *selectedIter = signature;
+        signatureSpectra[selectedIter - signatures.begin()] = signatureSpectrum;
         OutBinaryFile stream("Whistles/" + selectedName + ".dat");
         if(stream.exists())
         {
@@ -175,22 +222,22 @@ void WhistleRecognizer::update(Whistle& theWhistle)
 
     const Signature* bestSignature = nullptr;
 
+    // The spectra of all channels are computed once and then correlated with all signatures.
+    createPlans(buffers.size());
+    transform(minVolume);
+
     for(auto& signature : signatures)
       if(selectedIter == signatures.end() || &signature == &*selectedIter)
       {
         size_t defects = 0;
         float correlation = 0.f;
-        float bestChannelCorrelation = 0.f;
+        const std::vector<float>& correlationPerChannel = correlate(signatureSpectra[&signature - signatures.data()]);
 
         for(size_t i = 0; i < buffers.size(); ++i)
           if(theDamageConfigurationHead.audioChannelsDefect[i] || !buffers[i].full())
             ++defects;
           else
-          {
-            const float channelCorrelation = correlate(signature.spectrum, buffers[i]);
-            bestChannelCorrelation = std::max(bestChannelCorrelation, channelCorrelation);
-            correlation += channelCorrelation;
-          }
+            correlation += correlationPerChannel[i];
 
         if(defects < buffers.size())
         {
@@ -242,89 +289,119 @@ void WhistleRecognizer::update(Whistle& theWhistle)
   SEND_DEBUG_IMAGE("module:WhistleRecognizer:spectra", canvas, PixelTypes::Edge2);
 }
 
-float WhistleRecognizer::correlate(std::vector<Vector2d>& signature, const RingBuffer<AudioData::Sample>& buffer,
-                                      bool record)
+void WhistleRecognizer::transform(float requiredVolume)
 {
-  // Compute volume of samples.
-  float volume = 0;
-  for(AudioData::Sample sample : buffer)
-    volume = std::max(volume, std::abs(static_cast<float>(sample)));
-
-  // Abort if not loud enough.
-  if(volume == 0 || (!record && volume < (std::is_same<AudioData::Sample, short>::value ? std::numeric_limits<short>::max() : 1) * minVolume))
-    return 0.f;
-
-  // Copy samples to FFTW input and normalize them.
-  const double factor = 1.0 / volume;
-  for(size_t i = 0; i < buffer.size(); ++i)
-    samples[i] = buffer[i] * factor;
+  const float maxVolume = std::is_same<AudioData::Sample, short>::value ? std::numeric_limits<short>::max() : 1.f;
+  for(size_t channel = 0; channel < channels; ++channel)
+  {
+    const RingBuffer<AudioData::Sample>& buffer = buffers[channel];
+    loudEnough[channel] = false;
+    if(theDamageConfigurationHead.audioChannelsDefect[channel] || !buffer.full())
+      continue;
+
+    // Compute volume of samples.
+    float volume = 0;
+    for(AudioData::Sample sample : buffer)
+      volume = std::max(volume, std::abs(static_cast<float>(sample)));
+
+    // Skip channel if not loud enough.
+    if(volume == 0 || volume < maxVolume * requiredVolume)
+      continue;
+
+    // Copy samples to FFTW input and normalize them.
+    loudEnough[channel] = true;
+    const float factor = 1.f / volume;
+    float* channelSamples = samples + bufferSize * 2 * channel;
+    for(size_t i = 0; i < buffer.size(); ++i)
+      channelSamples[i] = buffer[i] * factor;
+  }
 
-  // samples -> spectrum
-  fftw_execute(fft);
+  // samples -> spectra
+  if(std::find(loudEnough.begin(), loudEnough.end(), true) != loudEnough.end())
+    fftwf_execute(fft);
 
   COMPLEX_IMAGE("module:WhistleRecognizer:spectra")
   {
-    for(unsigned x = 0; x < signature.size(); ++x)
-    {
-      const Vector2d complex(spectrum[x][0], spectrum[x][1]);
-      const unsigned amplitude = std::min(static_cast<unsigned>(complex.norm()), canvas.height);
-      if(amplitude > 0)
+    for(size_t channel = 0; channel < channels; ++channel)
+      if(loudEnough[channel])
       {
-        const PixelTypes::Edge2Pixel pixel(static_cast<char>(128 + 127 * complex.x() / amplitude),
-                                           static_cast<char>(128 + 127 * complex.y() / amplitude));
-        for(size_t y = 0; y < amplitude; ++y)
-          canvas[canvas.height - 1 - y][x] = pixel;
+        const fftwf_complex* spectrum = spectra + (bufferSize + 1) * channel;
+        for(unsigned x = 0; x <= bufferSize; ++x)
+        {
+          const Vector2f complex(spectrum[x][0], spectrum[x][1]);
+          const unsigned amplitude = std::min(static_cast<unsigned>(complex.norm()), canvas.height);
+          if(amplitude > 0)
+          {
+            const PixelTypes::Edge2Pixel pixel(static_cast<char>(128 + 127 * complex.x() / amplitude),
+                                               static_cast<char>(128 + 127 * complex.y() / amplitude));
+            for(size_t y = 0; y < amplitude; ++y)
+              canvas[canvas.height - 1 - y][x] = pixel;
+          }
+        }
       }
-    }
   }
+}
 
-  if(record)
-  {
-    // Store conjugate spectrum as signature and self-correlate input.
-    signature.resize(bufferSize + 1);
-    for(size_t i = 0; i < signature.size(); ++i)
-    {
-      signature[i] = Vector2d(spectrum[i][0], -spectrum[i][1]);
-      spectrum[i][0] = sqr(spectrum[i][0]) + sqr(spectrum[i][1]);
-      spectrum[i][1] = 0;
-    }
-  }
-  else
+const std::vector<float>& WhistleRecognizer::correlate(const std::vector<std::complex<float>>& signature)
+{
+  ASSERT(signature.size() == bufferSize + 1);
+  std::fill(channelCorrelations.begin(), channelCorrelations.end(), 0.f);
+  if(std::find(loudEnough.begin(), loudEnough.end(), true) == loudEnough.end())
+    return channelCorrelations;
+
+  // Multiply input spectra with signature spectrum.
+  for(size_t channel = 0; channel < channels; ++channel)
   {
-    // Multiply input spectrum with signature spectrum.
-    ASSERT(signature.size() == bufferSize + 1);
-    for(size_t i = 0; i < signature.size(); ++i)
-    {
-      const double spectrumi0 = spectrum[i][0];
-      spectrum[i][0] = spectrumi0 * signature[i][0] - spectrum[i][1] * signature[i][1];
-      spectrum[i][1] = spectrum[i][1] * signature[i][0] + spectrumi0 * signature[i][1];
-    }
+    const std::complex<float>* spectrum = reinterpret_cast<const std::complex<float>*>(spectra + (bufferSize + 1) * channel);
+    std::complex<float>* product = reinterpret_cast<std::complex<float>*>(products + (bufferSize + 1) * channel);
+    if(loudEnough[channel])
+      for(size_t i = 0; i < signature.size(); ++i)
+        product[i] = spectrum[i] * signature[i];
+    else
+      std::fill(product, product + signature.size(), std::complex<float>());
   }
 
   COMPLEX_IMAGE("module:WhistleRecognizer:spectra")
   {
-    for(unsigned x = 0; x < signature.size(); ++x)
-    {
-      const Vector2d complex(spectrum[x][0], spectrum[x][1]);
-      const unsigned amplitude = std::min(static_cast<unsigned>(std::sqrt(complex.norm())), canvas.height);
-      if(amplitude > 0)
+    for(size_t channel = 0; channel < channels; ++channel)
+      if(loudEnough[channel])
       {
-        const PixelTypes::Edge2Pixel pixel(static_cast<char>(128 + 127 * complex.x() / amplitude),
-                                           static_cast<char>(128 + 127 * complex.y() / amplitude));
-        for(size_t y = 0; y < amplitude; ++y)
-          canvas[(canvas.height - amplitude) / 2 + y][x] = pixel;
+        const fftwf_complex* product = products + (bufferSize + 1) * channel;
+        for(unsigned x = 0; x < signature.size(); ++x)
+        {
+          const Vector2f complex(product[x][0], product[x][1]);
+          const unsigned amplitude = std::min(static_cast<unsigned>(std::sqrt(complex.norm())), canvas.height);
+          if(amplitude > 0)
+          {
+            const PixelTypes::Edge2Pixel pixel(static_cast<char>(128 + 127 * complex.x() / amplitude),
+                                               static_cast<char>(128 + 127 * complex.y() / amplitude));
+            for(size_t y = 0; y < amplitude; ++y)
+              canvas[(canvas.height - amplitude) / 2 + y][x] = pixel;
+          }
+        }
       }
-    }
   }
 
-  // spectrum -> correlation
-  fftw_execute(ifft);
+  // spectra -> correlations
+  fftwf_execute(ifft);
 
-  // Find best correlation.
-  double bestCorrelation = 0;
-  for(size_t i = 0; i < bufferSize * 2; ++i)
-    if(std::abs(correlation[i]) > bestCorrelation)
-      bestCorrelation = std::abs(correlation[i]);
+  // Find best correlation of each channel.
+  for(size_t channel = 0; channel < channels; ++channel)
+    if(loudEnough[channel])
+    {
+      const float* correlation = correlations + bufferSize * 2 * channel;
+      float bestCorrelation = 0;
+      for(size_t i = 0; i < bufferSize * 2; ++i)
+        bestCorrelation = std::max(bestCorrelation, std::abs(correlation[i]));
+      channelCorrelations[channel] = std::sqrt(bestCorrelation) / bufferSize / 2;
+    }
+  return channelCorrelations;
+}
 
-  return static_cast<float>(std::sqrt(bestCorrelation) / bufferSize / 2);
+std::vector<std::complex<float>> WhistleRecognizer::toSingle(const Signature& signature)
+{
+  std::vector<std::complex<float>> spectrum(signature.spectrum.size());
+  for(size_t i = 0; i < spectrum.size(); ++i)
+    spectrum[i] = std::complex<float>(static_cast<float>(signature.spectrum[i].x()), static_cast<float>(signature.spectrum[i].y()));
+  return spectrum;
 }
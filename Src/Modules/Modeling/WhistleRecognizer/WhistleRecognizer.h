@@ -22,6 +22,7 @@
 #include "Tools/Module/Module.h"
 #include "Tools/RingBuffer.h"
 #include "Tools/Streams/Eigen.h"
+#include <complex>
 #include <fftw3.h>
 
 MODULE(WhistleRecognizer,
@@ -58,16 +59,21 @@ class WhistleRecognizer : public WhistleRecognizerBase
   });
 
   std::vector<Signature> signatures; /**< All whistle signatures. */
+  std::vector<std::vector<std::complex<float>>> signatureSpectra; /**< The spectra of all signatures in single precision. */
   std::vector<RingBuffer<AudioData::Sample>> buffers; /**< Sample buffers for all channels. */
   bool soundWasPlaying = false; /**< Was sound played back recently? */
   bool hasRecorded = false; /**< Was audio recorded in the previous cycle? */
   int samplesRequired = 0; /** The number of new samples required. */
   size_t sampleIndex = 0; /** Index of next sample to process for subsampling. */
-  double* samples; /**< The samples after normalization. */
-  fftw_complex* spectrum; /**< The spectrum of the samples. */
-  double* correlation; /**< The correlation with the signature. */
-  fftw_plan fft; /**< The plan to compute the FFT. */
-  fftw_plan ifft; /**< The plan to compute the inverse FFT. */
+  size_t channels = 0; /**< The number of channels the FFTW plans were created for. */
+  float* samples = nullptr; /**< The normalized samples of all channels, each padded with zeros to twice the buffer size. */
+  fftwf_complex* spectra = nullptr; /**< The spectra of the samples of all channels. */
+  fftwf_complex* products = nullptr; /**< The spectra of all channels multiplied with a signature spectrum. */
+  float* correlations = nullptr; /**< The correlations of all channels with a signature. */
+  fftwf_plan fft = nullptr; /**< The plan to compute the FFTs of all channels. */
+  fftwf_plan ifft = nullptr; /**< The plan to compute the inverse FFTs of all channels. */
+  std::vector<bool> loudEnough; /**< Were the samples of each channel loud enough to be correlated? */
+  std::vector<float> channelCorrelations; /**< The correlations of all channels with the current signature. */
   float bestCorrelation = 1.f; /**< The best correlation since the last network packet was sent twice. */
   bool bestUpdated = false; /**< Was the best correlation updated since the last network packet was sent? */
   Image<PixelTypes::Edge2Pixel> canvas; /**< Canvas for drawing spectra. */
@@ -79,14 +85,36 @@ class WhistleRecognizer : public WhistleRecognizerBase
   void update(Whistle& theWhistle) override;
 
   /**
-   * Correlate the samples recorded with a signature spectrum.
-   * @param signature The spectrum of a recorded whistle.
-   * @param buffer The samples recorded.
-   * @param record Record into the parameter "signature" instead of correlating with it.
-   * @return The correlation between signature and buffer. 0 if the volume was too low.
+   * Creates the FFTW plans for a number of channels if they do not exist yet.
+   * @param numOfChannels The number of channels that are transformed together.
+   * @param flags The planner flags. FFTW_MEASURE takes milliseconds, so it is only used in the constructor.
    */
-  float correlate(std::vector<Vector2d>& signature, const RingBuffer<AudioData::Sample>& buffer,
-                  bool record = false);
+  void createPlans(size_t numOfChannels, unsigned flags = FFTW_ESTIMATE);
+
+  /** Frees the FFTW plans and their memory. */
+  void destroyPlans();
+
+  /**
+   * Normalizes the samples of all channels that are not defect and computes their spectra.
+   * Channels that are not loud enough are marked in loudEnough.
+   * @param requiredVolume The minimum volume a channel must reach [0..1).
+   */
+  void transform(float requiredVolume);
+
+  /**
+   * Correlate the spectra of all channels with a signature spectrum. The
+   * spectra must have been computed by transform().
+   * @param signature The conjugate spectrum of a recorded whistle.
+   * @return The correlations between the signature and each channel. 0 for channels that were not loud enough.
+   */
+  const std::vector<float>& correlate(const std::vector<std::complex<float>>& signature);
+
+  /**
+   * Converts the spectrum of a signature to single precision.
+   * @param signature The signature.
+   * @return The spectrum in single precision.
+   */
+  static std::vector<std::complex<float>> toSingle(const Signature& signature);
 
 public:
   WhistleRecognizer();
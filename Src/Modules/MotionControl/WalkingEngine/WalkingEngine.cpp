@@ -13,6 +13,7 @@
  */
 
 #include "WalkingEngine.h"
+#include "Platform/File.h"
 #include "Platform/SystemCall.h"
 #include "Representations/MotionControl/MotionInfo.h"
 #include "Representations/MotionControl/MotionRequest.h"
@@ -23,19 +24,25 @@
 #include "Tools/Motion/InverseKinematic.h"
 #include "Tools/Motion/MotionUtilities.h"
 #include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/OutStreams.h"
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <random>
 
 MAKE_MODULE(WalkingEngine, motionControl);
 
+static const char translationPolygonMagic[4] = {'W', 'E', 'T', 'P'}; /**< The beginning of the cache file of the translation polygon. */
+
 WalkingEngine::WalkingEngine()
 {
   InMapFile stream("walkingEngineCommon.cfg");
   if(stream.exists())
     stream >> static_cast<WalkingEngineCommon&>(*this);
 
-  const DummyPhase dummy(MotionPhase::playDead);
-  WalkPhase phase(*this, Pose2f(), dummy);
-  translationPolygon = phase.getTranslationPolygon();
+  initTranslationPolygon();
 
   // Set the masses of all leg joints to 0
   lightMassCalibration = theMassCalibration;
@@ -49,6 +56,115 @@ void WalkingEngine::reg()
   REG_CLASS_WITH_BASE(WalkingEngine, WalkingEngineCommon);
 }
 
+void WalkingEngine::initTranslationPolygon()
+{
+  // The polygon only depends on the parameters and the robot dimensions. As determining it
+  // requires many inverse kinematics, it is shared between all instances of this module,
+  // e.g. of all simulated robots or when the module is switched on again. It is also stored
+  // in a cache file, so later starts of the code with the same parameters only have to read it.
+  OutBinaryMemory parameters;
+  parameters << static_cast<const Parameters&>(*this) << static_cast<const WalkingEngineCommon&>(*this) << theRobotDimensions;
+  const std::string key(parameters.data(), parameters.size());
+
+  static std::mutex mutex;
+  static std::string cachedKey;
+  static std::vector<Vector2f> cachedPolygon;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(key != cachedKey)
+    {
+      std::vector<Vector2f> polygon;
+      if(loadTranslationPolygon(key, polygon))
+      {
+        cachedKey = key;
+        cachedPolygon = std::move(polygon);
+      }
+    }
+    if(key == cachedKey)
+    {
+      translationPolygon = cachedPolygon;
+      return;
+    }
+  }
+
+  // The search does not block other instances that look up their polygons meanwhile.
+  const DummyPhase dummy(MotionPhase::playDead);
+  WalkPhase phase(*this, Pose2f(), dummy);
+  translationPolygon = phase.getTranslationPolygon();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  cachedKey = key;
+  cachedPolygon = translationPolygon;
+  saveTranslationPolygon(key, translationPolygon);
+}
+
+std::string WalkingEngine::getTranslationPolygonFileName()
+{
+  return std::string(File::getBHDir()) + "/Config/Cache/translationPolygon.dat";
+}
+
+bool WalkingEngine::loadTranslationPolygon(const std::string& key, std::vector<Vector2f>& polygon)
+{
+  File file(getTranslationPolygonFileName(), "rb", false);
+  if(!file.exists())
+    return false;
+  std::vector<char> buffer(file.getSize());
+  if(!buffer.empty())
+    file.read(buffer.data(), buffer.size());
+
+  const char* p = buffer.data();
+  const char* const end = p + buffer.size();
+  auto read = [&p, end](void* data, size_t size)
+  {
+    if(static_cast<size_t>(end - p) < size)
+      return false;
+    std::memcpy(data, p, size);
+    p += size;
+    return true;
+  };
+  char magic[sizeof(translationPolygonMagic)];
+  unsigned keySize;
+  unsigned numOfPoints;
+  if(!read(magic, sizeof(magic)) || std::memcmp(magic, translationPolygonMagic, sizeof(magic))
+     || !read(&keySize, sizeof(keySize)) || keySize != key.size() || static_cast<size_t>(end - p) < keySize
+     || std::memcmp(p, key.data(), keySize))
+    return false;
+  p += keySize;
+  if(!read(&numOfPoints, sizeof(numOfPoints)) || static_cast<size_t>(end - p) != numOfPoints * sizeof(Vector2f))
+    return false;
+  polygon.resize(numOfPoints);
+  read(polygon.data(), numOfPoints * sizeof(Vector2f));
+  return true;
+}
+
+void WalkingEngine::saveTranslationPolygon(const std::string& key, const std::vector<Vector2f>& polygon)
+{
+  // The file is written under a temporary name that is unique per writer and then renamed,
+  // so other processes never read it half-written.
+  const std::string fileName = getTranslationPolygonFileName();
+  const std::string tmpName = fileName + "." + std::to_string(std::random_device()()) + ".tmp";
+  std::error_code error;
+  std::filesystem::create_directories(std::filesystem::path(fileName).parent_path(), error);
+  {
+    File file(tmpName, "wb", false);
+    if(!file.exists())
+      return;
+    const unsigned keySize = static_cast<unsigned>(key.size());
+    const unsigned numOfPoints = static_cast<unsigned>(polygon.size());
+    file.write(translationPolygonMagic, sizeof(translationPolygonMagic));
+    file.write(&keySize, sizeof(keySize));
+    file.write(key.data(), keySize);
+    file.write(&numOfPoints, sizeof(numOfPoints));
+    file.write(polygon.data(), numOfPoints * sizeof(Vector2f));
+  }
+  if(std::rename(tmpName.c_str(), fileName.c_str())) // Windows does not replace existing files
+  {
+    std::remove(fileName.c_str());
+    if(std::rename(tmpName.c_str(), fileName.c_str()))
+      std::remove(tmpName.c_str());
+  }
+}
+
 std::vector<Vector2f> WalkPhase::getTranslationPolygon()
 {
   // Get max possible requests
@@ -41,6 +41,7 @@
 #include "Tools/Module/Module.h"
 #include "Tools/Motion/WalkKickStep.h"
 #include "WalkStepAdjustment.h"
+#include <string>
 
 STREAMABLE(WalkingEngineCommon,
 {,
@@ -230,6 +231,34 @@ public:
    */
   void calcFeetPoses(const float forwardL, const float forwardR, const float sideL, const float sideR, const float footHL, const float footHR, const Angle turn, Pose3f& leftFoot, Pose3f& rightFoot);
 
+  /**
+   * Determines the polygon of the maximum reachable step sizes or reuses it if
+   * it was already determined for the same parameters and robot dimensions,
+   * either by this process or by an earlier one (see loadTranslationPolygon).
+   */
+  void initTranslationPolygon();
+
+  /** Returns the path of the cache file of the translation polygon. */
+  static std::string getTranslationPolygonFileName();
+
+  /**
+   * Reads the translation polygon from the cache file.
+   * The file contains the magic "WETP", the size of the serialized parameters and robot
+   * dimensions the polygon was determined for, these bytes, the number of points and the points.
+   * @param key The serialized parameters and robot dimensions the polygon is needed for.
+   * @param polygon The polygon is returned here.
+   * @return Did the file exist and contain the polygon for the key?
+   */
+  static bool loadTranslationPolygon(const std::string& key, std::vector<Vector2f>& polygon);
+
+  /**
+   * Replaces the cache file by the translation polygon for the given key.
+   * Polygons for other parameters are not kept.
+   * @param key The serialized parameters and robot dimensions the polygon was determined for.
+   * @param polygon The polygon.
+   */
+  static void saveTranslationPolygon(const std::string& key, const std::vector<Vector2f>& polygon);
+
   Angle filteredGyroX, /**< low-pass filtered gyro values. */
         filteredGyroY,
         lastFilteredGyroY;
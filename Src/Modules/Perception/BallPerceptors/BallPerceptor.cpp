@@ -43,12 +43,15 @@ void BallPerceptor::update(BallPercept& theBallPercept)
   if(ballSpots.empty())
     return;
 
-  float prob, bestProb = guessedThreshold;
-  Vector2f ballPosition, bestBallPosition;
-  float radius, bestRadius;
+  // Only the encoding of the best spot is kept (directly in the input of the corrector),
+  // so the corrector is run at most once per frame.
+  float bestProb = guessedThreshold;
+  Vector2i bestBallSpot;
+  int bestBallArea = 0;
   for(std::size_t i = 0; i < ballSpots.size(); ++i)
   {
-    prob = apply(ballSpots[i], ballPosition, radius);
+    int ballArea;
+    const float prob = classify(ballSpots[i], ballArea);
 
     COMPLEX_DRAWING("module:BallPerceptor:spots")
     {
@@ -60,8 +63,9 @@ void BallPerceptor::update(BallPercept& theBallPercept)
     if(prob > bestProb)
     {
       bestProb = prob;
-      bestBallPosition = ballPosition;
-      bestRadius = radius;
+      bestBallSpot = ballSpots[i];
+      bestBallArea = ballArea;
+      corrector.input(0) = encoder.output(0);
       if(SystemCall::getMode() == SystemCall::physicalRobot && prob >= ensureThreshold)
         break;
     }
@@ -69,6 +73,9 @@ void BallPerceptor::update(BallPercept& theBallPercept)
 
   if(bestProb > guessedThreshold)
   {
+    Vector2f bestBallPosition;
+    float bestRadius;
+    correct(bestBallSpot, bestBallArea, bestBallPosition, bestRadius);
     theBallPercept.positionInImage = bestBallPosition;
     theBallPercept.radiusInImage = bestRadius;
     if(Transformation::imageToRobotHorizontalPlane(theImageCoordinateSystem.toCorrected(bestBallPosition), theBallSpecification.radius, theCameraMatrix, theCameraInfo, theBallPercept.positionOnField))
@@ -106,7 +113,7 @@ void BallPerceptor::update(BallPercept& theBallPercept)
   }
 }
 
-float BallPerceptor::apply(const Vector2i& ballSpot, Vector2f& ballPosition, float& predRadius)
+float BallPerceptor::classify(const Vector2i& ballSpot, int& ballArea)
 {
   Vector2f relativePoint;
   Geometry::Circle ball;
@@ -114,7 +121,7 @@ float BallPerceptor::apply(const Vector2i& ballSpot, Vector2f& ballPosition, flo
        && Projection::calculateBallInImage(relativePoint, theCameraMatrix, theCameraInfo, theBallSpecification.radius, ball)))
     return -1.f;
 
-  int ballArea = static_cast<int>(ball.radius * ballAreaFactor);
+  ballArea = static_cast<int>(ball.radius * ballAreaFactor);
   ballArea += 4 - (ballArea % 4);
 
   RECTANGLE("module:BallPerceptor:spots", static_cast<int>(ballSpot.x() - ballArea / 2), static_cast<int>(ballSpot.y() - ballArea / 2), static_cast<int>(ballSpot.x() + ballArea / 2), static_cast<int>(ballSpot.y() + ballArea / 2), 2, Drawings::PenStyle::solidPen, ColorRGBA::black);
@@ -132,7 +139,6 @@ float BallPerceptor::apply(const Vector2i& ballSpot, Vector2f& ballPosition, flo
       if(useContrastNormalization)
         PatchUtilities::normalizeContrast(reinterpret_cast<unsigned char*>(encoder.input(0).data()), Vector2i(patchSize, patchSize), contrastNormalizationPercent);
     }
-  const float stepSize = static_cast<float>(ballArea) / static_cast<float>(patchSize);
 
   // encode patch
   encoder.apply();
@@ -140,19 +146,16 @@ float BallPerceptor::apply(const Vector2i& ballSpot, Vector2f& ballPosition, flo
   // classify
   classifier.input(0) = encoder.output(0);
   classifier.apply();
-  const float pred = classifier.output(0)[0];
-
-  // predict ball position if poss for ball is high enough
-  if(pred > guessedThreshold)
-  {
-    corrector.input(0) = encoder.output(0);
-    corrector.apply();
-    ballPosition.x() = (corrector.output(0)[0] - patchSize / 2) * stepSize + ballSpot.x();
-    ballPosition.y() = (corrector.output(0)[1] - patchSize / 2) * stepSize + ballSpot.y();
-    predRadius = corrector.output(0)[2] * stepSize;
-  }
+  return classifier.output(0)[0];
+}
 
-  return pred;
+void BallPerceptor::correct(const Vector2i& ballSpot, int ballArea, Vector2f& ballPosition, float& predRadius)
+{
+  const float stepSize = static_cast<float>(ballArea) / static_cast<float>(patchSize);
+  corrector.apply();
+  ballPosition.x() = (corrector.output(0)[0] - patchSize / 2) * stepSize + ballSpot.x();
+  ballPosition.y() = (corrector.output(0)[1] - patchSize / 2) * stepSize + ballSpot.y();
+  predRadius = corrector.output(0)[2] * stepSize;
 }
 
 void BallPerceptor::compile()
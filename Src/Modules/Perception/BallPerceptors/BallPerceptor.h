@@ -77,6 +77,24 @@ private:
   std::size_t patchSize = 0;
 
   void update(BallPercept& theBallPercept) override;
-  float apply(const Vector2i& ballSpot, Vector2f& ballPosition, float& predRadius);
+
+  /**
+   * Extracts the patch around a ball spot, encodes it and classifies it.
+   * The encoding remains in the output of the encoder.
+   * @param ballSpot The ball spot in the image.
+   * @param ballArea The edge length of the area around the spot that was extracted.
+   * @return The probability that the patch contains a ball (or -1 if the spot cannot be a ball).
+   */
+  float classify(const Vector2i& ballSpot, int& ballArea);
+
+  /**
+   * Determines the position and radius of a ball from the encoding in the input of the corrector.
+   * @param ballSpot The ball spot the encoding was computed for.
+   * @param ballArea The edge length of the area around the spot that was encoded.
+   * @param ballPosition The position of the ball in the image.
+   * @param predRadius The radius of the ball in the image.
+   */
+  void correct(const Vector2i& ballSpot, int ballArea, Vector2f& ballPosition, float& predRadius);
+
   void compile();
 };
\ No newline at end of file
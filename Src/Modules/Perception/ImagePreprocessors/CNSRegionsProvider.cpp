@@ -18,7 +18,6 @@ void CNSRegionsProvider::update(CNSRegions& cnsRegions)
   const int xGridSize = theCameraInfo.width / blockSizeX;
   const int yGridSize = theCameraInfo.height / blockSizeY;
   grid.resize((xGridSize + 2) * (yGridSize + 2));
-  stack.reserve((xGridSize + 2) * (yGridSize + 2));
   std::fill(grid.begin(), grid.end(), 0);
   auto searchGrid = [this, xGridSize](int y, int x) -> char& {return grid[y * (xGridSize + 2) + x];};
 
@@ -28,54 +27,29 @@ void CNSRegionsProvider::update(CNSRegions& cnsRegions)
       for(int x = region.x.min / blockSizeX; x < region.x.max / blockSizeX; ++x)
         searchGrid(y + 1, x + 1) = 1;
 
-  for(int y = 0; y < yGridSize; ++y)
-    for(int x = 0; x < xGridSize; ++x)
-      if(searchGrid(y + 1, x + 1))
-      {
-        Rangei xRange(x, x);
-        Rangei yRange(y, y);
-        floodFill(searchGrid, x + 1, y + 1, xRange, yRange);
-        for(int yy = yRange.min; yy <= yRange.max; ++yy)
-          for(int xx = xRange.min; xx <= xRange.max; ++xx)
-            searchGrid(yy + 1, xx + 1) = 0;
-        cnsRegions.regions.emplace_back(Rangei(xRange.min * blockSizeX, (xRange.max + 1) * blockSizeX),
-                                        Rangei(yRange.min * blockSizeY, (yRange.max + 1) * blockSizeY));
-      }
-}
-
-void CNSRegionsProvider::floodFill(const std::function<char& (int y, int x)>& searchGrid, int x, int y,
-                                   Rangei& xRange, Rangei& yRange)
-{
-  stack.clear();
-  searchGrid(y, x) = 0;
-  stack.push_back(Vector2i(x, y));
-
-  while(!stack.empty())
+  // Blocks are grouped in row-major order of their first block. After a group was found, its whole
+  // bounding box is removed from the grid. If that affected a group found later, the remaining
+  // grid is grouped again.
+  bool again = true;
+  while(again)
   {
-    Vector2i point(stack.back());
-    stack.pop_back();
-    xRange.add(point.x() - 1);
-    yRange.add(point.y() - 1);
-
-    if(searchGrid(point.y() - 1, point.x()))
-    {
-      searchGrid(point.y() - 1, point.x()) = 0;
-      stack.push_back(Vector2i(point.x(), point.y() - 1));
-    }
-    if(searchGrid(point.y() + 1, point.x()))
-    {
-      searchGrid(point.y() + 1, point.x()) = 0;
-      stack.push_back(Vector2i(point.x(), point.y() + 1));
-    }
-    if(searchGrid(point.y(), point.x() - 1))
-    {
-      searchGrid(point.y(), point.x() - 1) = 0;
-      stack.push_back(Vector2i(point.x() - 1, point.y()));
-    }
-    if(searchGrid(point.y(), point.x() + 1))
+    again = false;
+    const size_t firstRegion = cnsRegions.regions.size();
+    connectedComponents.label(&searchGrid(1, 1), xGridSize, yGridSize, xGridSize + 2);
+    for(const Boundaryi& component : connectedComponents.getComponents())
     {
-      searchGrid(point.y(), point.x() + 1) = 0;
-      stack.push_back(Vector2i(point.x() + 1, point.y()));
+      const Boundaryi region(Rangei(component.x.min * blockSizeX, (component.x.max + 1) * blockSizeX),
+                             Rangei(component.y.min * blockSizeY, (component.y.max + 1) * blockSizeY));
+      for(size_t i = firstRegion; i < cnsRegions.regions.size() && !again; ++i)
+        again = cnsRegions.regions[i].x.min < region.x.max && region.x.min < cnsRegions.regions[i].x.max
+                && cnsRegions.regions[i].y.min < region.y.max && region.y.min < cnsRegions.regions[i].y.max;
+      if(again)
+        break;
+
+      for(int y = component.y.min; y <= component.y.max; ++y)
+        for(int x = component.x.min; x <= component.x.max; ++x)
+          searchGrid(y + 1, x + 1) = 0;
+      cnsRegions.regions.emplace_back(region);
     }
   }
 }
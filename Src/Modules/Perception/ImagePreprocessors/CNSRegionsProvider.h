@@ -8,6 +8,7 @@
 
 #include "Representations/Infrastructure/CameraInfo.h"
 #include "Representations/Perception/ImagePreprocessing/ImageRegions.h"
+#include "Tools/ImageProcessing/ConnectedComponents.h"
 #include "Tools/Module/Module.h"
 
 MODULE(CNSRegionsProvider,
@@ -30,19 +31,7 @@ class CNSRegionsProvider : public CNSRegionsProviderBase
    * The mapping from 2-D to the flat array is done dynamically.
    */
   std::vector<char> grid;
-  std::vector<Vector2i> stack; /**< The stack used by the flood fill algorithm to group blocks. */
+  ConnectedComponents connectedComponents; /**< Groups the blocks marked in the grid. */
 
   void update(CNSRegions& cnsRegions) override;
-
-  /**
-   * Determines the size of connected region in the search grid.
-   * @param searchGrid Accessor for search grid.
-   * @param x The x coordinate of a point in the regions.
-   * @param y The y coordinate of a point in the regions.
-   * @param xRange The horizontal extent of the regions is reported here. The coordinates are
-   *               zero-based, i.e. one less than the coordinate system in which x is provided.
-   * @param xRange The vertical extent of the regions is reported here. The coordinates are
-   *               zero-based, i.e. one less than the coordinate system in which y is provided.
-   */
-  void floodFill(const std::function<char&(int y, int x)>& searchGrid, int x, int y, Rangei& xRange, Rangei& yRange);
 };
@@ -6,37 +6,56 @@
 
 #include "ECImageProvider.h"
 #include "Tools/Global.h"
+#include "Tools/ImageProcessing/Resize.h"
 #include <asmjit/asmjit.h>
 
 MAKE_MODULE(ECImageProvider, perception);
 
-#ifndef __arm64__
-
 void ECImageProvider::update(ECImage& ecImage)
 {
   ecImage.grayscaled.setResolution(theCameraInfo.width, theCameraInfo.height);
   ecImage.saturated.setResolution(theCameraInfo.width, theCameraInfo.height);
   ecImage.hued.setResolution(theCameraInfo.width, theCameraInfo.height);
 
+  // The grayscaled image is shrunk in bands right after they were converted, i.e. while they are still cached.
+  const unsigned bandHeight = 1u << shrinkDownScales;
+  ecImage.shrinkDownScales = theCameraInfo.width % 16 == 0 && theCameraInfo.height % bandHeight == 0 ? shrinkDownScales : 0;
+  if(ecImage.shrinkDownScales)
+    ecImage.shrunkGrayscaled.setResolution(theCameraInfo.width >> ecImage.shrinkDownScales, theCameraInfo.height >> ecImage.shrinkDownScales);
+
   if(theCameraImage.timestamp > 10 && static_cast<int>(theCameraImage.width) == theCameraInfo.width / 2)
   {
-    if(disableColor)
-    {
-      if(!eFunc)
-        compileE();
-      eFunc(theCameraInfo.width * theCameraInfo.height / 16, theCameraImage[0], ecImage.grayscaled[0]);
-    }
+    if(ecImage.shrinkDownScales)
+      for(unsigned y = 0; y < ecImage.grayscaled.height; y += bandHeight)
+      {
+        updateRows(ecImage, y, bandHeight);
+        Resize::shrinkYRows(ecImage.shrinkDownScales, ecImage.grayscaled[y], ecImage.grayscaled.width, ecImage.shrunkGrayscaled[y >> ecImage.shrinkDownScales]);
+      }
     else
-    {
-      if(!ecFunc)
-        compileEC();
-
-      ecFunc(theCameraInfo.width * theCameraInfo.height / 16, theCameraImage[0], ecImage.grayscaled[0], ecImage.saturated[0], ecImage.hued[0]);
-    }
+      updateRows(ecImage, 0, ecImage.grayscaled.height);
     ecImage.timestamp = theCameraImage.timestamp;
   }
 }
 
+#ifndef __arm64__
+
+void ECImageProvider::updateRows(ECImage& ecImage, unsigned y, unsigned rows)
+{
+  const unsigned steps = ecImage.grayscaled.width * rows / 16;
+  if(disableColor)
+  {
+    if(!eFunc)
+      compileE();
+    eFunc(steps, theCameraImage[y], ecImage.grayscaled[y]);
+  }
+  else
+  {
+    if(!ecFunc)
+      compileEC();
+    ecFunc(steps, theCameraImage[y], ecImage.grayscaled[y], ecImage.saturated[y], ecImage.hued[y]);
+  }
+}
+
 using namespace asmjit;
 
 void ECImageProvider::compileE()
@@ -326,21 +345,21 @@ ECImageProvider::~ECImageProvider()
 
 template<bool aligned, bool avx>
 void updateSSE(const PixelTypes::YUYVPixel* const srcImage, const int srcWidth, const int srcHeight,
-               Image<PixelTypes::GrayscaledPixel>& grayscaled,
-               Image<PixelTypes::HuePixel>& hued, Image<PixelTypes::GrayscaledPixel>& saturated)
+               PixelTypes::GrayscaledPixel* grayscaled,
+               PixelTypes::HuePixel* hued, PixelTypes::GrayscaledPixel* saturated)
 {
   ASSERT(srcWidth % 32 == 0);
 
-  __m_auto_i* grayscaledDest = reinterpret_cast<__m_auto_i*>(grayscaled[0]) - 1;
-  __m_auto_i* saturatedDest = reinterpret_cast<__m_auto_i*>(saturated[0]) - 1;
-  __m_auto_i* huedDest = reinterpret_cast<__m_auto_i*>(hued[0]) - 1;
+  __m_auto_i* grayscaledDest = reinterpret_cast<__m_auto_i*>(grayscaled) - 1;
+  __m_auto_i* saturatedDest = reinterpret_cast<__m_auto_i*>(saturated) - 1;
+  __m_auto_i* huedDest = reinterpret_cast<__m_auto_i*>(hued) - 1;
   const __m_auto_i* const imageEnd = reinterpret_cast<const __m_auto_i*>(srcImage + srcWidth * srcHeight) - 1;
 
   static const __m_auto_i c_128 = _mmauto_set1_epi8(char(128));
   static const __m_auto_i channelMask = _mmauto_set1_epi16(0x00FF);
 
   const char* prefetchSrc = reinterpret_cast<const char*>(srcImage) + (avx ? 128 : 64);
-  const char* prefetchGrayscaledDest = reinterpret_cast<const char*>(grayscaled[0]) + (avx ? 64 : 32);
+  const char* prefetchGrayscaledDest = reinterpret_cast<const char*>(grayscaled) + (avx ? 64 : 32);
 
   const __m_auto_i* src = reinterpret_cast<__m_auto_i const*>(srcImage) - 1;
   while(src < imageEnd)
@@ -383,21 +402,13 @@ void updateSSE(const PixelTypes::YUYVPixel* const srcImage, const int srcWidth,
   }
 }
 
-void ECImageProvider::update(ECImage& ecImage)
+void ECImageProvider::updateRows(ECImage& ecImage, unsigned y, unsigned rows)
 {
-  ecImage.grayscaled.setResolution(theCameraInfo.width, theCameraInfo.height);
-  ecImage.saturated.setResolution(theCameraInfo.width, theCameraInfo.height);
-  ecImage.hued.setResolution(theCameraInfo.width, theCameraInfo.height);
-
-  if(theCameraImage.timestamp > 10 && static_cast<int>(theCameraImage.width) == theCameraInfo.width / 2)
-  {
-    const PixelTypes::YUYVPixel* const src = reinterpret_cast<const PixelTypes::YUYVPixel* const>(theCameraImage[0]);
-    if(simdAligned<_supportsAVX2>(src))
-      updateSSE<true, _supportsAVX2>(src, theCameraImage.width, theCameraImage.height, ecImage.grayscaled, ecImage.hued, ecImage.saturated);
-    else
-      updateSSE<false, _supportsAVX2>(src, theCameraImage.width, theCameraImage.height, ecImage.grayscaled, ecImage.hued, ecImage.saturated);
-    ecImage.timestamp = theCameraImage.timestamp;
-  }
+  const PixelTypes::YUYVPixel* const src = reinterpret_cast<const PixelTypes::YUYVPixel* const>(theCameraImage[y]);
+  if(simdAligned<_supportsAVX2>(src))
+    updateSSE<true, _supportsAVX2>(src, theCameraImage.width, rows, ecImage.grayscaled[y], ecImage.hued[y], ecImage.saturated[y]);
+  else
+    updateSSE<false, _supportsAVX2>(src, theCameraImage.width, rows, ecImage.grayscaled[y], ecImage.hued[y], ecImage.saturated[y]);
 }
 
 ECImageProvider::~ECImageProvider() {}
@@ -19,6 +19,7 @@ MODULE(ECImageProvider,
   LOADS_PARAMETERS(
   {,
     (bool) disableColor,
+    (unsigned) shrinkDownScales, /**< Also provide the grayscaled image shrunk this often (0 = do not shrink). */
   }),
 });
 
@@ -35,6 +36,15 @@ private:
   EFunc eFunc = nullptr;
 
   void update(ECImage& ecImage) override;
+
+  /**
+   * Converts a band of rows of the camera image.
+   * @param ecImage The images to fill.
+   * @param y The first row of the band.
+   * @param rows The number of rows in the band.
+   */
+  void updateRows(ECImage& ecImage, unsigned y, unsigned rows);
+
   void compileE();
   void compileEC();
 
@@ -15,6 +15,7 @@
 #include "Tools/Math/Transformation.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 MAKE_MODULE(JerseyClassifierProvider, perception);
 
@@ -25,6 +26,8 @@ void JerseyClassifierProvider::update(JerseyClassifier& jerseyClassifier)
   DECLARE_DEBUG_DRAWING("module:JerseyClassifierProvider:jerseyWeights", "drawingOnImage");
   DECLARE_DEBUG_DRAWING("module:JerseyClassifierProvider:jerseyClassification", "drawingOnImage");
 
+  updatePixelClassifier();
+
   jerseyClassifier.detectJersey = [this](const ObstaclesImagePercept::Obstacle& obstacleInImage, ObstaclesFieldPercept::Obstacle& obstacleOnField)
   {
     return detectJersey(obstacleInImage, obstacleOnField);
@@ -114,15 +117,8 @@ void JerseyClassifierProvider::detectJersey(const ObstaclesImagePercept::Obstacl
           maxBrightness = std::max(theECImage.grayscaled[static_cast<int>(centerInImage.y()) + whiteScanOffSet * yOffset][static_cast<int>(x)], maxBrightness);
       
 
-      // Get pixel classifier
-      std::vector<int> opponentColors = {theOpponentTeamInfo.fieldPlayerColour, theOpponentTeamInfo.goalkeeperColour};
-      std::vector<int> ownColors = {theOwnTeamInfo.fieldPlayerColour};
-      if (!theOwnTeamInfo.goalkeeperColour == theOpponentTeamInfo.goalkeeperColour) {
-        ownColors.push_back(theOwnTeamInfo.goalkeeperColour);
-      }
-
-      const std::function<bool(int, int)>& isOwn = getPixelClassifier(ownColors, opponentColors, maxBrightness);
-      const std::function<bool(int, int)>& isOpponent = getPixelClassifier(opponentColors, ownColors, maxBrightness);
+      std::array<unsigned char, 256> brightnessMasks;
+      getBrightnessMasks(maxBrightness, brightnessMasks);
 
       float ownPixels = 0;
       float opponentPixels = 0;
@@ -146,12 +142,17 @@ void JerseyClassifierProvider::detectJersey(const ObstaclesImagePercept::Obstacl
           DOT("module:JerseyClassifierProvider:jerseyWeights", static_cast<int>(x), static_cast<int>(y),
               ColorRGBA(static_cast<unsigned  char>(240 - 240 * weight), static_cast<unsigned  char>(240 * weight), static_cast<unsigned  char>(240 * weight), 220),
               ColorRGBA(static_cast<unsigned  char>(240 - 240 * weight), static_cast<unsigned  char>(240 * weight), static_cast<unsigned  char>(240 * weight), 220));
-          if(isOwn(static_cast<int>(x), static_cast<int>(y)))
+          const int xi = static_cast<int>(x);
+          const int yi = static_cast<int>(y);
+          const unsigned char team = pixelClassifier.teams[pixelClassifier.hueMasks[theECImage.hued[yi][xi]]
+                                                           & pixelClassifier.saturationMasks[theECImage.saturated[yi][xi]]
+                                                           & brightnessMasks[theECImage.grayscaled[yi][xi]]];
+          if(team == 1)
           {
             ownPixels += weight;
             DOT("module:JerseyClassifierProvider:jersey", static_cast<int>(x), static_cast<int>(y), ColorRGBA::yellow, ColorRGBA::yellow);
           }
-          else if(isOpponent(static_cast<int>(x), static_cast<int>(y)))
+          else if(team == 2)
           {
             opponentPixels += weight;
             DOT("module:JerseyClassifierProvider:jersey", static_cast<int>(x), static_cast<int>(y), ColorRGBA::blue, ColorRGBA::blue);
@@ -194,99 +195,139 @@ void JerseyClassifierProvider::detectJersey(const ObstaclesImagePercept::Obstacl
   }
 }
 
-std::function<bool(int, int)> JerseyClassifierProvider::getPixelClassifier(const int positiveColor, const std::vector<int> negativeColors, const int maxBrightness) const
+
+void JerseyClassifierProvider::updatePixelClassifier()
 {
-  std::vector<std::function<bool(int, int)>> classifiers;
-  classifiers.reserve(negativeColors.size());
-  for(auto negativeColor : negativeColors)
-  {
-    classifiers.push_back(getPixelClassifier(positiveColor, negativeColor, maxBrightness));
+  std::vector<int> opponentColors = {theOpponentTeamInfo.fieldPlayerColour, theOpponentTeamInfo.goalkeeperColour};
+  std::vector<int> ownColors = {theOwnTeamInfo.fieldPlayerColour};
+  if (!theOwnTeamInfo.goalkeeperColour == theOpponentTeamInfo.goalkeeperColour) {
+    ownColors.push_back(theOwnTeamInfo.goalkeeperColour);
   }
 
-  return [this, classifiers](const int x, const int y)
-    {
-      // If any classifier is false, pixel is not positiveColor
-      for(auto classifier : classifiers)
-      {
-        if (!classifier(x,y)) return false;
-      }
-      return true;
-    };
+  const std::array<int, 3> parameters = {{hueSimilarityThreshold, colorDelimiter, satThreshold}};
+  if(ownColors == pixelClassifier.ownColors && opponentColors == pixelClassifier.opponentColors && parameters == pixelClassifier.parameters)
+    return;
+
+  pixelClassifier.ownColors = ownColors;
+  pixelClassifier.opponentColors = opponentColors;
+  pixelClassifier.parameters = parameters;
+  pixelClassifier.hueMasks.fill(0);
+  pixelClassifier.saturationMasks.fill(0);
+  pixelClassifier.brightnessConditions.clear();
+  const std::vector<unsigned char> ownRules = addRules(ownColors, opponentColors);
+  const std::vector<unsigned char> opponentRules = addRules(opponentColors, ownColors);
+
+  // A pixel has a jersey color of a team if it satisfies all rules of one of the colors.
+  // The own team is checked first.
+  const auto hasColor = [](const unsigned mask, const std::vector<unsigned char>& rules)
+  {
+    return std::any_of(rules.begin(), rules.end(), [mask](const unsigned char bits) {return (mask & bits) == bits;});
+  };
+  for(unsigned mask = 0; mask < pixelClassifier.teams.size(); ++mask)
+    pixelClassifier.teams[mask] = hasColor(mask, ownRules) ? 1 : hasColor(mask, opponentRules) ? 2 : 0;
 }
 
-std::function<bool(int, int)> JerseyClassifierProvider::getPixelClassifier(const std::vector<int> positiveColors, const std::vector<int> negativeColors, const int maxBrightness) const
+std::vector<unsigned char> JerseyClassifierProvider::addRules(const std::vector<int>& positiveColors, const std::vector<int>& negativeColors)
 {
-  std::vector<std::function<bool(int, int)>> classifiers;
-  classifiers.reserve(negativeColors.size());
-  for(int positiveColor : positiveColors)
+  std::vector<unsigned char> rules;
+  rules.reserve(positiveColors.size());
+  for(const int positiveColor : positiveColors)
   {
-    classifiers.push_back(getPixelClassifier(positiveColor, negativeColors, maxBrightness));
+    // If any rule is not satisfied, the pixel does not have the positive color.
+    unsigned char bits = 0;
+    for(const int negativeColor : negativeColors)
+      bits |= addRule(positiveColor, negativeColor);
+    rules.push_back(bits);
   }
-
-  return [this, classifiers](const int x, const int y)
-    {
-      // If any classifier is true, pixel is one of positiveColors
-      for(auto classifier : classifiers)
-      {
-        if (classifier(x,y)) return true;
-      }
-      return false;
-    };
+  return rules;
 }
 
-std::function<bool(int, int)> JerseyClassifierProvider::getPixelClassifier(const int fieldPlayerColour, const int otherColor, const int maxBrightness) const
+unsigned char JerseyClassifierProvider::addRule(const int fieldPlayerColour, const int otherColor)
 {
+  ASSERT(pixelClassifier.brightnessConditions.size() < std::numeric_limits<unsigned char>::digits);
+  const unsigned char bit = static_cast<unsigned char>(1 << pixelClassifier.brightnessConditions.size());
   const int teamHue = jerseyHues[fieldPlayerColour];
   const int otherHue = jerseyHues[otherColor];
-  const Rangei grayRange = Rangei(static_cast<int>(maxBrightness * this->grayRange.min),
-                                  static_cast<int>(maxBrightness * this->grayRange.max));
+
+  const auto addConditions = [this, bit](const int saturationLimit, const BrightnessCondition brightness, const auto& isHue)
+  {
+    for(int saturation = 0; saturation < std::min(saturationLimit, 256); ++saturation)
+      pixelClassifier.saturationMasks[saturation] |= bit;
+    pixelClassifier.brightnessConditions.push_back(brightness);
+    for(int hue = 0; hue < 256; ++hue)
+      if(isHue(hue))
+        pixelClassifier.hueMasks[hue] |= bit;
+  };
+  const auto anyHue = [](const int) {return true;};
 
   // If gray is involved, different brightnesses must be distinguished.
   if(fieldPlayerColour == TEAM_GRAY)
-    return [this, grayRange](const int x, const int y)
-    {
-      const unsigned char saturation = theECImage.saturated[y][x];
-      return saturation < colorDelimiter && grayRange.isInside(theECImage.grayscaled[y][x]);
-    };
+    addConditions(colorDelimiter, inGrayRange, anyHue);
   else if(fieldPlayerColour == TEAM_BLACK && (otherColor == TEAM_GRAY || otherColor == TEAM_WHITE))
-    return [this, grayRange](const int x, const int y)
-    {
-      return theECImage.saturated[y][x] < colorDelimiter && theECImage.grayscaled[y][x] < grayRange.min;
-    };
+    addConditions(colorDelimiter, belowGrayRange, anyHue);
   else if(fieldPlayerColour == TEAM_WHITE && (otherColor == TEAM_BLACK || otherColor == TEAM_GRAY))
-    return [this, grayRange](const int x, const int y)
-    {
-      return theECImage.saturated[y][x] < colorDelimiter && theECImage.grayscaled[y][x] > grayRange.max;
-    };
+    addConditions(colorDelimiter, aboveGrayRange, anyHue);
 
   // Black or white against color
-  else if(fieldPlayerColour == TEAM_BLACK)
-    return [this, grayRange, otherHue](const int x, const int y)
-    {
-      return theECImage.saturated[y][x] < satThreshold && theECImage.grayscaled[y][x] <= grayRange.min &&
-             std::abs(static_cast<char>(theECImage.hued[y][x] - otherHue)) > hueSimilarityThreshold;
-    };
-  else if(fieldPlayerColour == TEAM_WHITE)
-    return [this, grayRange, otherHue](const int x, const int y)
+  else if(fieldPlayerColour == TEAM_BLACK || fieldPlayerColour == TEAM_WHITE)
+    addConditions(satThreshold, fieldPlayerColour == TEAM_BLACK ? atMostMinGray : atLeastMaxGray, [this, otherHue](const int hue)
     {
-      return theECImage.saturated[y][x] < satThreshold && theECImage.grayscaled[y][x] >= grayRange.max &&
-             std::abs(static_cast<char>(theECImage.hued[y][x] - otherHue)) > hueSimilarityThreshold;
-    };
+      return std::abs(static_cast<char>(hue - otherHue)) > hueSimilarityThreshold;
+    });
 
   // This team uses a color, the other team does not.
   else if(otherColor == TEAM_WHITE || otherColor == TEAM_BLACK || otherColor == TEAM_GRAY)
-  {
-    return [this, teamHue](const int x, const int y)
+    addConditions(256, anyBrightness, [this, teamHue](const int hue)
     {
-      return std::abs(static_cast<char>(theECImage.hued[y][x] - teamHue)) <= hueSimilarityThreshold;
-    };
-  }
+      return std::abs(static_cast<char>(hue - teamHue)) <= hueSimilarityThreshold;
+    });
+
   // Both teams use colors, use the closer one.
   else
-    return [this, teamHue, otherHue](const int x, const int y)
+    addConditions(256, anyBrightness, [this, teamHue, otherHue](const int hue)
     {
-      const int hue = theECImage.hued[y][x];
       // Casting to char should resolve the wraparound cases.
       return std::abs(static_cast<char>(hue - teamHue)) < std::min(std::abs(static_cast<char>(hue - otherHue)), hueSimilarityThreshold);
-    };
+    });
+
+  return bit;
+}
+
+void JerseyClassifierProvider::getBrightnessMasks(const int maxBrightness, std::array<unsigned char, 256>& brightnessMasks) const
+{
+  const int minGray = static_cast<int>(maxBrightness * grayRange.min);
+  const int maxGray = static_cast<int>(maxBrightness * grayRange.max);
+
+  brightnessMasks.fill(0);
+  unsigned char bit = 1;
+  for(const BrightnessCondition condition : pixelClassifier.brightnessConditions)
+  {
+    // Each condition accepts a single range of brightnesses.
+    int min = 0;
+    int max = 255;
+    switch(condition)
+    {
+      case inGrayRange:
+        min = minGray;
+        max = maxGray;
+        break;
+      case belowGrayRange:
+        max = minGray - 1;
+        break;
+      case aboveGrayRange:
+        min = maxGray + 1;
+        break;
+      case atMostMinGray:
+        max = minGray;
+        break;
+      case atLeastMaxGray:
+        min = maxGray;
+        break;
+      default:
+        break;
+    }
+    for(int brightness = std::max(min, 0); brightness <= std::min(max, 255); ++brightness)
+      brightnessMasks[brightness] |= bit;
+    bit <<= 1;
+  }
 }
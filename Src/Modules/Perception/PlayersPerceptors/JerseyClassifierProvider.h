@@ -21,7 +21,8 @@
 #include "Representations/Perception/ObstaclesPercepts/JerseyClassifier.h"
 #include "Tools/Module/Module.h"
 #include "Tools/Range.h"
-#include <functional>
+#include <array>
+#include <vector>
 
 MODULE(JerseyClassifierProvider,
 {,
@@ -73,18 +74,70 @@ class JerseyClassifierProvider : public JerseyClassifierProviderBase
    */
   void detectJersey(const ObstaclesImagePercept::Obstacle& obstacleInImage, ObstaclesFieldPercept::Obstacle& obstacleOnField) const;
 
+  /** The conditions a rule can impose on the brightness of a pixel, relative to the gray range. */
+  enum BrightnessCondition
+  {
+    anyBrightness,
+    inGrayRange,
+    belowGrayRange,
+    aboveGrayRange,
+    atMostMinGray,
+    atLeastMaxGray,
+  };
+
+  /**
+   * The jersey colors of both teams compiled into lookup tables. Each rule, i.e.
+   * that a pixel has a certain jersey color of one team and not a certain color of
+   * the other team, gets a bit. The conditions of the rules on hue and saturation
+   * only depend on the team colors and are tabulated when they change. The
+   * conditions on brightness are tabulated per obstacle, because they depend on
+   * the brightest pixel below the jersey. A pixel is classified by combining one
+   * entry of each table and looking up which team the combination stands for.
+   */
+  struct PixelClassifier
+  {
+    std::vector<int> ownColors; /**< The jersey colors of the own team the tables were built for. */
+    std::vector<int> opponentColors; /**< The jersey colors of the opponent team the tables were built for. */
+    std::array<int, 3> parameters = {{-1, -1, -1}}; /**< hueSimilarityThreshold, colorDelimiter, and satThreshold the tables were built for. */
+    std::array<unsigned char, 256> hueMasks; /**< The rules a hue satisfies. */
+    std::array<unsigned char, 256> saturationMasks; /**< The rules a saturation satisfies. */
+    std::vector<BrightnessCondition> brightnessConditions; /**< The condition on the brightness of each rule. */
+    std::array<unsigned char, 256> teams; /**< The team a combination of satisfied rules stands for (0: none, 1: own, 2: opponent). */
+  };
+
+  PixelClassifier pixelClassifier; /**< The lookup tables for the current team colors. */
+
+  /**
+   * Rebuilds the tables of the pixel classifier if the team colors or the
+   * parameters changed.
+   */
+  void updatePixelClassifier();
+
+  /**
+   * Adds the rules that decide whether a pixel has one of the jersey colors of
+   * a team.
+   * @param positiveColors The jersey colors of the team.
+   * @param negativeColors The jersey colors of the other team.
+   * @return For each positive color, the bits of the rules that must all be satisfied.
+   */
+  std::vector<unsigned char> addRules(const std::vector<int>& positiveColors, const std::vector<int>& negativeColors);
+
   /**
    * The method determines the best way to detect whether a pixel belongs to the jersey
    * color of a specific team. It also considers the jersey color the other team uses.
+   * The rule is added to the tables of the pixel classifier.
    * @param fieldPlayerColour The team color index of the jersey color that should be detected.
-   * @param otherTeam The team color index of the other team playing.
+   * @param otherColor The team color index of the other team playing.
+   * @return The bit of the rule.
+   */
+  unsigned char addRule(const int fieldPlayerColour, const int otherColor);
+
+  /**
+   * Tabulates the conditions of all rules on the brightness of a pixel.
    * @param maxBrightness The intensity of the brightest pixel below the jersey. This
-   *                     functions as a reference if one of the two teams uses the
-   *                     jersey color gray.
-   * @return The classifier that detects whether the pixel at (x, y) (the two parameters)
-   *         belongs to the jersey color of fieldPlayerColour.
+   *                      functions as a reference if one of the two teams uses the
+   *                      jersey color gray, black, or white.
+   * @param brightnessMasks The rules each brightness satisfies.
    */
-  std::function<bool(const int, const int)> getPixelClassifier(const int fieldPlayerColour, const int otherColor, const int maxBrightness) const;
-  std::function<bool(const int, const int)> getPixelClassifier(const int positiveColor, const std::vector<int> negativeColors, const int maxBrightness) const;
-  std::function<bool(const int, const int)> getPixelClassifier(const std::vector<int> positiveColors, const std::vector<int> negativeColors, const int maxBrightness) const;
+  void getBrightnessMasks(const int maxBrightness, std::array<unsigned char, 256>& brightnessMasks) const;
 };
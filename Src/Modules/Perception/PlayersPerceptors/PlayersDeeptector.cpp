@@ -17,6 +17,8 @@
 #include "Tools/Math/Projection.h"
 #include "Tools/Math/Transformation.h"
 #include <CompiledNN/Model.h>
+#include <cstring>
+#include <limits>
 
 MAKE_MODULE(PlayersDeeptector, perception);
 
@@ -72,11 +74,13 @@ void PlayersDeeptector::update(ObstaclesFieldPercept& theObstaclesFieldPercept)
     ASSERT(theECImage.grayscaled.width == static_cast<unsigned>(patchSize(0)) << scale);
     ASSERT(theECImage.grayscaled.height == static_cast<unsigned>(patchSize(1)) << scale);
 
-    // Can't shrink directly to NN input because it needs a larger buffer :-(
-    STOPWATCH("module:PlayersDeeptector:shrinkY") Resize::shrinkY(scale, theECImage.grayscaled, thumbnail);
-    ASSERT(patchSize(0) == static_cast<int>(thumbnail.width));
-    ASSERT(patchSize(1) == static_cast<int>(thumbnail.height));
-    std::memcpy(reinterpret_cast<unsigned char*>(convModel.input(0).data()), thumbnail[0], thumbnail.width * thumbnail.height * sizeof(unsigned char));
+    STOPWATCH("module:PlayersDeeptector:shrinkY")
+    {
+      if(scale && scale == theECImage.shrinkDownScales)
+        std::memcpy(convModel.input(0).data(), theECImage.shrunkGrayscaled[0], theECImage.shrunkGrayscaled.width * theECImage.shrunkGrayscaled.height);
+      else
+        Resize::shrinkYRowwise(scale, theECImage.grayscaled, reinterpret_cast<unsigned char*>(convModel.input(0).data()));
+    }
     STOPWATCH("module:PlayersDeeptector:normalizeContrast")
       PatchUtilities::normalizeContrast<unsigned char>(reinterpret_cast<unsigned char*>(convModel.input(0).data()), patchSize, 0.02f);
     STOPWATCH("module:PlayersDeeptector:apply") convModel.apply();
@@ -266,11 +270,11 @@ void PlayersDeeptector::boundingBoxes(LabelImage& labelImage)
           box.distance = pred(b, 5);
           box.measuredDistance = box.distance;
 
+          if(theFieldBoundary.getBoundaryY(static_cast<int>((box.lowerRight.x() + box.upperLeft.x()) / 2.f)) > box.lowerRight.y())
+            continue;
           Vector2f point = Vector2f((box.lowerRight.x() + box.upperLeft.x()) / 2, box.lowerRight.y());
           if(box.lowerRight.y() < theCameraInfo.height - 50 && Transformation::imageToRobot((Vector2i)point.cast<int>(), theCameraMatrix, theCameraInfo, point))
             box.measuredDistance = point.norm() / 1000;
-          if(theFieldBoundary.getBoundaryY(static_cast<int>((box.lowerRight.x() + box.upperLeft.x()) / 2.f)) > box.lowerRight.y())
-            continue;
           labelImage.annotations.emplace_back(box);
         }
       }
@@ -349,14 +353,26 @@ bool PlayersDeeptector::trimObstacle(bool trimHeight, ObstaclesImagePercept::Obs
 void PlayersDeeptector::scanImage(std::vector<std::vector<Region>>& regions)
 {
   std::vector<std::pair<int, int>> yLimits(theECImage.grayscaled.width / xyStep);
+  int minTop = std::numeric_limits<int>::max(), maxBottom = std::numeric_limits<int>::min();
   for(unsigned int x = 0, index = 0; index < theECImage.grayscaled.width / xyStep; x += xyStep, ++index)
+  {
     yLimits[index] = std::make_pair(theFieldBoundary.getBoundaryY(x), theBodyContour.getBottom(x, theCameraInfo.height));
+    minTop = std::min(minTop, yLimits[index].first);
+    maxBottom = std::max(maxBottom, yLimits[index].second);
+  }
   const float yRegionsDivisor = static_cast<float>(theECImage.grayscaled.height) / xyRegions, xRegionsDivisor = static_cast<float>(theECImage.grayscaled.width) / xyRegions;
 
-  std::pair<const PixelTypes::GrayscaledPixel*, const PixelTypes::GrayscaledPixel*> upperRow = {theECImage.grayscaled[0], theECImage.saturated[0]};
-  std::pair<const PixelTypes::GrayscaledPixel*, const PixelTypes::GrayscaledPixel*> midRow = upperRow;
+  // Rows that are above the field boundary or below the body contour in all columns are skipped.
+  // Both limits are signed, because the body contour might cover the whole image or no column was scanned at all.
+  const int yStart = minTop + static_cast<int>(xyStep) < 0 ? 0
+                     : static_cast<int>(std::min((minTop + xyStep) / xyStep * xyStep + xyStep, theECImage.grayscaled.height - xyStep));
+  const int yEnd = std::max(0, std::min(static_cast<int>(theECImage.grayscaled.height - xyStep), maxBottom - static_cast<int>(xyStep)));
+  if(yStart >= yEnd)
+    return;
+  std::pair<const PixelTypes::GrayscaledPixel*, const PixelTypes::GrayscaledPixel*> upperRow = {theECImage.grayscaled[yStart ? yStart - xyStep : 0], theECImage.saturated[yStart ? yStart - xyStep : 0]};
+  std::pair<const PixelTypes::GrayscaledPixel*, const PixelTypes::GrayscaledPixel*> midRow = {theECImage.grayscaled[yStart], theECImage.saturated[yStart]};
   std::pair<const PixelTypes::GrayscaledPixel*, const PixelTypes::GrayscaledPixel*> lowerRow;
-  for(unsigned int y = 0; y < theECImage.grayscaled.height - xyStep; y += xyStep, upperRow = midRow, midRow = lowerRow)
+  for(unsigned int y = yStart; static_cast<int>(y) < yEnd; y += xyStep, upperRow = midRow, midRow = lowerRow)
   {
     lowerRow = {theECImage.grayscaled[y + xyStep], theECImage.saturated[y + xyStep]};
     short leftLum = *midRow.first, leftSat = *midRow.second, midLum = leftLum, midSat = leftSat;
@@ -73,7 +73,6 @@ private:
   Vector2i patchSize;
   std::unique_ptr<NeuralNetwork::Model> model;
   NeuralNetwork::CompiledNN convModel;
-  Image<PixelTypes::GrayscaledPixel> thumbnail;
   Matrix4x2f anchors;
   std::vector<ObstaclesImagePercept::Obstacle> obstaclesUpper, obstaclesLower;
 
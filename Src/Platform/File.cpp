@@ -132,6 +132,12 @@ size_t File::getPosition()
   }
 }
 
+void File::setPosition(size_t position)
+{
+  if(stream)
+    VERIFY(fseek(static_cast<FILE*>(stream), position, SEEK_SET) == 0);
+}
+
 bool File::isAbsolute(const char* path)
 {
   return (path[0] && path[1] == ':') || path[0] == '/' || path[0] == '\\';
@@ -96,6 +96,12 @@ public:
    */
   size_t getPosition();
 
+  /**
+   * The function sets the current position in the file.
+   * @param position The new position in number of bytes since the begin
+   */
+  void setPosition(size_t position);
+
   /**
    * The function returns the full path of the file.
    * @return The full path name actually used or the file searched for
@@ -1,6 +1,10 @@
 #include "Platform/Memory.h"
 
 #include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 void* Memory::alignedMalloc(size_t size, size_t alignment)
 {
@@ -15,3 +19,24 @@ void Memory::alignedFree(void* ptr)
 {
   free(ptr);
 }
+
+char* Memory::mapFile(const std::string& fileName, size_t& size)
+{
+  const int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd == -1)
+    return nullptr;
+  struct stat status;
+  void* ptr = MAP_FAILED;
+  if(!fstat(fd, &status) && status.st_size > 0)
+  {
+    size = static_cast<size_t>(status.st_size);
+    ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  return ptr != MAP_FAILED ? static_cast<char*>(ptr) : nullptr;
+}
+
+void Memory::unmapFile(char* ptr, size_t size)
+{
+  munmap(ptr, size);
+}
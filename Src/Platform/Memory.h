@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
 
 namespace Memory
 {
@@ -9,4 +10,16 @@ namespace Memory
 
   /** Free aligned memory. */
   void alignedFree(void* ptr);
+
+  /**
+   * Map a file into memory. Its contents are only read when they are accessed.
+   * The memory can be changed, but changes are not written back to the file.
+   * @param fileName The full path of the file.
+   * @param size The size of the mapping is returned here.
+   * @return The address of the mapping or nullptr if the file could not be mapped.
+   */
+  char* mapFile(const std::string& fileName, size_t& size);
+
+  /** Unmap a file mapped with mapFile. */
+  void unmapFile(char* ptr, size_t size);
 }
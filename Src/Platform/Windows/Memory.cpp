@@ -11,3 +11,29 @@ void Memory::alignedFree(void* ptr)
 {
   _aligned_free(ptr);
 }
+
+char* Memory::mapFile(const std::string& fileName, size_t& size)
+{
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+    return nullptr;
+  void* ptr = nullptr;
+  LARGE_INTEGER fileSize;
+  if(GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+  {
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if(mapping)
+    {
+      size = static_cast<size_t>(fileSize.QuadPart);
+      ptr = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+      CloseHandle(mapping);
+    }
+  }
+  CloseHandle(file);
+  return static_cast<char*>(ptr);
+}
+
+void Memory::unmapFile(char* ptr, size_t)
+{
+  UnmapViewOfFile(ptr);
+}
@@ -11,6 +11,7 @@
 #include "Tools/Math/Eigen.h"
 #include "Tools/Streams/AutoStreamable.h"
 #include "Tools/Function.h"
+#include <vector>
 
 STREAMABLE(PotentialValue,
 {
@@ -33,5 +34,25 @@ STREAMABLE(FieldRating,
   FUNCTION(void(PotentialValue& pv, const PotentialValue& ballNear)) removeBallNearFromTeammatePotential;
   FUNCTION(void(PotentialValue& pv, const float x, const float y, const bool calculateFieldDirection)) duelBallNearPotential;
   FUNCTION(void(PotentialValue& pv, const float x, const float y, const bool calculateFieldDirection)) getPotentialOtherSide;
-  FUNCTION(void(PotentialValue& pv, const float x, const float y, const bool calculateFieldDirection)) getObstaclePotential,
+  FUNCTION(void(PotentialValue& pv, const float x, const float y, const bool calculateFieldDirection)) getObstaclePotential;
+
+  /**
+   * Evaluates the potential of the field, the obstacles and the teammates, i.e. potentialFieldOnly,
+   * getObstaclePotential and potentialOverall combined, for many points at once.
+   * This is much cheaper than evaluating the points one by one.
+   * @param points The points on the field.
+   * @param pvs The potentials at the points, in the same order. The vector is resized as needed.
+   * @param calculateFieldDirection Calculate the directions as well?
+   */
+  FUNCTION(void(const std::vector<Vector2f>& points, std::vector<PotentialValue>& pvs, const bool calculateFieldDirection)) potentialForPoints;
+
+  /**
+   * Evaluates the combined potential (see potentialForPoints) on a regular grid.
+   * @param min The first corner of the grid.
+   * @param max The opposite corner of the grid.
+   * @param size The number of points in x and y direction (at least 1 each).
+   * @param pvs The potentials. pvs[y * size.x() + x] belongs to the point min + (max - min).cwiseQuotient(size - 1) .* (x, y).
+   * @param calculateFieldDirection Calculate the directions as well?
+   */
+  FUNCTION(void(const Vector2f& min, const Vector2f& max, const Vector2i& size, std::vector<PotentialValue>& pvs, const bool calculateFieldDirection)) potentialForGrid,
 });
@@ -34,4 +34,6 @@ STREAMABLE(ECImage,
   (Image<PixelTypes::GrayscaledPixel>) grayscaled,
   (Image<PixelTypes::GrayscaledPixel>) saturated,
   (Image<PixelTypes::HuePixel>) hued,
+  (unsigned)(0) shrinkDownScales, /**< How often the width and height of grayscaled were halved to get shrunkGrayscaled. 0 if it was not computed. */
+  (Image<PixelTypes::GrayscaledPixel>) shrunkGrayscaled, /**< A downscaled version of grayscaled as computed by Resize::shrinkY. */
 });
@@ -89,4 +89,6 @@ protected:
 
   friend class ModuleContainer; // To add receivers and senders
   friend class LocalRobot; // To add receiver and sender in simulation
+  friend class ReplayThread; // To add receiver and sender in the LogReplayer
+  friend class MatchThread; // To add receiver and sender in the MatchSimulator
 };
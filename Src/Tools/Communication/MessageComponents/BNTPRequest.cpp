@@ -4,7 +4,7 @@ size_t BNTPRequestComponent::compress(uint8_t* buff) {
     return getSize();
 }
 
-bool BNTPRequestComponent::decompress(uint8_t* compressed) {
+bool BNTPRequestComponent::decompress(uint8_t* compressed, size_t length) {
     return true;
 }
 
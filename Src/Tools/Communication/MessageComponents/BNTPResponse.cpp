@@ -7,8 +7,8 @@
 size_t BNTPResponseComponent::compress(uint8_t* buff) {
     size_t byteOffset = 0;
     
-    // size must be less than max(n)
-    ASSERT(messages.size() < std::numeric_limits<uint8_t>::max());
+    // size must be less than max(n) and fit into a packet
+    ASSERT(messages.size() <= maxMessages);
     uint8_t n = (uint8_t) messages.size();
 
     // n first
@@ -30,15 +30,23 @@ size_t BNTPResponseComponent::compress(uint8_t* buff) {
     return byteOffset;
 }
 
-bool BNTPResponseComponent::decompress(uint8_t* compressed) {
+bool BNTPResponseComponent::decompress(uint8_t* compressed, size_t length) {
     size_t byteOffset = 0;
     uint8_t n;
 
     messages.clear();
 
+    if (length < sizeof(n)) {
+        return false;
+    }
     memcpy(&n, compressed + byteOffset, sizeof(n));
     byteOffset += sizeof(n);
 
+    // All n messages must be part of the packet
+    if (n > maxMessages || byteOffset + n * messageSize > length) {
+        return false;
+    }
+
     for (size_t i = 0; i < n; i++)
     {
         BNTPMessage msg;
@@ -60,5 +68,5 @@ bool BNTPResponseComponent::decompress(uint8_t* compressed) {
 
 size_t BNTPResponseComponent::getSize() {
     // size(n) + size([origination, reciept, reciever]) * n
-    return 1 + 9 * messages.size();
+    return 1 + messageSize * messages.size();
 }
\ No newline at end of file
@@ -6,13 +6,16 @@ class BNTPResponseComponent: public RobotMessageComponent<BNTPResponseComponent>
   public:
   std::list<BNTPMessage> messages;
 
+  static constexpr size_t messageSize = 9; // origination(4), reciept(4), reciever(1)
+  static constexpr size_t maxMessages = (SPL_MAX_MESSAGE_BYTES - sizeof(RobotMessageHeader) - COMPONENT_BITFIELD_SIZE - 1) / messageSize; // The most responses that fit into a packet
+
   //Required
   inline static const std::string name = "BNTPResponse";
   BNTPResponseComponent() : RobotMessageComponent<BNTPResponseComponent>() { }
 
   size_t compress(uint8_t* buff);
 
-  bool decompress(uint8_t* compressed);
+  bool decompress(uint8_t* compressed, size_t length);
 
   size_t getSize();
 };
\ No newline at end of file
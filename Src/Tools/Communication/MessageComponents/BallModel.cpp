@@ -28,8 +28,33 @@
       };
 */ 
 
+void BallModelComponent::getDifferences(const BallModel& model, const DeltaEncoding<BallModel>::Keyframe& reference, unsigned timestamp, float (&differences)[8]) {
+  const float dt = static_cast<int>(timestamp - reference.timestamp) / 1000.f;
+  const Vector2f predictedPosition = reference.state.estimate.position + reference.state.estimate.velocity * dt;
+  differences[0] = model.lastPerception.x() - reference.state.lastPerception.x();
+  differences[1] = model.lastPerception.y() - reference.state.lastPerception.y();
+  differences[2] = model.estimate.position.x() - predictedPosition.x();
+  differences[3] = model.estimate.position.y() - predictedPosition.y();
+  differences[4] = model.estimate.velocity.x() - reference.state.estimate.velocity.x();
+  differences[5] = model.estimate.velocity.y() - reference.state.estimate.velocity.y();
+  differences[6] = static_cast<float>(static_cast<int>(model.timeWhenLastSeen - reference.state.timeWhenLastSeen));
+  differences[7] = static_cast<float>(static_cast<int>(model.timeWhenDisappeared - reference.state.timeWhenDisappeared));
+}
+
 size_t BallModelComponent::compress(uint8_t* buff) {
-  size_t byteOffset = 0;
+  size_t byteOffset = delta.writeTag(buff);
+
+  if (!delta.keyframe) {
+    float differences[8];
+    getDifferences(model, delta.reference(), delta.header.timestamp, differences);
+    for (size_t i = 0; i < 8; i++) {
+      byteOffset += delta.writeDelta(buff + byteOffset, differences[i], units[i]);
+    }
+    uint8_t sp = model.seenPercentage;
+    memcpy(buff + byteOffset, &sp, sizeof(sp));
+    byteOffset += sizeof(sp);
+    return byteOffset;
+  }
 
   // last_perception
   float lx = model.lastPerception.x();
@@ -79,8 +104,44 @@ size_t BallModelComponent::compress(uint8_t* buff) {
   return byteOffset;
 }
 
-bool BallModelComponent::decompress(uint8_t* compressed) {
-  size_t byteOffset = 0;
+bool BallModelComponent::decompress(uint8_t* compressed, size_t length) {
+  if (length < 1) {
+    return false;
+  }
+  // The tag determines whether a keyframe or a delta follows and thereby the size
+  const DeltaEncoding<BallModel>::Keyframe* reference = delta.readTag(compressed);
+  size_t byteOffset = 1;
+  if (length < getSize()) {
+    delta.resolved = false;
+    return false;
+  }
+
+  if (!delta.keyframe) {
+    float lx, ly, x, y, vx, vy, t, t2;
+    byteOffset += delta.readDelta(compressed + byteOffset, positionUnit, lx);
+    byteOffset += delta.readDelta(compressed + byteOffset, positionUnit, ly);
+    byteOffset += delta.readDelta(compressed + byteOffset, positionUnit, x);
+    byteOffset += delta.readDelta(compressed + byteOffset, positionUnit, y);
+    byteOffset += delta.readDelta(compressed + byteOffset, velocityUnit, vx);
+    byteOffset += delta.readDelta(compressed + byteOffset, velocityUnit, vy);
+    byteOffset += delta.readDelta(compressed + byteOffset, timeUnit, t);
+    byteOffset += delta.readDelta(compressed + byteOffset, timeUnit, t2);
+    uint8_t sp;
+    memcpy(&sp, compressed + byteOffset, sizeof(sp));
+    byteOffset += sizeof(sp);
+
+    if (reference) {
+      const BallModel& key = reference->state;
+      const float dt = static_cast<int>(delta.header.timestamp - reference->timestamp) / 1000.f;
+      model.lastPerception = key.lastPerception + Vector2f(lx, ly);
+      model.estimate.position = key.estimate.position + key.estimate.velocity * dt + Vector2f(x, y);
+      model.estimate.velocity = key.estimate.velocity + Vector2f(vx, vy);
+      model.timeWhenLastSeen = key.timeWhenLastSeen + static_cast<int>(t);
+      model.timeWhenDisappeared = key.timeWhenDisappeared + static_cast<int>(t2);
+      model.seenPercentage = sp;
+    }
+    return byteOffset == getSize();
+  }
 
   // last_perception
   float lx;
@@ -89,7 +150,7 @@ bool BallModelComponent::decompress(uint8_t* compressed) {
   model.lastPerception.x() = lx;
 
   float ly;
-  memcpy(&lx, compressed + byteOffset, sizeof(ly));
+  memcpy(&ly, compressed + byteOffset, sizeof(ly));
   byteOffset += sizeof(ly);
   model.lastPerception.y() = ly;
 
@@ -131,9 +192,32 @@ bool BallModelComponent::decompress(uint8_t* compressed) {
   byteOffset += sizeof(sp);
   model.seenPercentage = sp;
 
+  delta.received(compressed, model);
   return byteOffset == getSize();
 }
 
 size_t BallModelComponent::getSize() {
-    return  6*sizeof(float) + 2*sizeof(unsigned int) + sizeof(uint8_t);
+  return delta.keyframe ? 1 + 6*sizeof(float) + 2*sizeof(unsigned int) + sizeof(uint8_t) : 1 + 8*sizeof(int16_t) + sizeof(uint8_t);
+}
+
+void BallModelComponent::setHeader(const RobotMessageHeader& header) {
+  float differences[8];
+  getDifferences(model, delta.reference(), header.timestamp, differences);
+  bool encodable = true;
+  int16_t quantized;
+  for (size_t i = 0; i < 8 && encodable; i++) {
+    encodable = delta.quantize(differences[i], units[i], quantized);
+  }
+  delta.prepare(header, encodable);
+}
+
+void BallModelComponent::sent() {
+  delta.sent(model);
+}
+
+void BallModelComponent::doCallbacks(RobotMessageHeader& header) {
+  // A delta against a keyframe that was not received carries no usable ball model
+  if (delta.resolved) {
+    RobotMessageComponent<BallModelComponent>::doCallbacks(header);
+  }
 }
\ No newline at end of file
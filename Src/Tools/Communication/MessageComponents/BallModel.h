@@ -1,5 +1,6 @@
 #pragma once
 #include "Tools/Communication/RobotMessage.h"
+#include "Tools/Communication/MessageComponents/DeltaEncoding.h"
 #include "Representations/Modeling/BallModel.h"
 // #include "Proto/FieldBall_bp.h"
 
@@ -10,11 +11,38 @@ class BallModelComponent : public RobotMessageComponent<BallModelComponent> {
 
   //Required
   inline static const std::string name = "BallModel";
+  inline static const unsigned version = 1; // 1: Deltas against keyframes
   BallModelComponent() : RobotMessageComponent<BallModelComponent>() { }
 
   size_t compress(uint8_t* buff);
 
-  bool decompress(uint8_t* compressed);
+  bool decompress(uint8_t* compressed, size_t length);
 
   size_t getSize();
+
+  void setHeader(const RobotMessageHeader& header);
+
+  void sent();
+
+  void doCallbacks(RobotMessageHeader& header);
+
+  private:
+  static constexpr float positionUnit = 1.f; // The resolution of position deltas in mm
+  static constexpr float velocityUnit = 1.f; // The resolution of velocity deltas in mm/s
+  static constexpr float timeUnit = 1.f; // The resolution of timestamp deltas in ms
+  static constexpr float units[8] = {positionUnit, positionUnit, positionUnit, positionUnit, velocityUnit, velocityUnit, timeUnit, timeUnit}; // The resolutions of the differences
+
+  /**
+   * @brief The differences that are sent in a delta, in the order they are sent
+   * 
+   * @param model The model to encode
+   * @param reference The keyframe the model is encoded against
+   * @param timestamp The timestamp of the message that contains the model
+   * @param differences 
+   */
+  static void getDifferences(const BallModel& model, const DeltaEncoding<BallModel>::Keyframe& reference, unsigned timestamp, float (&differences)[8]);
+
+  // Keyframe: tag + 33 bytes model = 34 bytes, Delta: tag + 8 * int16 against the keyframe + seen percentage = 18 bytes.
+  // The position is encoded against the keyframe's position moved by its velocity.
+  DeltaEncoding<BallModel> delta;
 };
\ No newline at end of file
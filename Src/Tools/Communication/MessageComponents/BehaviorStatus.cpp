@@ -9,8 +9,11 @@ size_t BehaviorStatusComponent::compress(uint8_t* buff) {
     return byteOffset;
 }
 
-bool BehaviorStatusComponent::decompress(uint8_t* compressed) {
+bool BehaviorStatusComponent::decompress(uint8_t* compressed, size_t length) {
     size_t byteOffset = 0;
+    if (length < getSize()) {
+        return false;
+    }
     
     memcpy(&activity, compressed + byteOffset, sizeof(activity));
     byteOffset += sizeof(activity);
@@ -11,7 +11,7 @@ class BehaviorStatusComponent : public RobotMessageComponent<BehaviorStatusCompo
 
   size_t compress(uint8_t* buff);
 
-  bool decompress(uint8_t* compressed);
+  bool decompress(uint8_t* compressed, size_t length);
 
   size_t getSize();
 };
\ No newline at end of file
@@ -0,0 +1,172 @@
+/**
+ * @file DeltaEncoding.h
+ * @brief Bookkeeping for message components that are sent as changes against a keyframe.
+ *
+ * Every `keyframeInterval`-th time, and whenever a change cannot be encoded, a component sends its full
+ * state as a keyframe. In between, it only sends the difference to the last keyframe (or to a prediction
+ * from it). Each delta names the keyframe it refers to, so a receiver that missed that keyframe ignores
+ * deltas until the next keyframe arrives. Deltas never refer to other deltas, so losing one does not
+ * affect the following ones.
+ */
+
+#pragma once
+
+#include "Tools/Communication/RobotMessage.h"
+#include "Tools/Settings.h"
+#include <array>
+#include <cmath>
+#include <cstring>
+
+template<typename State>
+class DeltaEncoding {
+  public:
+  static constexpr unsigned keyframeInterval = 10; // A keyframe is sent at least every 10th time
+  static constexpr uint8_t keyframeFlag = 0x80; // Set in the first byte of keyframes. The other bits are the keyframe ID
+
+  struct Keyframe {
+    bool valid = false; // Was a keyframe sent / received?
+    uint8_t id = 0; // The ID of the keyframe
+    uint32_t timestamp = 0; // The header timestamp of the message that contained the keyframe
+    State state; // The state sent in the keyframe
+  };
+
+  RobotMessageHeader header; // The header of the message that is compiled or received
+  bool keyframe = true; // Is the state sent / received a keyframe?
+  bool resolved = false; // Receiver: Could the state be restored, i.e. was the referenced keyframe received?
+
+  /**
+   * @brief Sender: Sets the header of the message that is compiled and decides whether a keyframe is sent
+   *
+   * @param header
+   * @param encodable Can the current state be encoded as delta against the last keyframe sent?
+   */
+  void prepare(const RobotMessageHeader& header, bool encodable) {
+    this->header = header;
+    keyframe = !lastSent.valid || deltasSent + 1 >= keyframeInterval || !encodable;
+  }
+
+  /**
+   * @brief Sender: The keyframe deltas refer to
+   *
+   * @return const Keyframe&
+   */
+  const Keyframe& reference() const {
+    return lastSent;
+  }
+
+  /**
+   * @brief Sender: Writes the first byte of the component
+   *
+   * @param buff
+   * @return size_t number of bytes written
+   */
+  size_t writeTag(uint8_t* buff) const {
+    buff[0] = keyframe ? static_cast<uint8_t>(keyframeFlag | ((lastSent.id + 1) & ~keyframeFlag)) : lastSent.id;
+    return 1;
+  }
+
+  /**
+   * @brief Sender: Remembers the state if it was sent as keyframe
+   *
+   * @param state
+   */
+  void sent(const State& state) {
+    if (keyframe) {
+      lastSent.valid = true;
+      lastSent.id = (lastSent.id + 1) & ~keyframeFlag;
+      lastSent.timestamp = header.timestamp;
+      lastSent.state = state;
+      deltasSent = 0;
+    } else {
+      deltasSent++;
+    }
+  }
+
+  /**
+   * @brief Receiver: Reads the first byte of the component and looks up the keyframe a delta refers to
+   *
+   * @param compressed
+   * @return const Keyframe* The keyframe, or nullptr if the component is a keyframe or the keyframe was not received
+   */
+  const Keyframe* readTag(const uint8_t* compressed) {
+    keyframe = (compressed[0] & keyframeFlag) != 0;
+    resolved = keyframe;
+    if (keyframe || header.senderID < Settings::lowestValidPlayerNumber || header.senderID > Settings::highestValidPlayerNumber) {
+      return nullptr;
+    }
+    const Keyframe& reference = lastReceived[header.senderID - Settings::lowestValidPlayerNumber];
+    resolved = reference.valid && reference.id == compressed[0];
+    return resolved ? &reference : nullptr;
+  }
+
+  /**
+   * @brief Receiver: Remembers a keyframe received
+   *
+   * @param compressed The first byte of the component
+   * @param state The state restored from the keyframe
+   */
+  void received(const uint8_t* compressed, const State& state) {
+    if (keyframe && header.senderID >= Settings::lowestValidPlayerNumber && header.senderID <= Settings::highestValidPlayerNumber) {
+      Keyframe& received = lastReceived[header.senderID - Settings::lowestValidPlayerNumber];
+      received.valid = true;
+      received.id = compressed[0] & ~keyframeFlag;
+      received.timestamp = header.timestamp;
+      received.state = state;
+    }
+  }
+
+  /**
+   * @brief Quantizes a difference into 16 bits
+   *
+   * @param difference
+   * @param unit The value of one step
+   * @param quantized
+   * @return true if the difference is in range
+   */
+  static bool quantize(float difference, float unit, int16_t& quantized) {
+    const float steps = std::round(difference / unit);
+    if (!(std::abs(steps) <= 32767.f)) {
+      return false;
+    }
+    quantized = static_cast<int16_t>(steps);
+    return true;
+  }
+
+  /**
+   * @brief Writes a difference quantized by `quantize`. Differences out of range are clamped
+   * (and NaN is written as 0), but `prepare` should have been told to send a keyframe instead.
+   *
+   * @param buff
+   * @param difference
+   * @param unit
+   * @return size_t number of bytes written
+   */
+  static size_t writeDelta(uint8_t* buff, float difference, float unit) {
+    int16_t quantized = 0;
+    if (!quantize(difference, unit, quantized) && !std::isnan(difference)) {
+      quantized = difference > 0.f ? 32767 : -32767;
+    }
+    memcpy(buff, &quantized, sizeof(quantized));
+    return sizeof(quantized);
+  }
+
+  /**
+   * @brief Reads a difference written by `writeDelta`
+   *
+   * @param compressed
+   * @param unit
+   * @param difference
+   * @return size_t number of bytes read
+   */
+  static size_t readDelta(const uint8_t* compressed, float unit, float& difference) {
+    int16_t quantized;
+    memcpy(&quantized, compressed, sizeof(quantized));
+    difference = quantized * unit;
+    return sizeof(quantized);
+  }
+
+  private:
+  Keyframe lastSent; // Sender: The last keyframe sent
+  unsigned deltasSent = 0; // Sender: Number of deltas sent since the last keyframe
+  std::array<Keyframe, Settings::highestValidPlayerNumber - Settings::lowestValidPlayerNumber + 1> lastReceived; // Receiver: The last keyframe received from each player
+};
@@ -2,8 +2,16 @@
 
 
 size_t RobotPoseComponent::compress(uint8_t* buff) {
-    size_t byteOffset = 0;
-    
+    size_t byteOffset = delta.writeTag(buff);
+
+    if (!delta.keyframe) {
+        const Pose2f& reference = delta.reference().state;
+        byteOffset += delta.writeDelta(buff + byteOffset, pose.translation.x() - reference.translation.x(), translationUnit);
+        byteOffset += delta.writeDelta(buff + byteOffset, pose.translation.y() - reference.translation.y(), translationUnit);
+        byteOffset += delta.writeDelta(buff + byteOffset, Angle::normalize(pose.rotation - reference.rotation), rotationUnit);
+        return byteOffset;
+    }
+
     float x = pose.translation.x();
     float y = pose.translation.y();
 
@@ -18,9 +26,31 @@ size_t RobotPoseComponent::compress(uint8_t* buff) {
     return byteOffset;
 }
 
-bool RobotPoseComponent::decompress(uint8_t* compressed) {
-    size_t byteOffset = 0;
-    
+bool RobotPoseComponent::decompress(uint8_t* compressed, size_t length) {
+    if (length < 1) {
+        return false;
+    }
+    // The tag determines whether a keyframe or a delta follows and thereby the size
+    const DeltaEncoding<Pose2f>::Keyframe* reference = delta.readTag(compressed);
+    size_t byteOffset = 1;
+    if (length < getSize()) {
+        delta.resolved = false;
+        return false;
+    }
+
+    if (!delta.keyframe) {
+        float dx, dy, drot;
+        byteOffset += delta.readDelta(compressed + byteOffset, translationUnit, dx);
+        byteOffset += delta.readDelta(compressed + byteOffset, translationUnit, dy);
+        byteOffset += delta.readDelta(compressed + byteOffset, rotationUnit, drot);
+        if (reference) {
+            pose.translation.x() = reference->state.translation.x() + dx;
+            pose.translation.y() = reference->state.translation.y() + dy;
+            pose.rotation = Angle::normalize(reference->state.rotation + drot);
+        }
+        return byteOffset == getSize();
+    }
+
     float x;
     float y;
 
@@ -35,9 +65,31 @@ bool RobotPoseComponent::decompress(uint8_t* compressed) {
 
     memcpy(&pose.rotation, compressed + byteOffset, sizeof(Angle));
     byteOffset += sizeof(pose.rotation);
+
+    delta.received(compressed, pose);
     return byteOffset == getSize();
 }
 
 size_t RobotPoseComponent::getSize() {
-    return 12;
-}
\ No newline at end of file
+    return delta.keyframe ? 13 : 7;
+}
+
+void RobotPoseComponent::setHeader(const RobotMessageHeader& header) {
+    const Pose2f& reference = delta.reference().state;
+    int16_t quantized;
+    const bool encodable = delta.quantize(pose.translation.x() - reference.translation.x(), translationUnit, quantized)
+                           && delta.quantize(pose.translation.y() - reference.translation.y(), translationUnit, quantized)
+                           && delta.quantize(Angle::normalize(pose.rotation - reference.rotation), rotationUnit, quantized);
+    delta.prepare(header, encodable);
+}
+
+void RobotPoseComponent::sent() {
+    delta.sent(pose);
+}
+
+void RobotPoseComponent::doCallbacks(RobotMessageHeader& header) {
+    // A delta against a keyframe that was not received carries no usable pose
+    if (delta.resolved) {
+        RobotMessageComponent<RobotPoseComponent>::doCallbacks(header);
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Tools/Communication/RobotMessage.h"
+#include "Tools/Communication/MessageComponents/DeltaEncoding.h"
 #include "Tools/Math/Pose2f.h"
 
 class RobotPoseComponent : public RobotMessageComponent<RobotPoseComponent> {
@@ -9,11 +10,24 @@ class RobotPoseComponent : public RobotMessageComponent<RobotPoseComponent> {
 
   //Required
   inline static const std::string name = "RobotPose";
+  inline static const unsigned version = 1; // 1: Deltas against keyframes
   RobotPoseComponent() : RobotMessageComponent<RobotPoseComponent>() { }
 
   size_t compress(uint8_t* buff);
 
-  bool decompress(uint8_t* compressed);
+  bool decompress(uint8_t* compressed, size_t length);
 
   size_t getSize();
-};
\ No newline at end of file
+
+  void setHeader(const RobotMessageHeader& header);
+
+  void sent();
+
+  void doCallbacks(RobotMessageHeader& header);
+
+  private:
+  static constexpr float translationUnit = 1.f; // The resolution of translation deltas in mm
+  static constexpr float rotationUnit = pi / 32768.f; // The resolution of rotation deltas in radians
+
+  DeltaEncoding<Pose2f> delta; // Keyframe: 12 bytes pose, Delta: 3 * int16 against the keyframe
+};
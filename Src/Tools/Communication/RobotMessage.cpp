@@ -8,17 +8,35 @@
 
 bool idsAssigned = false;
 std::vector<ComponentMetadata> metadataById = std::vector<ComponentMetadata>();
-uint32_t messageVersionHash = 1337;
+uint32_t componentHash = 0; // Computed together with the IDs, see RobotMessage::getComponentHash()
+const unsigned maxStaleness = 10000; // Time in ms after which a component does not become more valuable by not being sent
+
+// FNV-1a over the bytes of a value
+static void addToHash(uint32_t& hash, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+}
 
 void assignComponentIDs() {
   
   int currentID = 0;
   metadataById.reserve(ComponentRegistry::subclasses.size());
 
+  // The layout of the message around the components is part of the wire format
+  componentHash = 2166136261u;
+  const uint32_t layout[] = {sizeof(RobotMessageHeader), COMPONENT_BITFIELD_SIZE, SPL_MAX_MESSAGE_BYTES};
+  addToHash(componentHash, layout, sizeof(layout));
+
   for (auto &subclass : ComponentRegistry::subclasses)
   {
     subclass.setID(currentID);
     metadataById.push_back(subclass);
+
+    // The names determine the IDs, i.e. the bits in the bitfield and the order of the components
+    addToHash(componentHash, subclass.name.c_str(), subclass.name.size() + 1);
+    addToHash(componentHash, &subclass.version, sizeof(subclass.version));
     
     currentID ++;
   }
@@ -34,7 +52,7 @@ size_t RobotMessage::compress(std::array<uint8_t, SPL_MAX_MESSAGE_BYTES>& outBuf
   // Sort Components by ID 
   struct IDSortPredicate 
   {
-    inline bool operator() (const std::shared_ptr<AbstractRobotMessageComponent>& a, const std::shared_ptr<AbstractRobotMessageComponent>& b)
+    inline bool operator() (AbstractRobotMessageComponent* a, AbstractRobotMessageComponent* b)
     {
       return a->getID() < b->getID();
     }
@@ -58,7 +76,7 @@ size_t RobotMessage::compress(std::array<uint8_t, SPL_MAX_MESSAGE_BYTES>& outBuf
   // COMPONENTS
   std::array<uint8_t, SPL_MAX_MESSAGE_BYTES> componentBuff; // buffer reused for component compression
 
-  for (auto component : componentPointers) {
+  for (AbstractRobotMessageComponent* component : componentPointers) {
 
     // compress component into componentBuff
     size_t len = component->compress(componentBuff.data()); // TODO: Memory safety needed! (Use std::span maybe?)
@@ -68,12 +86,21 @@ size_t RobotMessage::compress(std::array<uint8_t, SPL_MAX_MESSAGE_BYTES>& outBuf
     // Copy component into buffer
     memcpy(outBuff.data() + byteOffset, componentBuff.data(), len);
 
+    // Remember what was sent to value the component when compiling the next message
+    ComponentState& state = states[component->getID()];
+    state.sent = true;
+    state.lastSent = header.timestamp;
+    state.size = len;
+    memcpy(state.payload.data(), componentBuff.data(), len);
+
     // Adjust ByteOffset
     byteOffset += len;
 
     // set component bit in bitfield
     // offset is `bitfieldOffset * 8 + component->getID()`, as in the nth bit in the bitfield
     bitpacker::insert(outBuff, bitfieldOffset * 8 + component->getID(), 1, (uint8_t) 1);
+
+    component->sent();
   }
   
   return byteOffset;
@@ -90,31 +117,30 @@ bool RobotMessage::decompress(std::array<uint8_t, SPL_MAX_MESSAGE_BYTES>& buff){
   memcpy(&header, buff.data() + byteOffset, sizeof(header));
   byteOffset += sizeof(header);
 
+  componentPointers.clear();
+
   // Verify component hash
-  if(header.componentHash != messageVersionHash) {
+  if(header.componentHash != componentHash) {
     return false;
   }
 
-  // Read which components are included
-  std::list<int> includedComponents = std::list<int>(); // List of IDs of included components, 
-  for (int id = 0; id < ComponentRegistry::subclasses.size() ; id++)
-  {
-    bool included = (bool) bitpacker::extract<uint8_t>(buff, byteOffset * 8 + id, 1);
-    if(included) {
-      includedComponents.push_back(id);
-    }
-  }
+  const size_t bitfieldOffset = byteOffset;
   byteOffset += COMPONENT_BITFIELD_SIZE; 
 
-  
-
-  // decompress components
-  // `includedComponents` is inherently sorted from lowest to highest, so this is OK 
-  for (auto &componentID : includedComponents)
+  // decompress the included components in place
+  // IDs are visited from lowest to highest, which is the order in which they were compressed
+  for (int id = 0; id < static_cast<int>(metadataById.size()); id++)
   {
-    auto component = metadataById[componentID].createNew();
-    bool success = component->decompress(buff.data() + byteOffset); // TODO: Memory safety needed! (Use std::span maybe?)
-    if (!success) {
+    bool included = (bool) bitpacker::extract<uint8_t>(buff, bitfieldOffset * 8 + id, 1);
+    if(!included) {
+      continue;
+    }
+    AbstractRobotMessageComponent* component = getComponent(id);
+    component->setHeader(header);
+
+    // Components check that they fit into the rest of the message before reading their content
+    if (!component->decompress(buff.data() + byteOffset, buff.size() - byteOffset) || byteOffset + component->getSize() > buff.size()) {
+      componentPointers.clear();
       return false;
     }
     componentPointers.push_back(component);
@@ -129,46 +155,105 @@ void RobotMessage::compile() {
     assignComponentIDs();
   }
 
-  header.componentHash = 1337; //TODO: Generate and use hash
+  header.componentHash = componentHash;
   header.senderID = Global::getSettings().playerNumber;
   header.timestamp = Time::getCurrentSystemTime();
+  componentPointers.clear();
 
-  // Have a copy of the component metadata list. Thread-local for paralellism support
-  thread_local std::vector<ComponentMetadata> metadataByPriority(metadataById); // list for prioritization
+  const size_t capacity = SPL_MAX_MESSAGE_BYTES - sizeof(header) - COMPONENT_BITFIELD_SIZE; // Bytes available for components
 
-  // Sorts ComponenentMetadata by Component priority
-  struct PrioritySortPredicate {
-    inline bool operator() (const ComponentMetadata& a, const ComponentMetadata& b)
-    {
-      return *a.priority > *b.priority;
+  // Collect all components that should be sent and value them
+  candidates.clear();
+  std::array<uint8_t, SPL_MAX_MESSAGE_BYTES> payload;
+  for (int id = 0; id < static_cast<int>(metadataById.size()); id++) {
+
+    // Components with a priority 0 or lower are not compiled
+    const int priority = *metadataById[id].priority;
+    if (!(priority > 0)) {
+      continue;
     }
-  };
 
-  std::sort(metadataByPriority.begin(), metadataByPriority.end(), PrioritySortPredicate());
+    AbstractRobotMessageComponent* component = getComponent(id);
+    component->compileData();
+    component->setHeader(header);
+    const size_t size = component->getSize();
+    if (size > capacity) {
+      continue;
+    }
 
-  size_t bytesRemaining = 128; // Number of bytes remaining for the next component
-  bytesRemaining -= sizeof(header); // Reserve Header Space
-  bytesRemaining -= COMPONENT_BITFIELD_SIZE; // Reserve Component Bitfield
+    // Seconds since the component was sent, which saturates after `maxStaleness`
+    const ComponentState& state = states[id];
+    const unsigned staleness = state.sent ? std::min(header.timestamp - state.lastSent, maxStaleness) : maxStaleness;
+
+    // Ratio of bytes that changed since the component was sent
+    float changed = 1.f;
+    if (state.sent && state.size == size) {
+      component->compress(payload.data());
+      size_t changedBytes = 0;
+      for (size_t i = 0; i < size; i++) {
+        changedBytes += payload[i] != state.payload[i];
+      }
+      changed = size ? static_cast<float>(changedBytes) / size : 0.f;
+    }
 
-  for(auto metadata : metadataByPriority) {
+    candidates.push_back({component, size, priority * (1. + staleness / 1000.) * (1. + changed)});
+  }
 
-    // Components with a priority 0 or lower are not compiled
-    if(!(*metadata.priority > 0)) {
-      break;
+  // 0/1 knapsack over the bytes available
+  bestValues.assign(capacity + 1, 0.);
+  taken.assign(candidates.size() * (capacity + 1), 0);
+  for (size_t i = 0; i < candidates.size(); i++) {
+    const Candidate& candidate = candidates[i];
+    uint8_t* takenForBytes = taken.data() + i * (capacity + 1);
+    for (size_t bytes = capacity + 1; bytes-- > candidate.size;) {
+      const double value = bestValues[bytes - candidate.size] + candidate.value;
+      if (value > bestValues[bytes]) {
+        bestValues[bytes] = value;
+        takenForBytes[bytes] = 1;
+      }
     }
+  }
 
-    auto component = metadata.createNew();
-    component->compileData();
-    int size = component->getSize();
-    if (size <= bytesRemaining) {
-      bytesRemaining -= size;
-      componentPointers.push_back(component);
-    } else {
-      // Log which component we stopped at & which ones were left out
-      break;
+  // Collect the components taken for the best value
+  size_t bytes = capacity;
+  for (size_t i = candidates.size(); i--;) {
+    if (taken[i * (capacity + 1) + bytes]) {
+      componentPointers.push_back(candidates[i].component);
+      bytes -= candidates[i].size;
     }
   }
 }
 
+size_t RobotMessage::getNumberOfComponents() {
+  if (!idsAssigned) {
+    assignComponentIDs();
+  }
+  return metadataById.size();
+}
+
+uint32_t RobotMessage::getComponentHash() {
+  if (!idsAssigned) {
+    assignComponentIDs();
+  }
+  return componentHash;
+}
 
+const std::string& RobotMessage::getComponentName(int id) {
+  if (!idsAssigned) {
+    assignComponentIDs();
+  }
+  return metadataById[id].name;
+}
 
+AbstractRobotMessageComponent* RobotMessage::getComponent(int id) {
+  if (components.empty()) {
+    components.resize(metadataById.size());
+    states.resize(metadataById.size());
+    candidates.reserve(metadataById.size());
+    componentPointers.reserve(metadataById.size());
+  }
+  if (!components[id]) {
+    components[id] = metadataById[id].createNew();
+  }
+  return components[id].get();
+}
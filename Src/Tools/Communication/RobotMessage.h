@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 #include <vector>
 #include <map>
@@ -27,7 +28,7 @@ using namespace std::placeholders;
 #define COMPONENT_BITFIELD_SIZE 4
 
 struct RobotMessageHeader {
-  uint32_t componentHash = 1337; // Temporary     
+  uint32_t componentHash = 0; // Identifies the wire format, see RobotMessage::getComponentHash()
   uint16_t senderID;
   uint32_t timestamp;
 };
@@ -42,17 +43,39 @@ struct AbstractRobotMessageComponent {
   virtual ~AbstractRobotMessageComponent() = default;
 
   virtual size_t compress(uint8_t* buff) = 0;
-  virtual bool decompress(uint8_t* compressed) = 0;
+  /**
+   * @brief Restores the component from a received message. Must not read more than `length` bytes.
+   * 
+   * @param compressed The beginning of the component in the message
+   * @param length The number of bytes left in the message
+   * @return false if the component is malformed or does not fit into `length` bytes
+   */
+  virtual bool decompress(uint8_t* compressed, size_t length) = 0;
   virtual void doCallbacks(RobotMessageHeader& header) = 0;
   virtual void compileData() = 0;
   virtual size_t getSize() = 0;
   virtual int getID() = 0;
+
+  /**
+   * @brief Passes the header of the message to the component. Is called after compileData() when a
+   * message is compiled and before decompress() when a message is received.
+   * 
+   * @param header 
+   */
+  virtual void setHeader(const RobotMessageHeader& header) {}
+
+  /**
+   * @brief Is called after the component was compressed into a message that is sent
+   * 
+   */
+  virtual void sent() {}
 };
 
 struct ComponentMetadata {
   std::string name;
-  std::shared_ptr<AbstractRobotMessageComponent> (*createNew)();
+  std::unique_ptr<AbstractRobotMessageComponent> (*createNew)();
   int* priority;
+  unsigned version;
   void (*setID)(int);
 
   bool operator<(const ComponentMetadata& b) const {
@@ -82,6 +105,9 @@ class RobotMessageComponent : public AbstractRobotMessageComponent {
 
   inline static int priority = 0;
 
+  // The version of the encoding of the component. A component must increase it whenever its encoding changes.
+  inline static const unsigned version = 0;
+
   void doCallbacks(RobotMessageHeader& header) {
     onRecieve.call(static_cast<T *>(this), header);
   }
@@ -90,8 +116,8 @@ class RobotMessageComponent : public AbstractRobotMessageComponent {
     onCompile.call(static_cast<T *>(this));
   }
 
-  static std::shared_ptr<AbstractRobotMessageComponent> create() {
-    return std::shared_ptr<AbstractRobotMessageComponent>(new T());
+  static std::unique_ptr<AbstractRobotMessageComponent> create() {
+    return std::make_unique<T>();
   }
 
   int getID() final {
@@ -118,14 +144,14 @@ class RobotMessageComponent : public AbstractRobotMessageComponent {
 
 // registry must be defined out of class so T can exist before registry is set
 template<typename T>
-volatile ComponentRegistry RobotMessageComponent<T>::registry = ComponentRegistry(ComponentMetadata{T::name, T::create, &T::priority, T::setID});
+volatile ComponentRegistry RobotMessageComponent<T>::registry = ComponentRegistry(ComponentMetadata{T::name, T::create, &T::priority, T::version, T::setID});
 
 class RobotMessage
 {
 
   public:
   RobotMessageHeader header; 
-  std::vector<std::shared_ptr<AbstractRobotMessageComponent>> componentPointers;  // Pointers to the included components. With smart pointers we don't need to worry about deleting them!
+  std::vector<AbstractRobotMessageComponent*> componentPointers;  // Pointers to the included components. They point into `components`, so a message should be reused rather than recreated.
   inline thread_local static CallbackRegistry<std::function<void(RobotMessageHeader&)>> onRecieve = CallbackRegistry<std::function<void(RobotMessageHeader&)>>();
 
     /**
@@ -156,11 +182,66 @@ class RobotMessage
     }
 
     
+    /**
+     * @brief Fills the message with the most valuable subset of components that fits into a packet.
+     * The value of a component grows with its priority, the time since it was last sent and how much its
+     * payload changed since then. Components with a priority of 0 or lower are never sent.
+     * Previously included components are removed first.
+     * 
+     */
     void compile();
 
     /**
-     * @brief size, in bytes of the compressed packet
+     * @brief Number of registered component types, i.e. the range of component IDs
      * 
      * @return size_t 
      */
+    static size_t getNumberOfComponents();
+
+    /**
+     * @brief The name of a component type
+     * 
+     * @param id The ID of the component
+     * @return const std::string& 
+     */
+    static const std::string& getComponentName(int id);
+
+    /**
+     * @brief Identifies the wire format of all components. It is computed from the names of the registered
+     * components in the order of their IDs, their versions and the layout of the header and the bitfield.
+     * Received messages with another hash are rejected.
+     * 
+     * @return uint32_t 
+     */
+    static uint32_t getComponentHash();
+
+  private:
+    // What is remembered about a component type to value it when packing the next message
+    struct ComponentState {
+      bool sent = false; // Was the component sent before?
+      unsigned lastSent = 0; // When was the component sent the last time?
+      size_t size = 0; // Size of the payload sent the last time
+      std::array<uint8_t, SPL_MAX_MESSAGE_BYTES> payload; // The payload sent the last time
+    };
+
+    // A component that could be included in the message that is compiled
+    struct Candidate {
+      AbstractRobotMessageComponent* component;
+      size_t size;
+      double value;
+    };
+
+    std::vector<std::unique_ptr<AbstractRobotMessageComponent>> components; // One object per component ID that is reused by every compile() / decompress()
+    std::vector<ComponentState> states; // The state of each component ID
+    std::vector<Candidate> candidates; // Reused by compile()
+    std::vector<double> bestValues; // Reused by compile(): best value for each number of bytes
+    std::vector<uint8_t> taken; // Reused by compile(): was a candidate taken for the best value for a number of bytes?
+
+    /**
+     * @brief Returns the reusable object of a component. It is created on first use.
+     * 
+     * @param id The ID of the component
+     * @return AbstractRobotMessageComponent* 
+     */
+    AbstractRobotMessageComponent* getComponent(int id);
 };
\ No newline at end of file
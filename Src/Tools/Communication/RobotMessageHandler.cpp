@@ -19,6 +19,7 @@
 #include "Tools/Debugging/DebugDrawings.h"
 
 // Message Errors
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 
@@ -67,9 +68,8 @@ void RobotMessageHandler::send()
   if(!port)
     return;
 
-  RobotMessage msg = RobotMessage();
-  msg.compile();
-  size_t size = msg.compress(writeBuffer);
+  outgoing.compile();
+  size_t size = outgoing.compress(writeBuffer);
 
   bool success = socket.write((char*) writeBuffer.data(), SPL_MAX_MESSAGE_BYTES); // Guarantees 128 bytes are sent
 
@@ -81,6 +81,30 @@ void RobotMessageHandler::send()
   // Plot usage of data buffer in percent:
   const float usageInPercent = 100.f * size / SPL_MAX_MESSAGE_BYTES;
   PLOT("module:RobotMessageHandler:messageDataUsageInPercent", usageInPercent);
+
+  // Plot usage and send rate per component
+  if(statistics.empty())
+  {
+    statistics.resize(RobotMessage::getNumberOfComponents());
+    for(size_t id = 0; id < statistics.size(); ++id)
+    {
+      statistics[id].usagePlot = "plot:module:RobotMessageHandler:messageDataUsageInPercent:" + RobotMessage::getComponentName(static_cast<int>(id));
+      statistics[id].sendRatePlot = "plot:module:RobotMessageHandler:sendRateInPercent:" + RobotMessage::getComponentName(static_cast<int>(id));
+    }
+  }
+  std::array<int, 8 * COMPONENT_BITFIELD_SIZE> sentBytes;
+  sentBytes.fill(-1);
+  for(AbstractRobotMessageComponent* component : outgoing.componentPointers)
+    sentBytes[component->getID()] = static_cast<int>(component->getSize());
+  for(size_t id = 0; id < statistics.size(); ++id)
+  {
+    ComponentStatistics& stats = statistics[id];
+    stats.sendRate += ((sentBytes[id] >= 0 ? 100.f : 0.f) - stats.sendRate) * 0.1f;
+    DEBUG_RESPONSE(stats.usagePlot.c_str())
+      OUTPUT(idPlot, bin, (stats.usagePlot.c_str() + 5) << 100.f * std::max(sentBytes[id], 0) / SPL_MAX_MESSAGE_BYTES);
+    DEBUG_RESPONSE(stats.sendRatePlot.c_str())
+      OUTPUT(idPlot, bin, (stats.sendRatePlot.c_str() + 5) << stats.sendRate);
+  }
   //OUTPUT_TEXT("Percent: " << usageInPercent);
 }
 
@@ -110,17 +134,16 @@ void RobotMessageHandler::receive()
       break;
     }
 
-    RobotMessage msg;
-    if (!msg.decompress(readBuffer)) { // Decompress failed 
+    if (!incoming.decompress(readBuffer)) { // Decompress failed 
       OUTPUT_TEXT("Error parsing message");
       continue; // Skip this Message
     }
 
-    if (msg.header.senderID == Global::getSettings().playerNumber) { // Message came from myself! 
+    if (incoming.header.senderID == Global::getSettings().playerNumber) { // Message came from myself! 
       continue; // Skip this Message
     }
 
-    msg.doCallbacks();
+    incoming.doCallbacks();
 
   } while(size > 0);
 }
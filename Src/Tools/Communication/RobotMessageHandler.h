@@ -13,8 +13,6 @@
 
 #pragma once
 
-#include <queue>
-
 #include "Tools/Communication/UdpComm.h"
 #include "Tools/Communication/RoboCupGameControlData.h"
 #include "RobotMessage.h"
@@ -56,9 +54,19 @@ public:
   void receive();
 
 private:
+  /** Statistics about how often a component type is sent. */
+  struct ComponentStatistics
+  {
+    std::string usagePlot; /**< The debug request of the plot of the share of the packet used by the component. */
+    std::string sendRatePlot; /**< The debug request of the plot of the send rate. */
+    float sendRate = 0.f; /**< The percentage of recent packets that included the component (exponentially averaged). */
+  };
+
+  std::vector<ComponentStatistics> statistics; /**< The statistics of each component type by ID. */
   std::array<uint8_t, SPL_MAX_MESSAGE_BYTES> readBuffer;
   std::array<uint8_t, SPL_MAX_MESSAGE_BYTES> writeBuffer;
-  std::queue<RobotMessage> incoming; /**< Incoming messages are stored here. */
+  RobotMessage outgoing; /**< The message that is sent. It is reused to avoid allocations. */
+  RobotMessage incoming; /**< The message incoming packets are decompressed into. It is reused to avoid allocations. */
   int port = 0; /**< The UDP port this handler is listening to. */
   UdpComm socket; /**< The socket used to communicate. */
   unsigned localId = 0; /**< The id of a local team communication participant or 0 for normal udp communication. */
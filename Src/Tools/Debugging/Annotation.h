@@ -23,6 +23,7 @@
 #define ANNOTATION(name, message) \
   do \
   { \
+    std::lock_guard<std::mutex> _annotationLock(Global::getAnnotationManager().mutex); \
     Global::getAnnotationManager().addAnnotation(); \
     Global::getAnnotationManager().getOut().out.text << name << message; \
     Global::getAnnotationManager().getOut().out.finishMessage(idAnnotation); \
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "Tools/MessageQueue/MessageQueue.h"
+#include <mutex>
 
 class AnnotationManager final
 {
@@ -19,6 +20,8 @@ public:
   void addAnnotation();
   MessageQueue& getOut();
 
+  std::mutex mutex; /**< Annotations can be added by providers that are executed in parallel. */
+
 private:
   MessageQueue outData;
   unsigned annotationCounter = 0;
@@ -11,6 +11,7 @@
 
 void DrawingManager::addDrawingId(const char* name, const char* typeName)
 {
+  std::lock_guard<std::mutex> lock(mutex);
   if(drawings.find(name) == drawings.end())
   {
     char id = static_cast<char>(drawings.size());
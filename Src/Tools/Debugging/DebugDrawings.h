@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 
 #include "Tools/Debugging/ColorRGBA.h"
@@ -58,6 +59,7 @@ public:
   const char* getString(const std::string& string);
 
   std::unordered_map<const char*, Drawing> drawings;
+  std::mutex mutex; /**< Drawings can be declared by providers that are executed in parallel. */
 
 private:
   const char* getTypeName(char id) const;
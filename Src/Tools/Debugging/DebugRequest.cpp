@@ -46,6 +46,8 @@ void DebugRequestTable::addRequest(const DebugRequest& debugRequest)
 bool DebugRequestTable::isActiveSlow(const char* name)
 {
   std::unordered_map<std::string, size_t>::const_iterator j = slowIndex.find(name);
+  if(shared)
+    return j != slowIndex.end() && enabled[j->second] != 0;
   size_t k;
   if(j != slowIndex.end())
     k = j->second;
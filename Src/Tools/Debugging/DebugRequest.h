@@ -11,6 +11,7 @@
 #pragma once
 
 #include "Tools/Streams/AutoStreamable.h"
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -56,6 +57,7 @@ private:
 
 public:
   int pollCounter = 0; /**< How many frames is polling still active? */
+  bool shared = false; /**< Is the table currently used by several threads? Then, lookups do not update the indices. */
 
   /** Constructor. */
   DebugRequestTable();
@@ -94,6 +96,16 @@ public:
   /** Clear the table. */
   void clear();
 
+  /**
+   * Are any requests enabled or is polling active?
+   * If not, no debug output is generated.
+   * @return Could debug output be generated?
+   */
+  bool hasActiveRequests() const
+  {
+    return pollCounter > 0 || std::find(enabled.begin(), enabled.end(), 1) != enabled.end();
+  }
+
   /**
    * Prints a message to stderr.
    * @param message The error to print.
@@ -9,24 +9,33 @@
 #pragma once
 
 #include "TimingManager.h"
+#include "Tracer.h"
 #include "Debugging.h"
 
-/** A stopwatch that measures the time an instance of it lives and plots it. */
+/** A stopwatch that measures the time an instance of it lives, plots it, and traces it. */
 class Stopwatch
 {
   const char* const name; /**< The name of the plot. */
+  const Tracer::Category category; /**< The category under which the stopwatch is traced. */
+  const unsigned long long begin = Tracer::now(); /**< When was the stopwatch started (for the tracer)? */
   bool running = true; /**< Should the stopwatch still be running? */
 
 public:
   /**
    * Start the stopwatch.
    * @param name The name of the plot.
+   * @param category The category under which the stopwatch is traced.
    */
-  Stopwatch(const char* name) : name(name) {Global::getTimingManager().startTiming(name + 15);}
+  Stopwatch(const char* name, Tracer::Category category = Tracer::stopwatch) :
+    name(name), category(category)
+  {
+    Global::getTimingManager().startTiming(name + 15);
+  }
 
   /** Stop the stopwatch.*/
   ~Stopwatch()
   {
+    Tracer::record(name + 15, category, begin);
 #ifndef TARGET_TOOL
     const unsigned time = Global::getTimingManager().stopTiming(name + 15);
 #else
@@ -6,6 +6,7 @@
  */
 
 #include "TimingManager.h"
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include "Platform/BHAssert.h"
@@ -36,6 +37,7 @@ struct TimingManager::Pimpl
   MessageQueue data; /**< Contains the timing data in streamable format inbetween frames */
   bool dataPrepared = false; /**< True if data hs already been prepared this frame */
   int watchNameIndex = 0; /**< Every frame a few watch names are transmitted. This is the index of the watchname that is to be transmitted next */
+  std::mutex mutex; /**< Stopwatches can be used by providers that are executed in parallel. */
 };
 
 TimingManager::TimingManager() : prvt(new TimingManager::Pimpl)
@@ -50,6 +52,7 @@ TimingManager::~TimingManager()
 
 void TimingManager::startTiming(const char* identifier)
 {
+  std::lock_guard<std::mutex> lock(prvt->mutex);
   auto timing = prvt->timing.find(identifier);
   if(timing == prvt->timing.end())
   {
@@ -65,6 +68,7 @@ void TimingManager::startTiming(const char* identifier)
 unsigned TimingManager::stopTiming(const char* identifier)
 {
   const unsigned long long stopTime = Time::getCurrentThreadTime();
+  std::lock_guard<std::mutex> lock(prvt->mutex);
   auto timing = prvt->timing.find(identifier);
   const unsigned diff = unsigned(stopTime - timing->second);
   timing->second = diff;
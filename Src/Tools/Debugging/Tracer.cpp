@@ -0,0 +1,245 @@
+/**
+ * @file Tracer.cpp
+ *
+ * This file implements the tracer. Every thread owns a ring buffer of
+ * events that only this thread writes to. Each slot of the buffer is a
+ * sequence lock: it is tagged with the index of the event it contains, the
+ * tag is cleared while the slot is rewritten, and all fields are atomic.
+ * Therefore, a dump from another thread can read the slots while the
+ * thread keeps writing and drops the events that changed while they were
+ * copied. A mutex is only used when a thread registers or unregisters its
+ * buffer and while dumping. Dumps are written by a low priority thread.
+ */
+
+#include "Tracer.h"
+#include "Platform/BHAssert.h"
+#include "Platform/File.h"
+#include "Platform/Semaphore.h"
+#include "Platform/Thread.h"
+#include "Tools/Debugging/Debugging.h"
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Tracer
+{
+  /** An event copied from a ring buffer. */
+  struct Event
+  {
+    const char* name; /**< The name of the event. */
+    unsigned long long begin; /**< When did the event begin (in µs)? */
+    unsigned long long end; /**< When did the event end (in µs)? */
+    Category category; /**< The category of the event. */
+  };
+
+  /** A slot of a ring buffer. It can be read while it is written. */
+  struct Slot
+  {
+    std::atomic<size_t> tag{0}; /**< 1 + the index of the event in this slot or 0 while it is written. */
+    std::atomic<const char*> name{nullptr}; /**< The name of the event. */
+    std::atomic<unsigned long long> begin{0}; /**< When did the event begin (in µs)? */
+    std::atomic<unsigned long long> end{0}; /**< When did the event end (in µs)? */
+    std::atomic<Category> category{provider}; /**< The category of the event. */
+  };
+
+  /** The ring buffer of a single thread. */
+  struct Buffer
+  {
+    static constexpr size_t size = 4096; /**< The number of events per thread. Must be a power of 2. */
+    Slot events[size]; /**< The events. The oldest will be overwritten. */
+    std::atomic<size_t> written{0}; /**< The number of events written so far. */
+    std::string threadName; /**< The name of the thread shown in the trace. */
+    unsigned id; /**< The id of the thread in the trace. */
+  };
+
+  static std::mutex mutex; /**< Protects the list of buffers. */
+  static std::list<Buffer*> buffers; /**< The buffers of all threads that exist. */
+  static unsigned nextId = 1; /**< The next thread id used in traces. */
+
+  /** Registers the buffer of a thread while the thread exists. */
+  struct Registration
+  {
+    std::unique_ptr<Buffer> buffer = std::make_unique<Buffer>();
+
+    Registration()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      buffer->id = nextId++;
+      buffer->threadName = "Thread " + std::to_string(buffer->id);
+      buffers.push_back(buffer.get());
+    }
+
+    ~Registration()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      buffers.remove(buffer.get());
+    }
+  };
+
+  /**
+   * Returns the buffer of the calling thread. It is created on first use.
+   * @return The buffer.
+   */
+  static Buffer& getBuffer()
+  {
+    thread_local Registration registration;
+    return *registration.buffer;
+  }
+
+  unsigned long long now()
+  {
+    return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                             std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  void record(const char* name, Category category, unsigned long long begin)
+  {
+    Buffer& buffer = getBuffer();
+    const size_t written = buffer.written.load(std::memory_order_relaxed);
+    Slot& slot = buffer.events[written & (Buffer::size - 1)];
+    slot.tag.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.end.store(now(), std::memory_order_relaxed);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.tag.store(written + 1, std::memory_order_release);
+    buffer.written.store(written + 1, std::memory_order_release);
+  }
+
+  void setThreadName(const std::string& name)
+  {
+    Buffer& buffer = getBuffer();
+    std::lock_guard<std::mutex> lock(mutex);
+    buffer.threadName = name;
+  }
+
+  /**
+   * Writes a string as a JSON string literal.
+   * @param file The file to write to.
+   * @param string The string.
+   */
+  static void writeString(File& file, const char* string)
+  {
+    std::string escaped = "\"";
+    for(; *string; ++string)
+      if(*string == '"' || *string == '\\')
+        (escaped += '\\') += *string;
+      else if(static_cast<unsigned char>(*string) >= ' ')
+        escaped += *string;
+    escaped += '"';
+    file.write(escaped.c_str(), escaped.size());
+  }
+
+  bool dump(const std::string& filename)
+  {
+    File file(filename, "w", false);
+    if(!file.exists())
+      return false;
+
+    static const char* categories[] = {"provider", "stopwatch"};
+    std::vector<Event> events;
+    std::lock_guard<std::mutex> lock(mutex);
+    file.printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for(const Buffer* buffer : buffers)
+    {
+      file.printf("%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", buffer->id);
+      writeString(file, buffer->threadName.c_str());
+      file.printf("}}");
+      first = false;
+
+      // Copy the events and drop all that the thread rewrote while they were copied.
+      const size_t end = buffer->written.load(std::memory_order_acquire);
+      events.clear();
+      for(size_t i = end > Buffer::size ? end - Buffer::size : 0; i < end; ++i)
+      {
+        const Slot& slot = buffer->events[i & (Buffer::size - 1)];
+        if(slot.tag.load(std::memory_order_acquire) != i + 1)
+          continue;
+        const Event event = {slot.name.load(std::memory_order_relaxed), slot.begin.load(std::memory_order_relaxed),
+                             slot.end.load(std::memory_order_relaxed), slot.category.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.tag.load(std::memory_order_relaxed) == i + 1)
+          events.push_back(event);
+      }
+      for(const Event& event : events)
+      {
+        ASSERT(event.category < sizeof(categories) / sizeof(*categories));
+        file.printf(",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%llu,\"cat\":\"%s\",\"name\":",
+                    buffer->id, event.begin, event.end - event.begin, categories[event.category]);
+        writeString(file, event.name);
+        file.printf("}");
+      }
+    }
+    file.printf("\n]}\n");
+    return true;
+  }
+
+  /** A low priority thread that writes the dumps requested. */
+  class Writer
+  {
+  private:
+    Thread thread; /**< The thread that writes the dumps. */
+    Semaphore requested; /**< Signals that a dump was requested or that the thread should stop. */
+    std::mutex mutex; /**< Protects the filename. */
+    std::string filename; /**< The file the requested dump is written to. Empty if none is pending. */
+
+    /** The main function of the thread. */
+    void write()
+    {
+      Thread::nameCurrentThread("TraceWriter");
+      while(requested.wait() && thread.isRunning())
+      {
+        std::string filename;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          filename.swap(this->filename);
+        }
+        if(!filename.empty() && !dump(filename))
+          OUTPUT_WARNING("Could not write " << filename);
+      }
+    }
+
+  public:
+    /** The constructor starts the thread with the batch scheduler. */
+    Writer() : thread(-1)
+    {
+      thread.start(this, &Writer::write);
+    }
+
+    /** The destructor stops the thread. */
+    ~Writer()
+    {
+      thread.announceStop();
+      requested.post();
+      thread.stop();
+    }
+
+    /**
+     * Requests a dump.
+     * @param filename The name of the file.
+     * @return Was the request accepted, i.e. was no other dump pending?
+     */
+    bool request(const std::string& filename)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!this->filename.empty())
+          return false;
+        this->filename = filename;
+      }
+      requested.post();
+      return true;
+    }
+  };
+
+  bool requestDump(const std::string& filename)
+  {
+    static Writer writer;
+    return writer.request(filename);
+  }
+}
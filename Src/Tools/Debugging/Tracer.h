@@ -0,0 +1,64 @@
+/**
+ * @file Tracer.h
+ *
+ * This file declares a tracer that records when providers and stopwatches
+ * start and end. Each thread writes into its own ring buffer without locking.
+ * The recent history of all threads can be written as a trace file in the
+ * Chrome trace event format, which can be opened in chrome://tracing or
+ * https://ui.perfetto.dev.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace Tracer
+{
+  /** The categories of recorded events. */
+  enum Category : unsigned char
+  {
+    provider, /**< The execution of a provider. */
+    stopwatch, /**< The scope of a STOPWATCH. */
+  };
+
+  /**
+   * Returns the current time for tracing.
+   * @return A monotonic time in microseconds.
+   */
+  unsigned long long now();
+
+  /**
+   * Records an event that ends now in the ring buffer of the calling thread.
+   * @param name The name of the event. It must outlive the tracer, i.e. it is
+   *             usually a string literal.
+   * @param category The category of the event.
+   * @param begin The time when the event began (from now()).
+   */
+  void record(const char* name, Category category, unsigned long long begin);
+
+  /**
+   * Sets the name under which the events of the calling thread appear in the trace.
+   * @param name The name of the thread.
+   */
+  void setThreadName(const std::string& name);
+
+  /**
+   * Writes the events currently in the ring buffers of all threads to a file.
+   * @param filename The name of the file. Relative names are relative to the
+   *                 configuration directory.
+   * @return Could the file be written?
+   */
+  bool dump(const std::string& filename);
+
+  /**
+   * Lets a low priority thread write the events currently in the ring
+   * buffers of all threads to a file. The ring buffers keep more than a
+   * second of history, so the delay until the dump is written does not
+   * lose the events of interest.
+   * @param filename The name of the file. Relative names are relative to
+   *                 the configuration directory.
+   * @return Was the request accepted? It is rejected while another dump is
+   *         still pending.
+   */
+  bool requestDump(const std::string& filename);
+}
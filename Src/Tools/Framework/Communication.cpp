@@ -12,7 +12,7 @@
 
 bool DebugSenderBase::terminating = false;
 
-void ReceiverBase::setPacket(void* p)
+int ReceiverBase::reserveSlot() const
 {
   int writing = 0;
   if(writing == actual)
@@ -22,9 +22,12 @@ void ReceiverBase::setPacket(void* p)
       ++writing;
   ASSERT(writing != actual);
   ASSERT(writing != reading);
-  if(packet[writing])
-    std::free(packet[writing]);
-  packet[writing] = p;
+  return writing;
+}
+
+void ReceiverBase::publishSlot(int writing)
+{
+  pending[writing] = true;
   actual = writing;
   thread->trigger();
 }
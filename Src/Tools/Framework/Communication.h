@@ -13,7 +13,7 @@
 #include "Platform/Thread.h"
 #include "Tools/Streams/OutStreams.h"
 #include "Tools/Streams/InStreams.h"
-#include <cstdlib>
+#include <algorithm>
 
 class ThreadFrame;
 
@@ -26,6 +26,8 @@ namespace Communication
   static const std::string dummy("Dummy");
 }
 
+template<typename PacketType> class Sender;
+
 /**
  * @class ReceiverBase
  *
@@ -38,7 +40,7 @@ public:
 
 protected:
   ThreadFrame* thread;   /**< The thread this receiver is associated with. */
-  void* packet[3];           /**< A triple buffer for received packets. */
+  volatile bool pending[3] = {false, false, false}; /**< Which of the triple buffer slots contain unprocessed packets? */
   volatile int reading = 0;   /**< Index of packet reserved for reading. */
   volatile int actual = 0;    /**< Index of packet that is the most actual. */
 
@@ -50,31 +52,32 @@ public:
    */
   ReceiverBase(ThreadFrame* thread, const std::string& senderThreadName) :
     senderThreadName(senderThreadName), thread(thread)
-  {
-    for(int i = 0; i < 3; ++i)
-      packet[i] = 0;
-  }
+  {}
 
-  virtual ~ReceiverBase()
-  {
-    for(int i = 0; i < 3; ++i)
-      if(packet[i])
-        std::free(packet[i]);
-  }
+  virtual ~ReceiverBase() = default;
 
   /**
-   * The function sets the packet.
+   * The function determines whether the receiver has a pending packet.
    *
-   * @param p The packet.
+   * @return Is there still an unprocessed packet?
    */
-  void setPacket(void* p);
+  bool hasPendingPacket() const { return pending[actual]; }
 
+protected:
   /**
-   * The function determines whether the receiver has a pending packet.
+   * The function selects the slot the next packet can be written to.
+   * It is neither the most actual slot nor the one currently being read.
    *
-   * @return Is there still an unprocessed packet?
+   * @return The index of the slot.
    */
-  bool hasPendingPacket() const { return packet[actual] != 0; }
+  int reserveSlot() const;
+
+  /**
+   * The function marks a slot as the most actual one and notifies the thread.
+   *
+   * @param writing The index of the slot that was filled.
+   */
+  void publishSlot(int writing);
 };
 
 /**
@@ -86,6 +89,19 @@ public:
 template<typename PacketType>
 class Receiver : public ReceiverBase, public PacketType
 {
+private:
+  static constexpr size_t minSlotCapacity = 16384; /**< Slots are never shrunk below this size. */
+
+  /**
+   * A triple buffer of slots for received packets. They are allocated once
+   * and reused, i.e. they keep the memory they have grown to. However, if a
+   * slot has grown far beyond the size of the packets it currently carries,
+   * e.g. because of a single large debug message, its memory is reduced again.
+   */
+  OutBinaryMemory slots[3];
+
+  friend class Sender<PacketType>; /**< The sender fills the slots. */
+
 public:
   /**
    * The constructor.
@@ -101,13 +117,16 @@ public:
   void checkForPacket()
   {
     reading = actual;
-    if(packet[reading])
+    if(pending[reading])
     {
       PacketType& data = *static_cast<PacketType*>(this);
-      InBinaryMemory memory(packet[reading]);
+      OutBinaryMemory& slot = slots[reading];
+      InBinaryMemory memory(slot.data());
       memory >> data;
-      std::free(packet[reading]);
-      packet[reading] = 0;
+      const size_t used = std::max(minSlotCapacity, slot.size());
+      if(slot.capacity() > used * 4)
+        slot.shrink(used * 2);
+      pending[reading] = false;
     }
   }
 };
@@ -171,9 +190,11 @@ public:
     if(receiverThreadName == Communication::dummy)
       return;
     const PacketType& data = *static_cast<const PacketType*>(this);
-    OutBinaryMemory stream(16384);
+    const int writing = receiver.reserveSlot();
+    OutBinaryMemory& stream = receiver.slots[writing];
+    stream.clear();
     stream << data;
-    receiver.setPacket(stream.obtainData());
+    receiver.publishSlot(writing);
   }
 
   /**
@@ -201,6 +222,8 @@ protected:
   static bool terminating; /**< Is the current thread terminating? */
 
   friend class RoboCupCtrl; /**< RoboCupCtrl will set this flag. */
+  friend class LogReplayer; /**< LogReplayer will set this flag. */
+  friend class Match; /**< Match will set this flag. */
 };
 
 /**
@@ -50,6 +50,8 @@ STREAMABLE(Configuration,
 
     (std::string) name,
     (int)(0) priority,
+    (unsigned)(0) workers, /**< The number of additional threads that execute independent providers in parallel. 0 executes all providers sequentially. */
+    (unsigned)(0) frameBudget, /**< If executing all modules takes longer than this (in ms), a trace is dumped. 0 disables this. */
     (unsigned)(0) debugReceiverSize, /**< The maximum size of the queue in Bytes. */
     (unsigned)(0) debugSenderSize, /**< The maximum size of the queue in Bytes. */
     (unsigned)(0) debugSenderInfrastructureSize,
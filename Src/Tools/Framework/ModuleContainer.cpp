@@ -10,6 +10,7 @@
 #include "Platform/SystemCall.h"
 #include "Platform/Time.h"
 #include "Threads/Debug.h"
+#include "Tools/Debugging/Tracer.h"
 #include "Tools/Framework/FrameExecutionUnit.h"
 #include "Tools/Logging/Logger.h"
 #include "Tools/Math/Constants.h"
@@ -22,8 +23,9 @@ ModuleContainer::ModuleContainer(const Settings& settings, const std::string& ro
   ThreadFrame(settings, robotName),
   name(config()[index].name),
   priority(config()[index].priority),
-  moduleGraphRunner(config().size()),
-  logger(logger)
+  moduleGraphRunner(config().size(), config()[index].workers, config()[index].priority),
+  logger(logger),
+  frameBudget(config()[index].frameBudget)
 {
   for(ExecutionUnitCreatorBase* i = ExecutionUnitCreatorBase::first; i; i = i->next)
   {
@@ -75,6 +77,10 @@ void ModuleContainer::connectWithDebug(Debug* debug, const Configuration::Thread
 void ModuleContainer::init()
 {
   BH_TRACE_INIT(getName().c_str());
+  Tracer::setThreadName(getName());
+
+  // Module construction in the first frames is not an overrun
+  lastTraceDump = Time::getRealSystemTime();
 
   // Prepare first frame
   numberOfMessages = debugSender->getNumberOfMessages();
@@ -87,15 +93,29 @@ bool ModuleContainer::main()
     if(!moduleGraphRunner.receiverEmpty(receiver.index))
       receiver.checkForPacket();
 
-  if((executionUnit->beforeFrame() || moduleGraphRunner.hasChanged()) && moduleGraphRunner.isValid())
+  const bool triggered = executionUnit->beforeFrame();
+  const bool changed = moduleGraphRunner.hasChanged();
+  if((triggered || changed) && moduleGraphRunner.isValid())
   {
     Global::getTimingManager().signalThreadStart();
     Global::getAnnotationManager().signalThreadStart();
 
     executionUnit->beforeModules();
+    const unsigned long long start = Tracer::now();
     STOPWATCH("AllModules") moduleGraphRunner.execute();
+    const unsigned long long duration = Tracer::now() - start;
     executionUnit->afterModules();
 
+    // On the robot, dump at most one trace every 10 s and not after the modules were reconfigured.
+    if(frameBudget && duration > frameBudget * 1000ull && !changed && SystemCall::getMode() == SystemCall::physicalRobot
+       && Time::getRealTimeSince(lastTraceDump) > 10000)
+    {
+      lastTraceDump = Time::getRealSystemTime();
+      OUTPUT_WARNING(getName() << ": executing the modules took " << static_cast<unsigned>(duration / 1000) << " ms, dumping trace");
+      dumpTrace("overrun");
+    }
+    DEBUG_RESPONSE_ONCE("timing:trace") dumpTrace("request");
+
     DEBUG_RESPONSE_ONCE("automated requests:DrawingManager") OUTPUT(idDrawingManager, bin, Global::getDrawingManager());
     DEBUG_RESPONSE_ONCE("automated requests:DrawingManager3D") OUTPUT(idDrawingManager3D, bin, Global::getDrawingManager3D());
 
@@ -156,3 +176,11 @@ bool ModuleContainer::handleMessage(InMessage& message)
       return true;
   return message.getMessageID() == idModuleRequest || ThreadFrame::handleMessage(message);
 }
+
+void ModuleContainer::dumpTrace(const std::string& reason)
+{
+  const std::string filename = "Logs/trace_" + getName() + "_" + reason + "_" + std::to_string(Time::getRealSystemTime()) + ".json";
+  // Writing the file takes too long for the thread that just overran its budget.
+  if(!Tracer::requestDump(filename))
+    OUTPUT_WARNING("Skipped " << filename << ", because the previous trace is still being written");
+}
@@ -41,6 +41,9 @@ private:
   int numberOfMessages = 0; /**< The number of debus messages at the beginning of a frame. */
   Logger* logger; /**< Points to the only logger of this robot. */
 
+  const unsigned frameBudget; /**< If executing all modules takes longer than this (in ms), a trace is dumped. 0 disables this. */
+  unsigned lastTraceDump = 0; /**< When was a trace dumped due to an overrun the last time (real time in ms)? */
+
 public:
   /**
    * The constructor.
@@ -118,4 +121,11 @@ protected:
    * @return Has the message been handled?
    */
   bool handleMessage(InMessage& message) override;
+
+private:
+  /**
+   * Lets the tracer write its recent history to a file in the directory "Logs".
+   * @param reason Why is the trace dumped? This is part of the file name.
+   */
+  void dumpTrace(const std::string& reason);
 };
@@ -107,7 +107,9 @@ public:
   static asmjit::JitRuntime& getAsmjitRuntime() { return *theAsmjitRuntime; }
 
   friend class ThreadFrame; // The class ThreadFrame can set these pointers.
+  friend class ModuleGraphRunner; // The class ModuleGraphRunner shares these pointers with its worker threads.
   friend class Robot; // The class Robot can set theSettings.
   friend class ConsoleRoboCupCtrl; // The class ConsoleRoboCupCtrl can set theSettings.
   friend class RobotTextConsole; // The class RobotTextConsole can set theDebugOut.
+  friend class ModuleGraphRunnerTest; // The test sets the pointers of the thread it runs in.
 };
@@ -1,68 +1,169 @@
 #include "LutRasterizer.h"
 #include "CNSSSE.h"
+#include "Platform/Memory.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
 
 using namespace std;
 
+namespace
+{
+  //! The beginning of a look-up-table, both in memory and in the cache file
+  /*! It is followed by \c vertexListBegin (one entry per viewpoint plus one for the end)
+      and then by \c vertexListData.
+   */
+  struct LutHeader
+  {
+    char magic[4]; //!< Always "CNSL"
+    unsigned version; //!< The version of the format
+    unsigned long long meshHash; //!< See \c LutRasterizer::hashOf
+    double spacing; //!< See \c LutRasterizer::spacing
+    double viewpointRange[6]; //!< Minimum and maximum of \c LutRasterizer::viewpointRange
+    int vertexListSize[3]; //!< See \c LutRasterizer::vertexListSize
+    unsigned dataSize; //!< The number of bytes of all vertex lists
+
+    LutHeader(unsigned long long meshHash, double spacing, const Eigen::AlignedBox3d& viewpointRange,
+              const int vertexListSize[3], unsigned dataSize) :
+      magic{'C', 'N', 'S', 'L'}, version(1), meshHash(meshHash), spacing(spacing),
+      viewpointRange{viewpointRange.min()(0), viewpointRange.min()(1), viewpointRange.min()(2),
+                     viewpointRange.max()(0), viewpointRange.max()(1), viewpointRange.max()(2)},
+      vertexListSize{vertexListSize[0], vertexListSize[1], vertexListSize[2]}, dataSize(dataSize)
+    {}
+
+    //! Does a header describe the same table? \c dataSize is not compared.
+    bool matches(const LutHeader& other) const
+    {
+      return !memcmp(magic, other.magic, sizeof(magic)) && version == other.version && meshHash == other.meshHash
+             && spacing == other.spacing && !memcmp(viewpointRange, other.viewpointRange, sizeof(viewpointRange))
+             && !memcmp(vertexListSize, other.vertexListSize, sizeof(vertexListSize));
+    }
+  };
+  static_assert(sizeof(LutHeader) % sizeof(unsigned) == 0, "The offsets following the header must be aligned");
+}
+
 void LutRasterizer::create(const TriangleMesh& object, const Eigen::AlignedBox3d& viewpointRange, double spacing)
 {
-  setObject(object);
-  allocateLut(viewpointRange, spacing);
-  for(int idx = 0; idx < static_cast<int>(vertexList.size()); idx++)
-    computeVertexList(vertexList[idx], object, viewpointOfIndex(idx));
+  loadOrCreate(object, viewpointRange, spacing);
 }
 
 void LutRasterizer::loadOrCreate(const TriangleMesh& object, const Eigen::AlignedBox3d& viewpointRange, double spacing, const char* filename)
 {
   setObject(object);
   allocateLut(viewpointRange, spacing);
-  if(!loadVertexList(filename))
+  const unsigned long long meshHash = hashOf(object);
+  if(filename == nullptr || !mapLut(filename, meshHash))
   {
-    for(int idx = 0; idx < static_cast<int>(vertexList.size()); idx++)
-      computeVertexList(vertexList[idx], object, viewpointOfIndex(idx));
+    vector<VertexList> vertexLists(vertexListSize[0] * vertexListSize[1] * vertexListSize[2]);
+    for(int idx = 0; idx < static_cast<int>(vertexLists.size()); idx++)
+      computeVertexList(vertexLists[idx], object, viewpointOfIndex(idx));
+    setLut(vertexLists, meshHash);
     if(filename != nullptr)
-      saveVertexList(filename);
+      saveLut(filename);
   }
 }
 
-bool LutRasterizer::loadVertexList(const char* filename)
+void LutRasterizer::setLut(const vector<VertexList>& vertexLists, unsigned long long meshHash)
 {
-  FILE* f = fopen(filename, "rb");
-  if(f == nullptr)
-    return false;
-  for(int idx = 0; idx < static_cast<int>(vertexList.size()); idx++)
+  size_t dataSize = 0;
+  for(const VertexList& vl : vertexLists)
+    dataSize += vl.size();
+
+  lutSize = sizeof(LutHeader) + (vertexLists.size() + 1) * sizeof(unsigned) + dataSize;
+  char* buffer = new char[lutSize];
+  lut.reset(buffer, default_delete<char[]>());
+  new(buffer) LutHeader(meshHash, spacing, viewpointRange, vertexListSize, static_cast<unsigned>(dataSize));
+
+  unsigned* begin = reinterpret_cast<unsigned*>(buffer + sizeof(LutHeader));
+  unsigned char* data = reinterpret_cast<unsigned char*>(begin + vertexLists.size() + 1);
+  unsigned offset = 0;
+  for(size_t idx = 0; idx < vertexLists.size(); idx++)
   {
-    int ctr;
-    fread(&ctr, sizeof(ctr), 1, f);
-    vertexList[idx].resize(ctr);
-    if(ctr > 0)
-      fread(&vertexList[idx][0], sizeof(vertexList[idx][0]), ctr, f);
-    if(feof(f) || ferror(f))
-    {
-      vertexList.clear();
-      fclose(f);
-      return false;
-    }
+    begin[idx] = offset;
+    if(!vertexLists[idx].empty())
+      memcpy(data + offset, vertexLists[idx].data(), vertexLists[idx].size());
+    offset += static_cast<unsigned>(vertexLists[idx].size());
   }
-  char x;
-  if(fread(&x, sizeof(x), 1, f) != 0)
+  begin[vertexLists.size()] = offset;
+  vertexListBegin = begin;
+  vertexListData = data;
+}
+
+bool LutRasterizer::mapLut(const char* filename, unsigned long long meshHash)
+{
+  size_t size = 0;
+  char* mapping = Memory::mapFile(filename, size);
+  if(mapping == nullptr)
+    return false;
+
+  const size_t numOfViewpoints = vertexListSize[0] * vertexListSize[1] * vertexListSize[2];
+  const size_t headerAndOffsetsSize = sizeof(LutHeader) + (numOfViewpoints + 1) * sizeof(unsigned);
+  const LutHeader& header = *reinterpret_cast<const LutHeader*>(mapping);
+  const unsigned* begin = reinterpret_cast<const unsigned*>(mapping + sizeof(LutHeader));
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(begin + numOfViewpoints + 1);
+  bool valid = size >= headerAndOffsetsSize
+               && header.matches(LutHeader(meshHash, spacing, viewpointRange, vertexListSize, 0))
+               && size == headerAndOffsetsSize + header.dataSize
+               && begin[0] == 0 && begin[numOfViewpoints] == header.dataSize;
+
+  // The rasterizer reads the vertex lists through these offsets, so they must stay inside the file
+  // and each list must consist of whole entries that are vertex indices of the object.
+  for(size_t idx = 0; valid && idx < numOfViewpoints; idx++)
+    valid = begin[idx] <= begin[idx + 1] && (begin[idx + 1] - begin[idx]) % sizeof(VertexList::value_type) == 0;
+  for(size_t i = 0; valid && i < header.dataSize; i++)
+    valid = data[i] == NEWSTART || data[i] < vertexWith1.size();
+
+  if(!valid)
   {
-    vertexList.clear();
-    return false; // file should have an end
+    Memory::unmapFile(mapping, size);
+    return false;
   }
-  fclose(f);
+
+  lut.reset(mapping, [size](const char* ptr) {Memory::unmapFile(const_cast<char*>(ptr), size);});
+  lutSize = size;
+  vertexListBegin = begin;
+  vertexListData = data;
   return true;
 }
 
-void LutRasterizer::saveVertexList(const char* filename) const
+void LutRasterizer::saveLut(const char* filename) const
 {
-  FILE* f = fopen(filename, "wb");
-  for(int idx = 0; idx < static_cast<int>(vertexList.size()); idx++)
+  // The file may be mapped by other instances, so it must not be truncated. It is written under a
+  // temporary name that is unique per writer and then renamed, so readers only see complete files.
+  const std::string tmpName = std::string(filename) + "." + std::to_string(std::random_device()()) + ".tmp";
+  FILE* f = fopen(tmpName.c_str(), "wb");
+  if(f == nullptr)
+    return;
+  const bool written = fwrite(lut.get(), 1, lutSize, f) == lutSize;
+  if(fclose(f) || !written)
+    std::remove(tmpName.c_str());
+  else if(std::rename(tmpName.c_str(), filename)) // Windows does not replace existing files
+  {
+    std::remove(filename);
+    if(std::rename(tmpName.c_str(), filename))
+      std::remove(tmpName.c_str());
+  }
+}
+
+unsigned long long LutRasterizer::hashOf(const TriangleMesh& object)
+{
+  unsigned long long hash = 14695981039346656037ull;
+  const auto add = [&hash](const void* data, size_t size)
+  {
+    for(const unsigned char* p = static_cast<const unsigned char*>(data), *end = p + size; p < end; p++)
+      hash = (hash ^ *p) * 1099511628211ull;
+  };
+  for(const Eigen::Vector3d& vertex : object.vertex)
+    add(vertex.data(), 3 * sizeof(double));
+  for(const TriangleMesh::Face& face : object.face)
   {
-    int ctr = static_cast<int>(vertexList[idx].size());
-    fwrite(&ctr, sizeof(ctr), 1, f);
-    fwrite(&vertexList[idx][0], sizeof(vertexList[idx][0]), ctr, f);
+    add(face.vertex, sizeof(face.vertex));
+    add(&face.color, sizeof(face.color));
   }
-  fclose(f);
+  const char isRotationalSymmetricZ = object.isRotationalSymmetricZ ? 1 : 0;
+  add(&isRotationalSymmetricZ, sizeof(isRotationalSymmetricZ));
+  return hash;
 }
 
 void LutRasterizer::allocateLut(const Eigen::AlignedBox3d& viewpointRange, double spacing)
@@ -94,7 +195,6 @@ void LutRasterizer::allocateLut(const Eigen::AlignedBox3d& viewpointRange, doubl
     basePoint[i] = min(point0X[i], point1X[i]);
     vertexListSize[i] = static_cast<int>(ceil(fabs(point1X[i] - point0X[i]) / spacing - eps + 1));
   }
-  vertexList.resize(vertexListSize[0] * vertexListSize[1] * vertexListSize[2]);
 }
 
 void LutRasterizer::countVertices(vector<int>& counter, const TriangleMesh::EdgeList& el)
@@ -207,7 +307,10 @@ void LutRasterizer::setObject(const TriangleMesh& object)
 {
   assert(object.vertex.size() <= NEWSTART); // We only have 8 bit for vertex indices
   this->object = object;
-  vertexList.clear();
+  lut.reset();
+  lutSize = 0;
+  vertexListBegin = nullptr;
+  vertexListData = nullptr;
   vertexWith1.resize(object.vertex.size());
   for(int i = 0; i < static_cast<int>(vertexWith1.size()); i++)
   {
@@ -234,14 +337,12 @@ void LutRasterizer::computeCenterPoint()
   centerWith1 = (minV + maxV) / 2;
 }
 
-void LutRasterizer::computeProjection(int& idx, int& referenceX, int& referenceY,
-                                      float P0[4], float P1[4], float P2[4], float clipRange[4],
-                                      const Eigen::Isometry3d& object2World, const CameraModelOpenCV& camera) const
+void LutRasterizer::computeProjectionInCamera(int& idx, int& referenceX, int& referenceY,
+                                              float P0[4], float P1[4], float P2[4], float clipRange[4],
+                                              Eigen::Isometry3d object2Camera, const CameraModelOpenCV& camera) const
 {
-  assert(!camera.isDistorted);
-  Eigen::Isometry3d object2Camera = camera.camera2World.inverse() * object2World;
   normalizeObject2Camera(object2Camera);
-  idx = indexOfNormalizedViewpoint(object2Camera.inverse().translation());
+  idx = indexOfNormalizedViewpoint(viewpointOf(object2Camera));
 
   // The matrix is yet without offset
   P0[0] = static_cast<float>(object2Camera(0, 0) * camera.scale_x);
@@ -291,6 +392,21 @@ void LutRasterizer::computeProjection(int& idx, int& referenceX, int& referenceY
 }
 
 void LutRasterizer::rasterize(CodedContour& contour, const Eigen::Isometry3d& object2World, const CameraModelOpenCV& camera) const
+{
+  assert(!camera.isDistorted);
+  rasterizeInCamera(contour, camera.camera2World.inverse() * object2World, camera);
+}
+
+void LutRasterizer::rasterize(vector<CodedContour>& contours, const vector<Eigen::Isometry3d>& object2World, const CameraModelOpenCV& camera) const
+{
+  assert(!camera.isDistorted);
+  const Eigen::Isometry3d world2Camera = camera.camera2World.inverse();
+  contours.resize(object2World.size());
+  for(size_t i = 0; i < object2World.size(); i++)
+    rasterizeInCamera(contours[i], world2Camera * object2World[i], camera);
+}
+
+void LutRasterizer::rasterizeInCamera(CodedContour& contour, const Eigen::Isometry3d& object2Camera, const CameraModelOpenCV& camera) const
 {
   contour.clear();
 
@@ -300,36 +416,51 @@ void LutRasterizer::rasterize(CodedContour& contour, const Eigen::Isometry3d& ob
   alignas(16) float P1[4];
   alignas(16) float P2[4];
   alignas(16) float clipRange[4];
-  computeProjection(idx, contour.referenceX, contour.referenceY, P0, P1, P2, clipRange, object2World, camera);
+  computeProjectionInCamera(idx, contour.referenceX, contour.referenceY, P0, P1, P2, clipRange, object2Camera, camera);
   if(idx < 0)
     return;
 
-  // Project all points and store the edges midpoints as CodedContourPoint
-  const VertexList& vl = vertexList[idx];
-  alignas(16) float p[4]; // First and second point (x,y) of the current edge
-  bool isNewEdge = true;
-  int clippedCtr = 0;
-  for(int i = 0; i < static_cast<int>(vl.size()); i++)
+  // Project the vertices four at a time into projected[2 * i], projected[2 * i + 1]
+  // NEWSTART entries are projected as vertex 0 and ignored afterwards.
+  // The sums are formed in the same order as in projectUsingSSE.
+  const unsigned char* vl = vertexListData + vertexListBegin[idx];
+  const int n = static_cast<int>(vertexListBegin[idx + 1] - vertexListBegin[idx]);
+  projected.resize(2 * ((n + 3) & ~3));
+  const __m128 p00 = _mm_set1_ps(P0[0]), p01 = _mm_set1_ps(P0[1]), p02 = _mm_set1_ps(P0[2]), p03 = _mm_set1_ps(P0[3]);
+  const __m128 p10 = _mm_set1_ps(P1[0]), p11 = _mm_set1_ps(P1[1]), p12 = _mm_set1_ps(P1[2]), p13 = _mm_set1_ps(P1[3]);
+  const __m128 p20 = _mm_set1_ps(P2[0]), p21 = _mm_set1_ps(P2[1]), p22 = _mm_set1_ps(P2[2]), p23 = _mm_set1_ps(P2[3]);
+  for(int i = 0; i < n; i += 4)
   {
-    int vIdx = vl[i];
-    if(vIdx != NEWSTART)
+    alignas(16) float x[4], y[4], z[4];
+    for(int j = 0; j < 4; j++)
     {
-      shift4Floats(p);
+      const int vIdx = i + j < n && vl[i + j] != NEWSTART ? vl[i + j] : 0;
       assert(0 <= vIdx && vIdx < static_cast<int>(vertexWith1.size()));
-      projectUsingSSE(p + 2, const_cast<float*>(vertexWith1[vIdx].data()), P0, P1, P2);
-      if(!isNewEdge)
-      {
-        CodedContourPoint ccp = code2DEdgeUsingSSE(p, clipRange);
-        if(ccp != EMPTYCONTOURPOINT)
-          contour.push_back(ccp);
-        else
-          clippedCtr++;
-      }
-      isNewEdge = false;
+      x[j] = vertexWith1[vIdx](0);
+      y[j] = vertexWith1[vIdx](1);
+      z[j] = vertexWith1[vIdx](2);
     }
-    else isNewEdge = true;
+    const __m128 xV = _mm_load_ps(x), yV = _mm_load_ps(y), zV = _mm_load_ps(z);
+    const __m128 denom = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xV, p20), _mm_mul_ps(yV, p21)), _mm_add_ps(_mm_mul_ps(zV, p22), p23));
+    const __m128 u = _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(xV, p00), _mm_mul_ps(yV, p01)), _mm_add_ps(_mm_mul_ps(zV, p02), p03)), denom);
+    const __m128 v = _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(xV, p10), _mm_mul_ps(yV, p11)), _mm_add_ps(_mm_mul_ps(zV, p12), p13)), denom);
+    _mm_storeu_ps(&projected[2 * i], _mm_unpacklo_ps(u, v));
+    _mm_storeu_ps(&projected[2 * i + 4], _mm_unpackhi_ps(u, v));
   }
 
+  // Store the edges midpoints as CodedContourPoint
+  alignas(16) float p[4]; // First and second point (x,y) of the current edge
+  int clippedCtr = 0;
+  for(int i = 0; i + 1 < n; i++)
+    if(vl[i] != NEWSTART && vl[i + 1] != NEWSTART)
+    {
+      _mm_store_ps(p, _mm_loadu_ps(&projected[2 * i]));
+      CodedContourPoint ccp = code2DEdgeUsingSSE(p, clipRange);
+      if(ccp != EMPTYCONTOURPOINT)
+        contour.push_back(ccp);
+      else
+        clippedCtr++;
+    }
   // Scale the coded normal vector according to the number of points
   // This is needed so the 16bit accumulator in \c responseX8YRUsingSSE3 does not overflow
   int factorI = static_cast<int>(round(factorOfN(static_cast<int>(static_cast<float>(contour.size()) + clippedCtr * contour.mapping.clippedDenom), true) * (256.0 / 127.0)));
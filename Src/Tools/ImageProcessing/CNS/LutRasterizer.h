@@ -4,6 +4,7 @@
 #include "CameraModelOpenCV.h"
 #include "CodedContour.h"
 #include <Eigen/StdVector>
+#include <memory>
 
 //! Algorithms and precomputed data-structures to perform ShapeCNSDetector::rasterize efficiently
 /*! The current implementation supports only distortion-free cameras.
@@ -49,14 +50,33 @@ public:
 
   enum {NEWSTART = 0xff};
 
-  //! Look-up-table storing the contour of \c object from different viewpoints as \c VertexList objects
-  /*! edgelist[indexOfViewPoint(v)] is the contour of \c object viewed from \c v as a list of vertex
-      indices.
+  //! Look-up-table storing the contour of \c object from different viewpoints as vertex lists
+  /*! The contour of \c object viewed from \c v as a list of vertex indices (see \c VertexList) is
+      vertexListData[vertexListBegin[idx]] .. vertexListData[vertexListBegin[idx + 1] - 1]
+      with idx = indexOfViewPoint(v).
 
-      Technically, the array is a regular \c spacing grid of points with dimensions \c edgeListSize[0]*
-      \c edgeListSize[1] * \c edgeListSize[2] in X, Y, Z.
+      Technically, the array is a regular \c spacing grid of points with dimensions \c vertexListSize[0]*
+      \c vertexListSize[1] * \c vertexListSize[2] in X, Y, Z.
+
+      Both arrays point into \c lut, which is either computed or a cache file mapped into memory.
    */
-  std::vector<VertexList> vertexList;
+  const unsigned* vertexListBegin = nullptr;
+
+  //! See \c vertexListBegin
+  const unsigned char* vertexListData = nullptr;
+
+  //! The memory block containing the look-up-table in the format of the cache file
+  /*! It is shared between copies, because it is never changed after creation. */
+  std::shared_ptr<const char> lut;
+
+  //! The size of \c lut in bytes
+  size_t lutSize = 0;
+
+  //! Buffer for the projected vertices of the contour rasterized last
+  /*! It keeps its capacity, so \c rasterize does not allocate memory once it has grown to the
+      longest vertex list. Therefore, the same object must not rasterize in several threads at once.
+   */
+  mutable std::vector<float> projected;
 
   //! See \c indexOfViewPoint
   int vertexListSize[3];
@@ -88,8 +108,9 @@ public:
    */
   void create(const TriangleMesh& object, const Eigen::AlignedBox3d& viewpointRange, double spacing);
 
-  //! Same as \c create but tries to load and saves the look-up-table in \c filename
-  /*! Note: At the moment the user has to take care to delete \c filename the parameters have been changed.
+  //! Same as \c create but tries to map the look-up-table from the cache file \c filename into memory
+  /*! The cache file stores a hash of \c object as well as \c viewpointRange and \c spacing. If they do
+      not match, the table is computed and the cache file is replaced.
       If \c filename is \c nullptr, the table is neither loaded nor saved.
    */
   void loadOrCreate(const TriangleMesh& object, const Eigen::AlignedBox3d& viewpointRange, double spacing, const char* filename = nullptr);
@@ -103,7 +124,13 @@ public:
    */
   void rasterize(CodedContour& contour, const Eigen::Isometry3d& object2World, const CameraModelOpenCV& camera) const;
 
-  //! Returns the viewpoint from which \c vertexList[idx] is computed.
+  //! Renders the contours of \c mesh at all poses \c object2World from the perspective of \c camera
+  /*! The result is the same as calling \c rasterize for each pose, but the camera pose is only
+      inverted once. Existing entries of \c contours are reused to avoid allocations.
+   */
+  void rasterize(std::vector<CodedContour>& contours, const std::vector<Eigen::Isometry3d>& object2World, const CameraModelOpenCV& camera) const;
+
+  //! Returns the viewpoint from which the vertex list with index \c idx is computed.
   Eigen::Vector3d viewpointOfIndex(int idx) const
   {
     return basePoint + spacing * Eigen::Vector3d(
@@ -122,27 +149,26 @@ public:
   {
     if(!object.isRotationalSymmetricZ)
       return;
-    Eigen::Vector3d viewpointInObject = object2Camera.inverse().translation();
+    const Eigen::Vector3d viewpointInObject = viewpointOf(object2Camera);
 
     double len = sqrt(viewpointInObject(0) * viewpointInObject(0) + viewpointInObject(1) * viewpointInObject(1));
     if(len == 0)
       return;
+    // c,s are cos and sin of a rotation around Z that rotates viewpointInObject to X>0, Y=0.
+    // Applying it from the right only mixes the first two columns of the rotation.
     double c = viewpointInObject(0) / len, s = viewpointInObject(1) / len;
-    double angle = atan2(s, c);
-    /*    // c,s are cos and sin of a rotation matrix that rotates viewpointInObject to X>0, Y=0
-    Eigen::Matrix4d rot;
-    rot <<
-      1, 0, 0, 0,
-      0, c,-s, 0,
-      0, s, c, 0,
-      0, 0, 0, 1;
-    object2Camera = object2Camera*Eigen::Isometry3d(rot); //TODO: improve performance?
-     */
-    object2Camera = object2Camera * Eigen::AngleAxisd(angle, Eigen::Vector3d::UnitZ());
-    viewpointInObject = object2Camera.inverse().translation();
+    const Eigen::Vector3d xAxis = object2Camera.linear().col(0);
+    object2Camera.linear().col(0) = c * xAxis + s * object2Camera.linear().col(1);
+    object2Camera.linear().col(1) = c * object2Camera.linear().col(1) - s * xAxis;
   }
 
-  //! Computes the index in \c vertexList corresponding to the viewpoint closest to \c viewpoint
+  //! Returns the position of the camera in object coordinates, i.e. \c object2Camera.inverse().translation()
+  static Eigen::Vector3d viewpointOf(const Eigen::Isometry3d& object2Camera)
+  {
+    return -(object2Camera.linear().transpose() * object2Camera.translation());
+  }
+
+  //! Computes the index in \c vertexListBegin corresponding to the viewpoint closest to \c viewpoint
   /*! If \c viewpoint is outside the volume (here cube) of tabulated viewpoints,
       -1 is returned.
    */
@@ -197,7 +223,7 @@ public:
   //! Takes a list of vertices defining an edge list and converts it back to an edge list
   static void convertVertexListToEdgeList(TriangleMesh::EdgeList& edgeList, LutRasterizer::VertexList& vertexList);
 
-  //! Allocates \c vertexList for a ranges of discretized vertex coordinates (see \c computeLut)
+  //! Computes the dimensions of the look-up-table for a ranges of discretized vertex coordinates
   /*! \c object must already been set.*/
   void allocateLut(const Eigen::AlignedBox3d& viewpointRange, double spacing);
 
@@ -219,22 +245,41 @@ public:
    */
   void computeProjection(int& idx, int& referenceX, int& referenceY,
                          float P0[4], float P1[4], float P2[4], float clipRange[4],
-                         const Eigen::Isometry3d& object2World, const CameraModelOpenCV& camera) const;
+                         const Eigen::Isometry3d& object2World, const CameraModelOpenCV& camera) const
+  {
+    assert(!camera.isDistorted);
+    computeProjectionInCamera(idx, referenceX, referenceY, P0, P1, P2, clipRange, camera.camera2World.inverse() * object2World, camera);
+  }
 
-  //! Tries to load \c vertexList from \c filename
-  /*! \c vertexList must already be allocated and all parameter set. If loading fails, \c false is returned.
+  //! Same as \c computeProjection, but for the object pose relative to the camera
+  void computeProjectionInCamera(int& idx, int& referenceX, int& referenceY,
+                                 float P0[4], float P1[4], float P2[4], float clipRange[4],
+                                 Eigen::Isometry3d object2Camera, const CameraModelOpenCV& camera) const;
+
+  //! Implements \c rasterize for the object pose relative to the camera
+  void rasterizeInCamera(CodedContour& contour, const Eigen::Isometry3d& object2Camera, const CameraModelOpenCV& camera) const;
+
+  //! Stores the vertex lists in \c lut in the format of the cache file
+  /*! The dimensions of the table must already be set. */
+  void setLut(const std::vector<VertexList>& vertexLists, unsigned long long meshHash);
+
+  //! Tries to map \c lut from the cache file \c filename
+  /*! The dimensions of the table must already be set. If the file does not exist, does not match
+      \c meshHash or the dimensions, or its offsets or vertex indices are invalid, \c false is returned.
    */
-  bool loadVertexList(const char* filename);
+  bool mapLut(const char* filename, unsigned long long meshHash);
+
+  //! Saves \c lut such that it can be mapped by \c mapLut and \c loadOrCreate.
+  /*! The file is replaced atomically, because other instances may have mapped it. */
+  void saveLut(const char* filename) const;
 
-  //! Save \c vertexList such that it can be loaded by \c loadVertexList and \c loadOrCreate.
-  void saveVertexList(const char* filename) const;
+  //! Computes a 64 bit FNV-1a hash of the geometry of \c object
+  /*! It identifies the object a cache file was created for. */
+  static unsigned long long hashOf(const TriangleMesh& object);
 
   //! Returns the memory consumption of \c this
   int memory() const
   {
-    int mem = static_cast<int>(sizeof(*this) + vertexList.capacity() * sizeof(vertexList.front()) + object.memory());
-    for(size_t i = 0; i < vertexList.size(); i++)
-      mem += static_cast<int>(vertexList[i].capacity() * sizeof(vertexList[i].front()));
-    return mem;
+    return static_cast<int>(sizeof(*this) + lutSize + object.memory());
   }
 };
@@ -119,25 +119,31 @@ void ObjectCNSStereoDetector::searchBlockAllPoses(IsometryWithResponses& object2
     return;
   Eigen::Vector3d object2WorldTranslation = p + minLambda * v;
   int ctr = 0;
+  poses.clear();
   while((object2WorldTranslation - p).dot(v) <= maxLambda * v.squaredNorm())
   {
     assert((object2WorldTranslation - p).dot(v) >= (minLambda - 1E-3)*v.squaredNorm());
 
     for(int i = 0; i < static_cast<int>(spec.object2WorldOrientation.size()); i++)
     {
-      Eigen::Isometry3d object2World(spec.object2WorldOrientation[i]);
-      object2World.translation() = object2WorldTranslation;
-      IsometryWithResponse result;
-      if(object2WorldList.size() == static_cast<size_t>(spec.nResponses))
-        result.response = object2WorldList.back().response;
-      if(searchBlockFixedPose(result, cns, object2World))
-        addToList(object2WorldList, result, spec.nResponses);
+      poses.emplace_back(spec.object2WorldOrientation[i]);
+      poses.back().translation() = object2WorldTranslation;
     }
 
     object2WorldTranslation = searchStepTranslationViewing(object2WorldTranslation, spec.stepInPixelGlobalDiscretization);
     ctr++;
     assert(ctr < 1000);
   }
+
+  lr.rasterize(contours, poses, camera);
+  for(size_t i = 0; i < poses.size(); i++)
+  {
+    IsometryWithResponse result;
+    if(object2WorldList.size() == static_cast<size_t>(spec.nResponses))
+      result.response = object2WorldList.back().response;
+    if(searchBlockFixedPose(result, cns, poses[i], contours[i]))
+      addToList(object2WorldList, result, spec.nResponses);
+  }
 }
 
 void ObjectCNSStereoDetector::renderBlockFixedPose(Contour& ct,
@@ -159,9 +165,18 @@ void ObjectCNSStereoDetector::renderBlockFixedPose(Contour& ct,
 bool ObjectCNSStereoDetector::searchBlockFixedPose(IsometryWithResponse& object2World,
     const CNSImage& cns,
     const Eigen::Isometry3d& object2WorldTry) const
+{
+  CodedContour ct;
+  lr.rasterize(ct, object2WorldTry, camera);
+  return searchBlockFixedPose(object2World, cns, object2WorldTry, ct);
+}
+
+bool ObjectCNSStereoDetector::searchBlockFixedPose(IsometryWithResponse& object2World,
+    const CNSImage& cns,
+    const Eigen::Isometry3d& object2WorldTry, const CodedContour& ct) const
 {
   int maxVal = 0, argMaxX = 0, argMaxY = 0;
-  responseXYMax(maxVal, argMaxX, argMaxY, cns, object2WorldTry, spec.blockX, spec.blockY);
+  responseXYMax(maxVal, argMaxX, argMaxY, cns, ct, spec.blockX, spec.blockY);
   double maxF = LinearResponseMapping().finalBin2FinalFloat(static_cast<short>(maxVal));
 
   if(maxF > object2World.response)
@@ -209,9 +224,16 @@ void ObjectCNSStereoDetector::responseXYMax(int& maxVal, int& argMaxX, int& argM
     const CNSImage& cns, const Eigen::Isometry3d& object2World,
     int blockX, int blockY) const
 {
-  assert((blockX & 0xf) == 0 && (blockY & 0xf) == 0);
   CodedContour ct;
   lr.rasterize(ct, object2World, camera);
+  responseXYMax(maxVal, argMaxX, argMaxY, cns, ct, blockX, blockY);
+}
+
+void ObjectCNSStereoDetector::responseXYMax(int& maxVal, int& argMaxX, int& argMaxY,
+    const CNSImage& cns, const CodedContour& ct,
+    int blockX, int blockY) const
+{
+  assert((blockX & 0xf) == 0 && (blockY & 0xf) == 0);
 
   int xMin = -blockX / 2, xMax = blockX / 2;
   int yMin = -blockY / 2, yMax = blockY / 2;
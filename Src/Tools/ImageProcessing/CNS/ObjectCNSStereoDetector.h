@@ -66,6 +66,12 @@ public:
   //! Auxiliary function/data structure to interpolate a tabulated 3-D maximum
   SubpixelMaximizer subpixelMaximizer;
 
+  //! Buffer for the poses searched by \c searchBlockAllPoses, kept to avoid allocations
+  mutable std::vector<Eigen::Isometry3d> poses;
+
+  //! Buffer for the contours rasterized for \c poses, kept to avoid allocations
+  mutable std::vector<CodedContour> contours;
+
   //! Empty constructor
   ObjectCNSStereoDetector() : useSparseContour(true) {}
 
@@ -144,8 +150,8 @@ public:
   /*! The center is converted to a ray, intersected with \c spec.positionSpace
       and discretized according to \c spec.stepInPixelGlobalDiscretization. This
       gives the set of positions. The set of orientations is taken from \c spec.object2WorldOrientation.
-      For all these poses \c searchBlockFixedPose is called and the result
-      added to \c object2World.
+      All these poses are rasterized in one batch, then \c searchBlockFixedPose is
+      called for each of them and the result added to \c object2World.
    */
   void searchBlockAllPoses(IsometryWithResponses& object2WorldList,
                            const CNSImage& cns,
@@ -167,6 +173,11 @@ public:
                             const CNSImage& cns,
                             const Eigen::Isometry3d& object2WorldTry) const;
 
+  //! Same as above, but with the contour \c ct already rasterized for \c object2WorldTry
+  bool searchBlockFixedPose(IsometryWithResponse& object2World,
+                            const CNSImage& cns,
+                            const Eigen::Isometry3d& object2WorldTry, const CodedContour& ct) const;
+
   //! Renders the object in all poses searched for into \c ct for visualization of the search space
   /*! Actually the same contour is searched for in different translations according to
     \c spec.blockX and \c spec.blockY. Only the center of these is visualized, otherwise the
@@ -234,6 +245,11 @@ public:
                      const CNSImage& cns, const Eigen::Isometry3d& object2World,
                      int blockX, int blockY) const;
 
+  //! Same as above, but for the contour \c ct already rasterized
+  void responseXYMax(int& maxVal, int& argMaxX, int& argMaxY,
+                     const CNSImage& cns, const CodedContour& ct,
+                     int blockX, int blockY) const;
+
   //! Dimensions in the 6-DOF pose space used for searching
   enum {DIM_ROT_X = 0, DIM_ROT_Y = 1, DIM_ROT_Z = 2, DIM_TRANS_IMAGE_X = 3, DIM_TRANS_IMAGE_Y = 4, DIM_TRANS_VIEWING = 5};
 
@@ -0,0 +1,120 @@
+/**
+ * @file ConnectedComponents.cpp
+ *
+ * This file implements a class that labels the 4-connected components of a
+ * binary grid using runs and a union-find structure.
+ */
+
+#include "ConnectedComponents.h"
+#include "Tools/ImageProcessing/SIMD.h"
+
+void ConnectedComponents::label(const char* grid, int width, int height, int stride)
+{
+  runs.clear();
+  parents.clear();
+  components.clear();
+
+  // Each run gets a preliminary label, which is its index. Overlapping runs of
+  // consecutive rows are merged. The root of a set is always its smallest label.
+  size_t previousBegin = 0;
+  size_t previousEnd = 0;
+  for(int y = 0; y < height; ++y)
+  {
+    const size_t currentBegin = runs.size();
+    addRuns(grid + y * stride, width, y);
+
+    size_t previous = previousBegin;
+    for(size_t i = currentBegin; i < runs.size(); ++i)
+    {
+      const Run& run = runs[i];
+      while(previous < previousEnd && runs[previous].xEnd <= run.xBegin)
+        ++previous;
+      for(size_t j = previous; j < previousEnd && runs[j].xBegin < run.xEnd; ++j)
+      {
+        const int root1 = find(run.component);
+        const int root2 = find(runs[j].component);
+        if(root1 < root2)
+          parents[root2] = root1;
+        else if(root2 < root1)
+          parents[root1] = root2;
+      }
+    }
+    previousBegin = currentBegin;
+    previousEnd = runs.size();
+  }
+
+  // Since parents always have smaller labels, replacing the labels in ascending
+  // order by the index of their component only looks up labels already replaced.
+  for(size_t i = 0; i < runs.size(); ++i)
+  {
+    Run& run = runs[i];
+    if(parents[i] == static_cast<int>(i))
+    {
+      parents[i] = static_cast<int>(components.size());
+      components.emplace_back(Rangei(run.xBegin, run.xEnd - 1), Rangei(run.y, run.y));
+    }
+    else
+    {
+      parents[i] = parents[parents[i]];
+      Boundaryi& component = components[parents[i]];
+      component.x.add(Rangei(run.xBegin, run.xEnd - 1));
+      component.y.add(run.y);
+    }
+    run.component = parents[i];
+  }
+}
+
+void ConnectedComponents::addRuns(const char* row, int width, int y)
+{
+  int begin = -1;
+  const auto addCell = [&](int x)
+  {
+    if(row[x])
+    {
+      if(begin < 0)
+        begin = x;
+    }
+    else if(begin >= 0)
+    {
+      parents.push_back(static_cast<int>(runs.size()));
+      runs.push_back({y, begin, x, parents.back()});
+      begin = -1;
+    }
+  };
+
+  // Chunks that are completely empty or completely set do not change the
+  // state of the current run except at their first cell.
+  const __m128i zeros = _mm_setzero_si128();
+  int x = 0;
+  for(; x + 16 <= width; x += 16)
+  {
+    const int empty = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x)), zeros));
+    if(empty == 0xffff || empty == 0)
+      addCell(x);
+    else
+      for(int i = x; i < x + 16; ++i)
+        addCell(i);
+  }
+  for(; x < width; ++x)
+    addCell(x);
+
+  if(begin >= 0)
+  {
+    parents.push_back(static_cast<int>(runs.size()));
+    runs.push_back({y, begin, width, parents.back()});
+  }
+}
+
+int ConnectedComponents::find(int label)
+{
+  int root = label;
+  while(parents[root] != root)
+    root = parents[root];
+  while(parents[label] != root)
+  {
+    const int next = parents[label];
+    parents[label] = root;
+    label = next;
+  }
+  return root;
+}
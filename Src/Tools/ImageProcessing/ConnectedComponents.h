@@ -0,0 +1,71 @@
+/**
+ * @file ConnectedComponents.h
+ *
+ * This file declares a class that labels the 4-connected components of a
+ * binary grid, e.g. a grid of image blocks that should be searched. The grid
+ * is first converted into horizontal runs of set cells. Rows are scanned in
+ * chunks of 16 cells with SSE, so that empty or completely filled parts of a
+ * row only cost a single comparison. Overlapping runs of neighboring rows are
+ * then merged with a union-find structure, which yields the bounding box of
+ * each component without visiting single cells again.
+ */
+
+#pragma once
+
+#include "Tools/Boundary.h"
+#include <vector>
+
+class ConnectedComponents
+{
+public:
+  /** A horizontal sequence of set cells. */
+  struct Run
+  {
+    int y; /**< The row of the run. */
+    int xBegin; /**< The first cell of the run. */
+    int xEnd; /**< The cell after the last cell of the run. */
+    int component; /**< The index of the component this run belongs to. */
+  };
+
+  /**
+   * Labels the 4-connected components of a grid.
+   * @param grid The upper left cell of the grid. All cells that are not 0 are set.
+   * @param width The number of cells per row.
+   * @param height The number of rows.
+   * @param stride The distance between the beginnings of two rows (in cells).
+   */
+  void label(const char* grid, int width, int height, int stride);
+
+  /**
+   * The bounding boxes of all components found by the last call of label.
+   * The ranges are inclusive, i.e. the box of a single cell is (x, x), (y, y).
+   * The components are ordered by their first cell in row-major order.
+   */
+  const std::vector<Boundaryi>& getComponents() const {return components;}
+
+  /**
+   * All runs found by the last call of label, ordered row-major. Together with
+   * Run::component, they allow to visit all cells of a component.
+   */
+  const std::vector<Run>& getRuns() const {return runs;}
+
+private:
+  std::vector<Run> runs; /**< The runs of the last grid labeled. */
+  std::vector<int> parents; /**< The union-find forest over the preliminary labels of the runs. */
+  std::vector<Boundaryi> components; /**< The bounding boxes of the components. */
+
+  /**
+   * Appends the runs of a single row.
+   * @param row The first cell of the row.
+   * @param width The number of cells in the row.
+   * @param y The index of the row.
+   */
+  void addRuns(const char* row, int width, int y);
+
+  /**
+   * Determines the root of a preliminary label and compresses the path to it.
+   * @param label The preliminary label.
+   * @return The root label.
+   */
+  int find(int label);
+};
@@ -8,16 +8,24 @@
 
 #include "Tools/ImageProcessing/Resize.h"
 #include "Tools/ImageProcessing/SIMD.h"
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <vector>
 
-void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::GrayscaledPixel>& src, PixelTypes::GrayscaledPixel* dest)
+/**
+ * Shrinks consecutive rows of a grayscaled image horizontally.
+ * @param downScales How often the width is halved.
+ * @param pSrc The first pixels of the rows (16-byte aligned).
+ * @param srcWidth The width of the rows.
+ * @param srcHeight The number of rows.
+ * @param dest The destination (16-byte aligned). It must hold the rows
+ *             shrunk by 2^min(downScales, 3).
+ * @return The width of the shrunk rows.
+ */
+static size_t shrinkYHorizontally(const unsigned int downScales, const __m128i* pSrc, size_t srcWidth, const size_t srcHeight,
+                                  PixelTypes::GrayscaledPixel* dest)
 {
-  const __m128i* pSrc = reinterpret_cast<const __m128i*>(src[0]);
-
-  size_t srcWidth = src.width;
-  size_t srcHeight = src.height;
-
-  // Shrink horizontally
   size_t downScalesLeft = downScales;
   for(; downScalesLeft > 2; downScalesLeft -= 3)
   {
@@ -114,9 +122,17 @@ void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::Gray
     }
     srcWidth >>= 1;
   }
+  return srcWidth;
+}
+
+void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::GrayscaledPixel>& src, PixelTypes::GrayscaledPixel* dest)
+{
+  size_t srcWidth = shrinkYHorizontally(downScales, reinterpret_cast<const __m128i*>(src[0]), src.width, src.height, dest);
+  size_t srcHeight = src.height;
+  const __m128i* pSrc;
 
   // Shrink vertically
-  downScalesLeft = downScales;
+  size_t downScalesLeft = downScales;
   if(size_t overshoot = srcWidth % 16) // Row does not fit into SSE registers
   {
     overshoot = 16 - overshoot;
@@ -206,6 +222,54 @@ void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::Gray
   }
 }
 
+void Resize::shrinkYRowwise(const unsigned int downScales, const Image<PixelTypes::GrayscaledPixel>& src, PixelTypes::GrayscaledPixel* dest)
+{
+  if(!downScales)
+  {
+    std::memcpy(dest, src[0], src.width * src.height);
+    return;
+  }
+
+  const unsigned int rowsPerRow = 1u << downScales;
+  const size_t destWidth = src.width >> downScales;
+  for(unsigned int y = 0; y < src.height; y += rowsPerRow, dest += destWidth)
+    shrinkYRows(downScales, src[y], src.width, dest);
+}
+
+void Resize::shrinkYRows(const unsigned int downScales, const PixelTypes::GrayscaledPixel* src, const unsigned int width, PixelTypes::GrayscaledPixel* dest)
+{
+  if(!downScales)
+  {
+    std::memcpy(dest, src, width);
+    return;
+  }
+
+  // Buffer for the rows that form a single destination row after horizontal shrinking.
+  const size_t rowsPerRow = size_t(1) << downScales;
+  const size_t destWidth = width >> downScales;
+  thread_local std::vector<__m128i> buffer;
+  buffer.resize(((width * rowsPerRow >> std::min(downScales, 3u)) + 15) / 16);
+  PixelTypes::GrayscaledPixel* rows = reinterpret_cast<PixelTypes::GrayscaledPixel*>(buffer.data());
+
+  shrinkYHorizontally(downScales, reinterpret_cast<const __m128i*>(src), width, rowsPerRow, rows);
+
+  // Average pairs of rows in the same order as shrinkY does. The last pair is written to the destination.
+  for(size_t n = rowsPerRow / 2; n; n /= 2)
+    for(size_t i = 0; i < n; ++i)
+    {
+      const PixelTypes::GrayscaledPixel* p0 = rows + 2 * i * destWidth;
+      const PixelTypes::GrayscaledPixel* p1 = p0 + destWidth;
+      PixelTypes::GrayscaledPixel* pDest = n == 1 ? dest : rows + i * destWidth;
+      size_t x = 0;
+      for(; x + 16 <= destWidth; x += 16)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + x),
+                         _mm_avg_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p0 + x)),
+                                      _mm_loadu_si128(reinterpret_cast<const __m128i*>(p1 + x))));
+      for(; x < destWidth; ++x)
+        pDest[x] = static_cast<PixelTypes::GrayscaledPixel>((p0[x] + p1[x] + 1) >> 1);
+    }
+}
+
 void Resize::shrinkUV(const unsigned int downScales, const Image<PixelTypes::YUYVPixel>& src, unsigned short* dest)
 {
   const size_t srcSize = src.width * src.height * 2;
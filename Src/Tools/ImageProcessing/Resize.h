@@ -22,6 +22,26 @@ namespace Resize
     shrinkY(downScales, src, dest[0]);
   }
 
+  /**
+   * Shrinks a grayscaled image like shrinkY, but one destination row at a time.
+   * Therefore, the destination only has to hold the downscaled image, e.g. it
+   * can be the input of a neural network.
+   * @param downScales How often the width and height are halved.
+   * @param src The image to shrink.
+   * @param dest The destination with space for the downscaled image.
+   */
+  void shrinkYRowwise(const unsigned int downScales, const Image<PixelTypes::GrayscaledPixel>& src, PixelTypes::GrayscaledPixel* dest);
+
+  /**
+   * Shrinks 2^downScales consecutive rows of a grayscaled image into a single
+   * row like shrinkY. This allows to shrink an image while it is created.
+   * @param downScales How often the width and height are halved.
+   * @param src The first pixel of the rows (16-byte aligned).
+   * @param width The width of the rows. It must be a multiple of 16.
+   * @param dest The destination with space for width / 2^downScales pixels.
+   */
+  void shrinkYRows(const unsigned int downScales, const PixelTypes::GrayscaledPixel* src, const unsigned int width, PixelTypes::GrayscaledPixel* dest);
+
   void shrinkUV(const unsigned int downScales, const Image<PixelTypes::YUYVPixel>& src, unsigned short* dest);
 
   inline void shrinkUV(const unsigned int downScales, const Image<PixelTypes::YUYVPixel>& src, Image<unsigned short>& dest)
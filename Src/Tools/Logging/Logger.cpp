@@ -13,9 +13,11 @@
 #include "Logger.h"
 #include "Platform/BHAssert.h"
 #include "Platform/SystemCall.h"
+#include "Platform/Time.h"
 #include "Representations/Communication/GameInfo.h"
 #include "Representations/Communication/TeamInfo.h"
 #include "Tools/Debugging/AnnotationManager.h"
+#include "Tools/Debugging/DebugDrawings.h"
 #include "Tools/Debugging/Debugging.h"
 #include "Tools/Debugging/Stopwatch.h"
 #include "Tools/Global.h"
@@ -139,6 +141,17 @@ void Logger::execute(const std::string& threadName)
     }
     logging = loggingNow;
 
+    DECLARE_PLOT("module:Logger:backlog");
+    DECLARE_PLOT("module:Logger:throughput");
+    DECLARE_PLOT("module:Logger:compressionRatio");
+    if(threadName == gameInfoThreadName)
+    {
+      SYNC;
+      PLOT("module:Logger:backlog", buffersToWrite.size());
+      PLOT("module:Logger:throughput", throughput);
+      PLOT("module:Logger:compressionRatio", compressionRatio);
+    }
+
     if(!logging && hasLogged && buffersToWrite.empty())
     {
       SystemCall::say("Log file written");
@@ -166,6 +179,7 @@ void Logger::execute(const std::string& threadName)
           return;
         }
 
+        const unsigned firstTimestamp = Time::getCurrentSystemTime();
         STOPWATCH("Logger")
         {
           buffer->out.bin << threadName;
@@ -190,9 +204,13 @@ void Logger::execute(const std::string& threadName)
         Global::getTimingManager().getData().copyAllMessages(*buffer);
         buffer->out.bin << threadName;
         buffer->out.finishMessage(idFrameFinished);
+        LoggingTools::ChunkHeader header;
+        header.thread = static_cast<unsigned char>(&rpt - representationsPerThread.data());
+        header.firstTimestamp = firstTimestamp;
+        header.lastTimestamp = Time::getCurrentSystemTime();
         {
           SYNC;
-          buffersToWrite.push_back(buffer);
+          buffersToWrite.push_back({buffer, header});
         }
         framesToWrite.post();
         hasLogged = true;
@@ -215,6 +233,7 @@ void Logger::writer()
 
   OutBinaryFile* file = nullptr;
   std::string completeFilename;
+  LoggingTools::LogIndex index;
 
   while(true)
   {
@@ -225,7 +244,7 @@ void Logger::writer()
       break;
 
     // This assumes that reading the front is threadsafe.
-    MessageQueue* buffer = buffersToWrite.front();
+    const Chunk chunk = buffersToWrite.front();
 
     if(!file)
     {
@@ -246,22 +265,91 @@ void Logger::writer()
       }
 
       *file << LoggingTools::logFileMessageIDs;
-      buffer->writeMessageIDs(*file);
+      chunk.buffer->writeMessageIDs(*file);
       *file << LoggingTools::logFileTypeInfo;
       file->write(typeInfo.data(), typeInfo.size());
-      *file << LoggingTools::logFileUncompressed;
-      buffer->writeAppendableHeader(*file);
+      *file << LoggingTools::logFileIndexed;
+
+      for(const RepresentationsPerThread& rpt : representationsPerThread)
+        index.threads.push_back(rpt.thread);
+      index.messageCounts.resize(numOfDataMessageIDs);
     }
 
-    buffer->append(*file);
-    buffer->clear();
+    write(*file, chunk, index);
+    chunk.buffer->clear();
 
     {
       SYNC;
       buffersToWrite.pop_front();
-      buffersAvailable.push(buffer);
+      buffersAvailable.push(chunk.buffer);
     }
   }
 
+  if(file && file->exists())
+    writeIndex(*file, index);
   delete file;
 }
+
+void Logger::write(Out& file, const Chunk& chunk, LoggingTools::LogIndex& index)
+{
+  LoggingTools::ChunkInfo info;
+  info.header = chunk.header;
+  info.header.compression = compression;
+  info.header.uncompressedSize = static_cast<unsigned>(chunk.buffer->getStreamedSize());
+  if(compression == LoggingTools::uncompressed)
+  {
+    info.header.size = info.header.uncompressedSize;
+    file << info.header << *chunk.buffer;
+  }
+  else
+  {
+    streamed.clear();
+    streamed << *chunk.buffer;
+    LoggingTools::compress(streamed.data(), streamed.size(), compressed, compression);
+    info.header.size = static_cast<unsigned>(compressed.size());
+    file << info.header;
+    file.write(compressed.data(), compressed.size());
+  }
+
+  // Update the statistics once per second.
+  bytesLogged += info.header.uncompressedSize;
+  bytesWritten += info.header.size;
+  const unsigned now = Time::getCurrentSystemTime();
+  if(now - statisticsStart >= 1000)
+  {
+    SYNC;
+    throughput = static_cast<float>(bytesLogged) / static_cast<float>(now - statisticsStart);
+    compressionRatio = static_cast<float>(bytesWritten) / static_cast<float>(bytesLogged);
+    statisticsStart = now;
+    bytesLogged = bytesWritten = 0;
+  }
+
+  class Counter : public MessageHandler
+  {
+  public:
+    LoggingTools::ChunkInfo& info;
+    std::vector<unsigned>& messageCounts;
+
+    Counter(LoggingTools::ChunkInfo& info, std::vector<unsigned>& messageCounts) : info(info), messageCounts(messageCounts) {}
+
+    bool handleMessage(InMessage& message) override
+    {
+      const unsigned char id = static_cast<unsigned char>(message.getMessageID());
+      info.messageIDs[id >> 3] |= 1 << (id & 7);
+      ++messageCounts[id];
+      return true;
+    }
+  } counter(info, index.messageCounts);
+  chunk.buffer->handleAllMessages(counter);
+  info.numOfMessages = chunk.buffer->getNumberOfMessages();
+  index.chunks.push_back(info);
+}
+
+void Logger::writeIndex(Out& file, const LoggingTools::LogIndex& index)
+{
+  OutBinaryMemory streamedIndex(1000000);
+  streamedIndex << index;
+  file << LoggingTools::ChunkHeader();
+  file.write(streamedIndex.data(), streamedIndex.size());
+  file << static_cast<unsigned>(streamedIndex.size()) << LoggingTools::logFileIndexed;
+}
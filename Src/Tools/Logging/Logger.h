@@ -15,6 +15,7 @@
 #include "Platform/Semaphore.h"
 #include "Platform/Thread.h"
 #include "Tools/Framework/Configuration.h"
+#include "Tools/Logging/LoggingTools.h"
 #include "Tools/MessageQueue/MessageQueue.h"
 #include "Tools/Streams/AutoStreamable.h"
 #include "Tools/Streams/InStreams.h"
@@ -44,22 +45,52 @@ private:
     (std::vector<Team>) teams,
   });
 
+  /** A buffer filled with log data together with the header of the chunk it will be written as. */
+  struct Chunk
+  {
+    MessageQueue* buffer; /**< The buffer containing the data. */
+    LoggingTools::ChunkHeader header; /**< The thread and the time span the data was logged in. */
+  };
+
   DECLARE_SYNC;
   OutBinaryMemory typeInfo; /**< Streamed type information created in main thread and used in logger thread. */
   TeamList teamList; /**< The list of all teams for naming the log file after the opponent. */
   std::vector<MessageQueue> buffers; /**< All buffers to write log data to. */
   std::stack<MessageQueue*> buffersAvailable; /**< The buffers currently available to fill with log data. */
-  std::deque<MessageQueue*> buffersToWrite; /**< The buffers already filled that need to be written. */
+  std::deque<Chunk> buffersToWrite; /**< The buffers already filled that need to be written. */
   char gameInfoThreadName[32]; /**< The thread that started logging and decides to stop it. */
   bool logging = false; /**< Are we currently logging? */
   bool hasLogged = false; /**< Have we logged before (reset when not logging and buffersToWrite is empty)? */
   std::string filename; /**< The base name of the log file. */
   Thread writerThread; /**< The thread that is writing the logged data to a file. */
   Semaphore framesToWrite; /**< How many frames the writer thread should write? */
+  OutBinaryMemory streamed; /**< The chunk currently written as streamed message queue (only used by the writer thread). */
+  std::vector<char> compressed; /**< The chunk currently written after compression (only used by the writer thread). */
+  unsigned statisticsStart = 0; /**< When did the writer thread start collecting the current statistics? */
+  size_t bytesLogged = 0; /**< Uncompressed bytes written since statisticsStart. */
+  size_t bytesWritten = 0; /**< Bytes actually written to the file since statisticsStart. */
+  float throughput = 0.f; /**< Uncompressed kB written per second, determined once per second. */
+  float compressionRatio = 1.f; /**< Written bytes per uncompressed byte, determined once per second. */
 
   /** The method runs in a separate thread and writes the logged data to a file. */
   void writer();
 
+  /**
+   * Writes a chunk to the log file and adds it to the index.
+   * The chunk is compressed as configured.
+   * @param file The log file.
+   * @param chunk The chunk to write.
+   * @param index The index of the log file.
+   */
+  void write(Out& file, const Chunk& chunk, LoggingTools::LogIndex& index);
+
+  /**
+   * Writes the end of the chunks and the index to the log file.
+   * @param file The log file.
+   * @param index The index of the log file.
+   */
+  static void writeIndex(Out& file, const LoggingTools::LogIndex& index);
+
 public:
   /**
    * The constructor reads the configuration file and checks it against the module configuration.
@@ -83,5 +114,6 @@ private:,
   (unsigned) sizeOfBuffer, /**< The size of each buffer in bytes. */
   (int) writePriority, /**< The scheduling priority of the writer thread. */
   (unsigned) minFreeDriveSpace, /**< Logging will stop if less MB are available to the target device. */
+  (LoggingTools::Compression)(LoggingTools::snappy) compression, /**< How the chunks of the log file are compressed. */
   (std::vector<RepresentationsPerThread>) representationsPerThread, /**< Representations to log per thread. */
 });
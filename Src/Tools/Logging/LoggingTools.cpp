@@ -8,7 +8,11 @@
 
 #include "LoggingTools.h"
 #include "Platform/BHAssert.h"
+#include "Platform/File.h"
+#include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/OutStreams.h"
 #include <regex>
+#include <snappy-c.h>
 
 std::string LoggingTools::createName(const std::string& prefix, const std::string& headName, const std::string& bodyName,
                                      const std::string& scenario, const std::string& location, const std::string& identifier,
@@ -75,3 +79,60 @@ void LoggingTools::parseName(const std::string& logfileName, std::string* prefix
       *suffix = match[3].matched ? match[3].str().substr(1) : "";
   }
 }
+
+bool LoggingTools::readIndex(InBinaryFile& stream, LogIndex& index)
+{
+  File& file = *stream.getFile();
+  const size_t fileSize = file.getSize();
+  if(fileSize < sizeof(unsigned) + 1)
+    return false;
+
+  // The footer consists of the size of the index and the magic byte.
+  file.setPosition(fileSize - sizeof(unsigned) - 1);
+  unsigned indexSize;
+  char magicByte;
+  stream >> indexSize >> magicByte;
+  if(magicByte != logFileIndexed || indexSize > fileSize - sizeof(unsigned) - 1)
+    return false;
+
+  const size_t indexPosition = fileSize - sizeof(unsigned) - 1 - indexSize;
+  file.setPosition(indexPosition);
+  stream >> index;
+
+  // The chunks are stored back to back in front of the terminating header.
+  OutBinaryMemory terminator(32);
+  terminator << ChunkHeader();
+  size_t chunksSize = terminator.size();
+  for(const ChunkInfo& chunk : index.chunks)
+    chunksSize += chunk.header.size + terminator.size();
+  if(chunksSize > indexPosition)
+    return false;
+
+  size_t position = indexPosition - chunksSize;
+  index.positions.clear();
+  index.positions.reserve(index.chunks.size());
+  for(const ChunkInfo& chunk : index.chunks)
+  {
+    index.positions.push_back(position);
+    position += chunk.header.size + terminator.size();
+  }
+  return true;
+}
+
+void LoggingTools::compress(const char* data, size_t size, std::vector<char>& compressed, Compression compression)
+{
+  ASSERT(compression == snappy);
+  size_t compressedSize = snappy_max_compressed_length(size);
+  compressed.resize(compressedSize);
+  VERIFY(snappy_compress(data, size, compressed.data(), &compressedSize) == SNAPPY_OK);
+  compressed.resize(compressedSize);
+}
+
+bool LoggingTools::decompress(const char* compressed, size_t compressedSize, char* data, size_t size)
+{
+  size_t uncompressedSize;
+  return snappy_uncompressed_length(compressed, compressedSize, &uncompressedSize) == SNAPPY_OK
+         && uncompressedSize == size
+         && snappy_uncompress(compressed, compressedSize, data, &uncompressedSize) == SNAPPY_OK
+         && uncompressedSize == size;
+}
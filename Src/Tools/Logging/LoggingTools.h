@@ -9,8 +9,13 @@
 
 #pragma once
 
+#include "Tools/Streams/AutoStreamable.h"
 #include "Tools/Streams/Enum.h"
+#include <cstring>
 #include <string>
+#include <vector>
+
+class InBinaryFile;
 
 namespace LoggingTools
 {
@@ -20,6 +25,61 @@ namespace LoggingTools
     logFileCompressed,
     logFileMessageIDs,
     logFileTypeInfo,
+    logFileIndexed,
+  });
+
+  /** How the chunks of a log file in the format logFileIndexed are compressed. */
+  ENUM(Compression,
+  {,
+    uncompressed,
+    snappy, /**< Each chunk is compressed with snappy. */
+  });
+
+  /**
+   * The header in front of each chunk of a log file in the format logFileIndexed.
+   * The chunk itself is a streamed message queue, which might be compressed. The chunks are followed by a
+   * header with size 0, the streamed LogIndex, its size as unsigned, and the magic
+   * byte logFileIndexed again. The index can therefore be found from the end of the
+   * file. Log files that were not closed properly simply end after the last chunk.
+   */
+  STREAMABLE(ChunkHeader,
+  {,
+    (unsigned)(0) size, /**< The size of the chunk following this header in bytes. 0 marks the end of all chunks. */
+    (Compression)(uncompressed) compression, /**< How the chunk is compressed. */
+    (unsigned)(0) uncompressedSize, /**< The size of the streamed message queue after decompressing the chunk. */
+    (unsigned char)(0) thread, /**< The index of the thread that logged the chunk in LogIndex::threads. */
+    (unsigned)(0) firstTimestamp, /**< The system time when the thread started to log the chunk. */
+    (unsigned)(0) lastTimestamp, /**< The system time when the thread finished to log the chunk. */
+  });
+
+  /** The index entry of a single chunk. */
+  STREAMABLE(ChunkInfo,
+  {
+    /**
+     * Does this chunk contain messages of a certain type?
+     * @param id The message id as used in the log file.
+     * @return Is there at least one message with this id?
+     */
+    bool contains(unsigned char id) const {return (messageIDs[id >> 3] >> (id & 7)) & 1;}
+
+    ChunkInfo()
+    {
+      std::memset(messageIDs, 0, sizeof(messageIDs));
+    },
+
+    (ChunkHeader) header, /**< A copy of the header of the chunk. */
+    (unsigned)(0) numOfMessages, /**< The number of messages in the chunk. */
+    (unsigned char[32]) messageIDs, /**< A bit for each message id contained in the chunk. */
+  });
+
+  /** The index stored at the end of a log file in the format logFileIndexed. */
+  STREAMABLE(LogIndex,
+  {
+    std::vector<size_t> positions; /**< The file position of each chunk header. Not streamed, but determined by readIndex(). */
+    ,
+    (std::vector<std::string>) threads, /**< The names of all threads referenced by the chunks. */
+    (std::vector<ChunkInfo>) chunks, /**< Information about all chunks in the order they appear in the file. */
+    (std::vector<unsigned>) messageCounts, /**< The number of messages per message id (as used in the log file). */
   });
 
   /**
@@ -54,4 +114,34 @@ namespace LoggingTools
    */
   void parseName(const std::string& logfileName, std::string* prefix, std::string* headName, std::string* bodyName,
                  std::string* scenario, std::string* location, std::string* identifier, int* playerNumber, std::string* suffix = nullptr);
+
+  /**
+   * Reads the index from the end of a log file in the format logFileIndexed and
+   * determines the file positions of all chunks. The position of the stream is
+   * changed by this function.
+   * @param stream The log file.
+   * @param index The index read. Only valid if this function returned true.
+   * @return Did the file contain an index?
+   */
+  bool readIndex(InBinaryFile& stream, LogIndex& index);
+
+  /**
+   * Compresses a block of data.
+   * @param data The data to compress.
+   * @param size The size of the data in bytes.
+   * @param compressed The compressed data. The vector is resized as required,
+   *                   but its capacity is kept, so it can be reused for the next block.
+   * @param compression The codec used. Must not be uncompressed.
+   */
+  void compress(const char* data, size_t size, std::vector<char>& compressed, Compression compression);
+
+  /**
+   * Decompresses a block of data that was compressed by compress().
+   * @param compressed The compressed data.
+   * @param compressedSize The size of the compressed data in bytes.
+   * @param data The buffer the decompressed data is written to.
+   * @param size The size of the decompressed data in bytes.
+   * @return Could the data be decompressed to exactly the given size?
+   */
+  bool decompress(const char* compressed, size_t compressedSize, char* data, size_t size);
 }
@@ -51,6 +51,17 @@ void MessageQueue::moveAllMessages(MessageQueue& other)
   clear();
 }
 
+void MessageQueue::moveAllMessages(OutMessage& out)
+{
+  for(int i = 0; i < queue.numberOfMessages; ++i)
+  {
+    queue.setSelectedMessageForReading(i);
+    out.bin.write(queue.getData(), queue.getMessageSize());
+    out.finishMessage(queue.getMessageID());
+  }
+  clear();
+}
+
 void MessageQueue::patchMessage(int message, int index, const std::string& value)
 {
   queue.setSelectedMessageForReading(message);
@@ -86,6 +86,13 @@ public:
    */
   void moveAllMessages(MessageQueue& other);
 
+  /**
+   * The method moves all messages from this queue to a queue that is only
+   * accessible through its interface for writing, e.g. Global::getDebugOut().
+   * @param out The interface for writing to the destination queue.
+   */
+  void moveAllMessages(OutMessage& out);
+
   /**
    * The method deletes older messages from the queue if newer messages of same type
    * are already in the queue. However, some message types remain untouched.
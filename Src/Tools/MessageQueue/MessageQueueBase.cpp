@@ -7,6 +7,7 @@
 
 #include "MessageQueueBase.h"
 #include "Platform/BHAssert.h"
+#include "Platform/Memory.h"
 #include "Tools/Streams/InOut.h"
 #include "Tools/Streams/InStreams.h"
 #include <algorithm>
@@ -31,7 +32,9 @@ MessageQueueBase::MessageQueueBase()
 MessageQueueBase::~MessageQueueBase()
 {
   freeIndex();
-  if(buf)
+  if(mapping)
+    Memory::unmapFile(mapping, mappingSize);
+  else if(buf)
     free(buf);
   if(mappedIDs)
   {
@@ -49,7 +52,7 @@ void MessageQueueBase::setSize(size_t size, size_t reserveForInfrastructure)
   ASSERT(buf);
 #else
   ASSERT(size >= usedSize);
-  if(size < reservedSize)
+  if(size < reservedSize && !mapping)
   {
     char* newBuf = static_cast<char*>(realloc(buf, size));
     if(newBuf)
@@ -79,6 +82,75 @@ void MessageQueueBase::clear()
     delete[] mappedIDNames;
   }
   freeIndex();
+  if(mapping)
+    unmap(16384);
+}
+
+void MessageQueueBase::removeAllMessages()
+{
+  usedSize = 0;
+  numberOfMessages = 0;
+  writePosition = 0;
+  writingOfLastMessageFailed = false;
+  selectedMessageForReadingPosition = 0;
+  readPosition = 0;
+  lastMessage = 0;
+  freeIndex();
+  if(mapping)
+    unmap(16384);
+}
+
+bool MessageQueueBase::map(const std::string& fileName, size_t offset)
+{
+  ASSERT(!numberOfMessages && !writePosition && !messageIndex);
+  size_t size;
+  char* newMapping = Memory::mapFile(fileName, size);
+  if(!newMapping)
+    return false;
+  else if(size < offset || size - offset > maximumSize)
+  {
+    Memory::unmapFile(newMapping, size);
+    return false;
+  }
+
+  if(mapping)
+    Memory::unmapFile(mapping, mappingSize);
+  else
+    free(buf);
+  mapping = newMapping;
+  mappingSize = size;
+  buf = mapping + offset;
+  reservedSize = size - offset;
+
+  // Count the messages, but ignore an incomplete message at the end.
+  usedSize = 0;
+  while(usedSize + headerSize <= reservedSize)
+  {
+    const size_t next = usedSize + headerSize + (*reinterpret_cast<unsigned*>(buf + usedSize) >> 8);
+    if(next > reservedSize)
+      break;
+    usedSize = next;
+    ++numberOfMessages;
+  }
+  selectedMessageForReadingPosition = 0;
+  readPosition = 0;
+  lastMessage = 0;
+  return true;
+}
+
+bool MessageQueueBase::unmap(size_t size)
+{
+  ASSERT(mapping && size >= usedSize);
+  char* newBuf = static_cast<char*>(malloc(size));
+  if(!newBuf)
+    return false;
+  memcpy(newBuf, buf, usedSize);
+  Memory::unmapFile(mapping, mappingSize);
+  mapping = nullptr;
+  mappingSize = 0;
+  buf = newBuf;
+  reservedSize = size;
+  return true;
 }
 
 void MessageQueueBase::createIndex()
@@ -142,7 +214,7 @@ char* MessageQueueBase::reserve(size_t size)
       r = maximumSize;
     if(r > reservedSize)
     {
-      char* newBuf = static_cast<char*>(realloc(buf, r));
+      char* newBuf = mapping ? (unmap(r) ? buf : nullptr) : static_cast<char*>(realloc(buf, r));
       if(newBuf)
       {
         buf = newBuf;
@@ -28,6 +28,8 @@ private:
   static constexpr int headerSize = 4; /**< The size of the header of each message in bytes. */
   static constexpr int queueHeaderSize = 2 * sizeof(unsigned); /**< The size of the header in a streamed queue. */
   char* buf = nullptr; /**< The buffer on that the queue works. */
+  char* mapping = nullptr; /**< The memory mapped file buf points into. nullptr if buf was allocated. */
+  size_t mappingSize = 0; /**< The size of the memory mapped file (in bytes). */
   size_t* messageIndex = 0; /**< An index of the beginnings of all messages. */
   unsigned char numOfMappedIDs = 0; /**< The number of ids in the translation table. If 0, there is no table. */
   MessageID* mappedIDs = nullptr; /**< The mapping of internal ids to external ids. */
@@ -69,6 +71,24 @@ public:
    */
   void clear();
 
+  /**
+   * The method removes all messages from the queue, but keeps the translation
+   * table of message ids and the memory allocated.
+   */
+  void removeAllMessages();
+
+  /**
+   * The method appends the messages stored in a file to an empty queue by
+   * mapping the file into memory instead of reading it. Therefore, the
+   * messages are only loaded when they are accessed and the operating system
+   * can drop them again. Changing messages only affects the memory, not the
+   * file. If messages are added, the queue is copied into allocated memory.
+   * @param fileName The full path of the file.
+   * @param offset The position in the file at which the first message starts.
+   * @return Could the file be mapped?
+   */
+  bool map(const std::string& fileName, size_t offset);
+
   /**
    * The method removes a message from the queue.
    * @param message The number of the message.
@@ -180,6 +200,13 @@ private:
    */
   char* reserve(size_t size);
 
+  /**
+   * Replaces the memory mapped file by allocated memory.
+   * @param size The number of bytes to allocate. Must be at least usedSize.
+   * @return Could the memory be allocated?
+   */
+  bool unmap(size_t size);
+
   /**
    * Creates an index of the beginnings of all messages.
    * Note that the index is not automatically updated if
@@ -14,7 +14,9 @@
 void UKFPose2D::motionUpdate(const Pose2f& odometryOffset, const Pose2f& filterProcessDeviation,
                              const Pose2f& odometryDeviation, const Vector2f& odometryRotationDeviation)
 {
-  generateSigmaPoints();
+  Matrix3f l;
+  Vector3f sigmaPoints[7];
+  generateSigmaPoints(l, sigmaPoints);
 
   // addOdometryToSigmaPoints
   for(int i = 0; i < 7; ++i)
@@ -57,7 +59,7 @@ void UKFPose2D::motionUpdate(const Pose2f& odometryOffset, const Pose2f& filterP
   mean.z() = Angle::normalize(mean.z());
 }
 
-void UKFPose2D::generateSigmaPoints()
+void UKFPose2D::generateSigmaPoints(Matrix3f& l, Vector3f sigmaPoints[7]) const
 {
   // Cholesky decomposition
   const float a11 = cov(0, 0);
@@ -67,6 +69,7 @@ void UKFPose2D::generateSigmaPoints()
   const float a32 = (cov(2, 1) + cov(1, 2)) * 0.5f;
   const float a33 = cov(2, 2);
 
+  l = Matrix3f::Zero();
   float& l11(l(0, 0));
   float& l21(l(1, 0));
   float& l31(l(2, 0));
@@ -97,7 +100,9 @@ void UKFPose2D::generateSigmaPoints()
 
 void UKFPose2D::landmarkSensorUpdate(const Vector2f& landmarkPosition, const Vector2f& reading, const Matrix2f& readingCov)
 {
-  generateSigmaPoints();
+  Matrix3f l;
+  Vector3f sigmaPoints[7];
+  generateSigmaPoints(l, sigmaPoints);
 
   // computeLandmarkReadings
   Vector2f landmarkReadings[7];
@@ -147,47 +152,18 @@ void UKFPose2D::landmarkSensorUpdate(const Vector2f& landmarkPosition, const Vec
 
 void UKFPose2D::lineSensorUpdate(bool vertical, const Vector2f& reading, const Matrix2f& readingCov)
 {
-  generateSigmaPoints();
-
-  // computeLineReadings
-  Vector2f lineReadings[7];
-  if(vertical)
-    for(int i = 0; i < 7; ++i)
-      lineReadings[i] = Vector2f(sigmaPoints[i].y(), sigmaPoints[i].z());
-  else
-    for(int i = 0; i < 7; ++i)
-      lineReadings[i] = Vector2f(sigmaPoints[i].x(), sigmaPoints[i].z());
-
-  // computeMeanOfLineReadings
-  Vector2f lineReadingMean = lineReadings[0];
-  for(int i = 1; i < 7; ++i)
-    lineReadingMean += lineReadings[i];
-  lineReadingMean *= 1.f / 7.f;
+  // The reading consists of one coordinate and the rotation.
+  const int coordinate = vertical ? 1 : 0;
 
-  // computeCovOfLineReadingsAndSigmaPoints
-  Matrix2x3f lineReadingAndMeanCov = Matrix2x3f::Zero();
-  for(int i = 0; i < 3; ++i)
-  {
-    const Vector2f d1 = lineReadings[i * 2 + 1] - lineReadingMean;
-    lineReadingAndMeanCov += (Matrix2x3f() << d1 * l(0, i), d1 * l(1, i), d1 * l(2, i)).finished();
-    const Vector2f d2 = lineReadings[i * 2 + 2] - lineReadingMean;
-    lineReadingAndMeanCov += (Matrix2x3f() << d2 * -l(0, i), d2 * -l(1, i), d2 * -l(2, i)).finished();
-  }
-  lineReadingAndMeanCov *= 0.5f;
+  // Covariance between the line reading and the state (H * cov) and of the line reading itself (H * cov * H^T)
+  Matrix2x3f lineReadingAndMeanCov;
+  lineReadingAndMeanCov << cov.row(coordinate), cov.row(2);
+  Matrix2f lineReadingCov;
+  lineReadingCov << lineReadingAndMeanCov(0, coordinate), lineReadingAndMeanCov(0, 2),
+                    lineReadingAndMeanCov(1, coordinate), lineReadingAndMeanCov(1, 2);
 
-  // computeCovOfLineReadingsReadings
-  const Vector2f d = lineReadings[0] - lineReadingMean;
-  Matrix2f lineReadingCov = (Matrix2f() << d * d.x(), d * d.y()).finished();
-  for(int i = 1; i < 7; ++i)
-  {
-    const Vector2f d = lineReadings[i] - lineReadingMean;
-    lineReadingCov += (Matrix2f() << d * d.x(), d * d.y()).finished();
-  }
-  lineReadingCov *= 0.5f;
-
-  lineReadingMean.y() = Angle::normalize(lineReadingMean.y());
   const Matrix3x2f kalmanGain = lineReadingAndMeanCov.transpose() * (lineReadingCov + readingCov).inverse();
-  Vector2f innovation = reading - lineReadingMean;
+  Vector2f innovation = reading - Vector2f(mean(coordinate), mean.z());
   innovation.y() = Angle::normalize(innovation.y());
   const Vector3f correction = kalmanGain * innovation;
   mean += correction;
@@ -198,48 +174,14 @@ void UKFPose2D::lineSensorUpdate(bool vertical, const Vector2f& reading, const M
 
 void UKFPose2D::poseSensorUpdate(const Vector3f& reading, const Matrix3f& readingCov)
 {
-  generateSigmaPoints();
-
-  // computePoseReadings
-  Vector3f poseReadings[7];
-  for(int i = 0; i < 7; ++i)
-    poseReadings[i] = sigmaPoints[i];
-
-  // computeMeanOfPoseReadings
-  Vector3f poseReadingMean = poseReadings[0];
-  for(int i = 1; i < 7; ++i)
-    poseReadingMean += poseReadings[i];
-  poseReadingMean *= 1.f / 7.f;
-
-  // computeCovOfPoseReadingsAndSigmaPoints
-  Matrix3f poseReadingAndMeanCov = Matrix3f::Zero();
-  for(int i = 0; i < 3; ++i)
-  {
-    const Vector3f d1 = poseReadings[i * 2 + 1] - poseReadingMean;
-    poseReadingAndMeanCov += (Matrix3f() << d1 * l(0, i), d1 * l(1, i), d1 * l(2, i)).finished();
-    const Vector3f d2 = poseReadings[i * 2 + 2] - poseReadingMean;
-    poseReadingAndMeanCov += (Matrix3f() << d2 * -l(0, i), d2 * -l(1, i), d2 * -l(2, i)).finished();
-  }
-  poseReadingAndMeanCov *= 0.5f;
-
-  // computeCovOfPoseReadingsReadings
-  Matrix3f poseReadingCov;
-  const Vector3f d = poseReadings[0] - poseReadingMean;
-  poseReadingCov << d * d.x(), d * d.y(), d * d.z();
-  for(int i = 1; i < 7; ++i)
-  {
-    const Vector3f d = poseReadings[i] - poseReadingMean;
-    poseReadingCov += (Matrix3f() << d * d.x(), d * d.y(), d * d.z()).finished();
-  }
-  poseReadingCov *= 0.5f;
-
-  poseReadingMean.z() = Angle::normalize(poseReadingMean.z());
-  const Matrix3f kalmanGain = poseReadingAndMeanCov.transpose() * (poseReadingCov + readingCov).inverse();
-  Vector3f innovation = reading - poseReadingMean;
+  // The reading is the state itself, i.e. the covariance between reading and state as well
+  // as the covariance of the reading are both cov.
+  const Matrix3f kalmanGain = cov.transpose() * (cov + readingCov).inverse();
+  Vector3f innovation = reading - mean;
   innovation.z() = Angle::normalize(innovation.z());
   const Vector3f correction = kalmanGain * innovation;
   mean += correction;
   mean.z() = Angle::normalize(mean.z());
-  cov -= kalmanGain * poseReadingAndMeanCov;
+  cov -= kalmanGain * cov;
   Covariance::fixCovariance(cov);
 }
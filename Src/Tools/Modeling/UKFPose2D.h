@@ -24,8 +24,6 @@ class UKFPose2D
 protected:
   Vector3f mean = Vector3f::Zero();   /**< The estimated pose in 2D. */
   Matrix3f cov = Matrix3f::Zero();    /**< The covariance matrix of the estimate. */
-  Vector3f sigmaPoints[7];            /**< Sigma points for updating the filter. */
-  Matrix3f l = Matrix3f::Zero();      /**< Last computed Cholesky decomposition. */
 
 public:
   /** Returns the internal representation of the state's mean as the commonly used Pose2f type
@@ -54,8 +52,11 @@ public:
                     const Pose2f& odometryDeviation, const Vector2f& odometryRotationDeviation);
 
 protected:
-  /** Computes the 7 sigma points (in the sigmaPoints array), based on the current content of cov */
-  void generateSigmaPoints();
+  /** Computes the 7 sigma points, based on the current content of cov
+   * @param l The Cholesky decomposition of cov is returned here.
+   * @param sigmaPoints The sigma points are returned here.
+   */
+  void generateSigmaPoints(Matrix3f& l, Vector3f sigmaPoints[7]) const;
 
   /** Pose update based on the measurement of a perceived landmark
   * @param landmarkPosition The model position of the landmark (in absolute field coordinates)
@@ -64,9 +65,17 @@ protected:
   */
   void landmarkSensorUpdate(const Vector2f& landmarkPosition, const Vector2f& reading, const Matrix2f& readingCov);
 
+  /** Pose update based on the measurement of a perceived line
+  * As the measurement is a linear function of the state, the update is computed in closed form
+  * (the unscented transform of a linear function is exact).
+  * @param vertical Does the reading contain the y coordinate (true) or the x coordinate (false)?
+  * @param reading The measured coordinate and rotation
+  * @param readingCov The covariance of the measurement
+  */
   void lineSensorUpdate(bool vertical, const Vector2f& reading, const Matrix2f& readingCov);
 
   /** Pose update based on the (somehow virtual) absolute measurement of the own pose
+  * As the measurement is the state itself, the update is computed in closed form.
   * @param reading The measured pose (in absolute field coordinates)
   * @param readingCov The covariance of the measurement (based on the relative measurement of some features indicating the absolute pose)
   */
@@ -45,6 +45,7 @@ private:
    */
   static void setInstance(Blackboard& instance);
   friend class ThreadFrame; /**< A thread is allowed to set the instance. */
+  friend class ModuleGraphRunner; /**< Worker threads of a thread use its instance. */
 
   /**
    * Retrieve the blackboard entry for the name of a representation.
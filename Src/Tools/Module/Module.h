@@ -120,6 +120,7 @@ private:
   const char* name; /**< The name of the module that can be created by this instance. */
   Category category; /**< The category of this module. */
   std::vector<Info> (*getModuleInfo)(); /**< A function that returns information about the requirements and provisions of the module. */
+  std::vector<const char*> (*getUsedRepresentations)(); /**< A function that returns the names of the representations the module uses. */
 
 protected:
   /**
@@ -134,9 +135,10 @@ public:
    * @param name The name of the module that can be created by this instance.
    * @param category The category of this module.
    * @param getModuleInfo The function that returns the module info.
+   * @param getUsedRepresentations The function that returns the representations used.
    */
-  ModuleBase(const char* name, Category category, std::vector<Info> (*getModuleInfo)()) noexcept :
-    next(first), name(name), category(category), getModuleInfo(getModuleInfo)
+  ModuleBase(const char* name, Category category, std::vector<Info> (*getModuleInfo)(), std::vector<const char*> (*getUsedRepresentations)()) noexcept :
+    next(first), name(name), category(category), getModuleInfo(getModuleInfo), getUsedRepresentations(getUsedRepresentations)
   {
     first = this;
   }
@@ -180,7 +182,7 @@ public:
    * @param getModuleInfo The function that returns the module info.
    */
   Module(const char* name, Category category, std::vector<ModuleBase::Info> (*getModuleInfo)()) noexcept :
-    ModuleBase(name, category, getModuleInfo)
+    ModuleBase(name, category, getModuleInfo, B::getUsedRepresentations)
   {}
 };
 
@@ -498,6 +500,19 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
 #define _MODULE_INFO__MODULE_DEFINES_PARAMETERS(...)
 #define _MODULE_INFO__MODULE_LOADS_PARAMETERS(...)
 
+/**
+ * The following macros generate the code that provides the names of all
+ * representations that are used. They filter out everything else.
+ * @param x The type name of a representation or the set of all parameters.
+ */
+#define _MODULE_USED(x) _MODULE_JOIN(_MODULE_USED_, x)
+#define _MODULE_USED_PROVIDES(type)
+#define _MODULE_USED_PROVIDES_WITHOUT_MODIFY(type)
+#define _MODULE_USED_REQUIRES(type)
+#define _MODULE_USED_USES(type) uses.emplace_back(#type);
+#define _MODULE_USED__MODULE_DEFINES_PARAMETERS(...)
+#define _MODULE_USED__MODULE_LOADS_PARAMETERS(...)
+
 /**
  * Assign message id for a representation.
  * @param type The type of the representation the id of which is assigned.
@@ -524,7 +539,8 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
       static_cast<BaseType&>(module)._the##type = &Blackboard::getInstance().alloc<type>(#type); \
     type& r(*static_cast<BaseType&>(module)._the##type); \
     BH_TRACE; \
-    STOPWATCH(#type) static_cast<BaseType&>(module).update(r); \
+    for(Stopwatch _stopwatch("plot:stopwatch:" #type, Tracer::provider); _stopwatch.isRunning();) \
+      static_cast<BaseType&>(module).update(r); \
     mod \
     if(static_cast<BaseType&>(module)._id##type != ::undefined) \
       DEBUG_RESPONSE("representation:" #type) OUTPUT(static_cast<BaseType&>(module)._id##type, bin, r); \
@@ -536,14 +552,14 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
  * @param n The number of entries in the third parameter.
  * @param ... The requirements, provided representations and parameter definitions.
  */
-#define _MODULE_I(name, n, header, ...) _MODULE_II(name, n, header, (_MODULE_PARAMETERS, __VA_ARGS__), (_MODULE_LOAD, __VA_ARGS__), (_MODULE_DECLARE, __VA_ARGS__), (_MODULE_FREE, __VA_ARGS__), (_MODULE_INFO, __VA_ARGS__), (__VA_ARGS__))
+#define _MODULE_I(name, n, header, ...) _MODULE_II(name, n, header, (_MODULE_PARAMETERS, __VA_ARGS__), (_MODULE_LOAD, __VA_ARGS__), (_MODULE_DECLARE, __VA_ARGS__), (_MODULE_FREE, __VA_ARGS__), (_MODULE_INFO, __VA_ARGS__), (_MODULE_USED, __VA_ARGS__), (__VA_ARGS__))
 
 /**
  * Generates the actual code of the module's base class.
  * It create all the code and fills in data from the requirements, representations,
  * provided, and parameters defined.
  */
-#define _MODULE_II(theName, n, header, params, load, declare, free, info, tail) \
+#define _MODULE_II(theName, n, header, params, load, declare, free, info, used, tail) \
   namespace theName##Module \
   { \
     _MODULE_ATTR_##n params \
@@ -570,6 +586,12 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
       _MODULE_ATTR_##n info \
       return infos; \
     } \
+    static std::vector<const char*> getUsedRepresentations() \
+    { \
+      std::vector<const char*> uses; \
+      _MODULE_ATTR_##n used \
+      return uses; \
+    } \
   private: \
     _MODULE_ATTR_##n declare \
   public: \
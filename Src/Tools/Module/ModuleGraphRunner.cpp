@@ -8,9 +8,37 @@
  */
 
 #include "ModuleGraphRunner.h"
+#include "Tools/Debugging/DebugRequest.h"
+#include "Tools/Debugging/Tracer.h"
 #ifdef TARGET_ROBOT
 #include "Platform/Time.h"
 #endif
+#include <algorithm>
+
+ModuleGraphRunner::ModuleGraphRunner(size_t numberOfThreads, unsigned numberOfWorkers, int priority) :
+  toReceive(numberOfThreads), toSend(numberOfThreads)
+{
+  for(ModuleBase* i = ModuleBase::first; i; i = i->next)
+    allModules.emplace(i->name, i);
+
+  for(unsigned i = 0; i < numberOfWorkers; ++i)
+  {
+    workers.emplace_back(priority);
+    workers.back().start(this, &ModuleGraphRunner::work);
+  }
+}
+
+ModuleGraphRunner::~ModuleGraphRunner()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    terminating = true;
+  }
+  changed.notify_all();
+  workers.clear();
+  workerDebugOuts.clear();
+  destroy();
+}
 
 void ModuleGraphRunner::destroy()
 {
@@ -57,10 +85,13 @@ void ModuleGraphRunner::update(In& stream)
       if(i.update && rp.representation == i.representation)
       {
         providers.emplace_back(i.representation, &m->second, i.update);
+        providers.back().pinned = isPinned(m->second);
         break;
       }
   }
 
+  determineDependencies();
+
   // Reset all blackboard entries that are now provided by a different module or no module anymore
   // Note: Needed to prevent function pointers from becoming invalid.
   for(const std::string& representation : values.representationsToReset)
@@ -82,30 +113,95 @@ void ModuleGraphRunner::update(In& stream)
   this->timestamp = 0; // Invalid until execute was called
 }
 
-void ModuleGraphRunner::execute()
+void ModuleGraphRunner::determineDependencies()
 {
-  // Execute all providers in the given sequence
+  std::unordered_map<std::string, Provider*> providerOf;
+  std::unordered_map<const Provider*, std::size_t> indexOf;
+  std::vector<std::vector<Provider*>> predecessors(providers.size());
+  std::size_t index = 0;
   for(Provider& p : providers)
   {
-    ASSERT(p.moduleState->required);
-    if(!p.moduleState->instance)
-      p.moduleState->instance = p.moduleState->module->createNew();
-#ifdef TARGET_ROBOT
-    unsigned timestamp = Time::getCurrentSystemTime();
-#endif
-    if(p.moduleState->instance)
-      p.update(*p.moduleState->instance);
-#ifdef TARGET_ROBOT
-    int duration = Time::getTimeSince(timestamp);
-    if(timestamp > 110000 &&
-       ((duration > 100 &&
-         !Global::getDebugRequestTable().isActive("representation:JPEGImage") &&
-         !Global::getDebugRequestTable().isActive("representation:CameraImage")) ||
-        duration > 500))
-      OUTPUT_ERROR("TIMING: providing " << p.representation << " took " << duration
-                   << " ms at " << timestamp / 1000 - 100 << " s after start");
-#endif
+    providerOf[p.representation] = &p;
+    indexOf[&p] = index++;
+    p.dependents.clear();
+    p.dependencies = 0;
+  }
+
+  std::unordered_map<const ModuleState*, Provider*> previousOfModule;
+  Provider* previousPinned = nullptr;
+  std::vector<Provider*> sincePinned;
+  index = 0;
+  for(Provider& p : providers)
+  {
+    std::vector<const char*> read = p.moduleState->module->getUsedRepresentations();
+    for(const ModuleBase::Info& i : p.moduleState->module->getModuleInfo())
+      if(!i.update)
+        read.push_back(i.representation);
+    for(const char* representation : read)
+    {
+      const auto q = providerOf.find(representation);
+      if(q != providerOf.end() && q->second != &p)
+      {
+        if(indexOf[q->second] < index)
+          predecessors[index].push_back(q->second);
+        else
+          predecessors[indexOf[q->second]].push_back(&p);
+      }
+    }
+
+    // Providers of the same module are executed in sequence, because they share the module's state.
+    Provider*& previous = previousOfModule[p.moduleState];
+    if(previous)
+      predecessors[index].push_back(previous);
+    previous = &p;
+
+    // Pinned providers separate the sequence into sections that are executed one after another.
+    if(previousPinned)
+      predecessors[index].push_back(previousPinned);
+    if(p.pinned)
+    {
+      predecessors[index].insert(predecessors[index].end(), sincePinned.begin(), sincePinned.end());
+      sincePinned.clear();
+      previousPinned = &p;
+    }
+    else
+      sincePinned.push_back(&p);
+    ++index;
+  }
+
+  index = 0;
+  for(Provider& p : providers)
+  {
+    std::vector<Provider*>& predecessorsOfP = predecessors[index++];
+    std::sort(predecessorsOfP.begin(), predecessorsOfP.end());
+    predecessorsOfP.erase(std::unique(predecessorsOfP.begin(), predecessorsOfP.end()), predecessorsOfP.end());
+    for(Provider* q : predecessorsOfP)
+      q->dependents.push_back(&p);
+    p.dependencies = static_cast<unsigned>(predecessorsOfP.size());
+  }
+}
+
+bool ModuleGraphRunner::isPinned(const ModuleState& moduleState)
+{
+  switch(moduleState.module->category)
+  {
+    case ModuleBase::infrastructure:
+    case ModuleBase::communication:
+    case ModuleBase::behaviorControl:
+      return true;
+    default:
+      return false;
   }
+}
+
+void ModuleGraphRunner::execute()
+{
+  // Execute all providers in the given sequence or in parallel if possible
+  if(!workers.empty() && timestamp && !Global::getDebugRequestTable().hasActiveRequests())
+    executeInParallel();
+  else
+    for(Provider& p : providers)
+      execute(p);
   BH_TRACE;
 
   if(!timestamp) // Configuration changed recently?
@@ -126,6 +222,101 @@ void ModuleGraphRunner::execute()
   }
 }
 
+void ModuleGraphRunner::execute(Provider& p)
+{
+  ASSERT(p.moduleState->required);
+  if(!p.moduleState->instance)
+    p.moduleState->instance = p.moduleState->module->createNew();
+#ifdef TARGET_ROBOT
+  unsigned timestamp = Time::getCurrentSystemTime();
+#endif
+  if(p.moduleState->instance)
+    p.update(*p.moduleState->instance);
+#ifdef TARGET_ROBOT
+  int duration = Time::getTimeSince(timestamp);
+  if(timestamp > 110000 &&
+     ((duration > 100 &&
+       !Global::getDebugRequestTable().isActive("representation:JPEGImage") &&
+       !Global::getDebugRequestTable().isActive("representation:CameraImage")) ||
+      duration > 500))
+    OUTPUT_ERROR("TIMING: providing " << p.representation << " took " << duration
+                 << " ms at " << timestamp / 1000 - 100 << " s after start");
+#endif
+}
+
+void ModuleGraphRunner::executeInParallel()
+{
+  // Constructing modules is not thread-safe, because they allocate blackboard entries.
+  for(Provider& p : providers)
+    if(!p.moduleState->instance)
+      p.moduleState->instance = p.moduleState->module->createNew();
+
+  globals = {Global::theAnnotationManager, Global::theSettings,
+             Global::theDebugRequestTable, Global::theDebugDataTable, Global::theDrawingManager,
+             Global::theDrawingManager3D, Global::theTimingManager, Global::theAsmjitRuntime,
+             &Blackboard::getInstance()};
+  Global::getDebugRequestTable().shared = true;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  finished = 0;
+  for(Provider& p : providers)
+    if(!(p.remaining = p.dependencies))
+      (p.pinned ? readyPinned : ready).push_back(&p);
+  changed.notify_all();
+
+  while(finished < providers.size())
+    if(!readyPinned.empty())
+      executeNext(lock, readyPinned);
+    else if(!ready.empty())
+      executeNext(lock, ready);
+    else
+      changed.wait(lock);
+
+  for(MessageQueue* debugOut : workerDebugOuts)
+    debugOut->moveAllMessages(Global::getDebugOut());
+  Global::getDebugRequestTable().shared = false;
+}
+
+void ModuleGraphRunner::executeNext(std::unique_lock<std::mutex>& lock, std::deque<Provider*>& queue)
+{
+  Provider& p = *queue.front();
+  queue.pop_front();
+  lock.unlock();
+  execute(p);
+  lock.lock();
+  for(Provider* dependent : p.dependents)
+    if(!--dependent->remaining)
+      (dependent->pinned ? readyPinned : ready).push_back(dependent);
+  ++finished;
+  changed.notify_all();
+}
+
+void ModuleGraphRunner::work()
+{
+  Tracer::setThreadName("Worker");
+  MessageQueue debugOut;
+  debugOut.setSize(workerDebugOutSize);
+  std::unique_lock<std::mutex> lock(mutex);
+  workerDebugOuts.push_back(&debugOut);
+  while(!terminating)
+    if(ready.empty())
+      changed.wait(lock);
+    else
+    {
+      Global::theAnnotationManager = globals.annotationManager;
+      Global::theDebugOut = &debugOut.out;
+      Global::theSettings = globals.settings;
+      Global::theDebugRequestTable = globals.debugRequestTable;
+      Global::theDebugDataTable = globals.debugDataTable;
+      Global::theDrawingManager = globals.drawingManager;
+      Global::theDrawingManager3D = globals.drawingManager3D;
+      Global::theTimingManager = globals.timingManager;
+      Global::theAsmjitRuntime = globals.asmjitRuntime;
+      Blackboard::setInstance(*globals.blackboard);
+      executeNext(lock, ready);
+    }
+}
+
 void ModuleGraphRunner::readPacket(In& stream, const std::size_t index)
 {
   unsigned timestamp;
@@ -9,9 +9,15 @@
 
 #pragma once
 
+#include "Platform/Thread.h"
 #include "Tools/Framework/Configuration.h"
+#include "Tools/Global.h"
+#include "Tools/MessageQueue/MessageQueue.h"
 #include "Tools/Module/ModuleGraphCreator.h"
 
+#include <condition_variable>
+#include <deque>
+#include <list>
 #include <vector>
 
 class In;
@@ -51,6 +57,10 @@ private:
     const char* representation; /**< The representation that will be provided. */
     ModuleState* moduleState; /**< The moduleState that will give access to the module that provides the information. */
     void (*update)(Streamable&); /**< The update handler within the module. */
+    bool pinned = false; /**< Must this provider be executed by the thread this runner belongs to? */
+    std::vector<Provider*> dependents; /**< The providers that must be executed after this one. */
+    unsigned dependencies = 0; /**< The number of providers that must be executed before this one. */
+    unsigned remaining = 0; /**< The number of providers that still must be executed before this one in the current frame. */
 
     /**
      * Constructor.
@@ -77,22 +87,51 @@ private:
   unsigned timestamp = 0; /**< The timestamp of the last module request. Communication is only possible if both sides use the same timestamp. */
   unsigned nextTimestamp = 0; /**< The next timestamp used to verify communication. */
 
+  static constexpr std::size_t workerDebugOutSize = 0x10000; /**< The size of the debug message queue of each worker in bytes. */
+
+  std::list<Thread> workers; /**< Additional threads that execute independent providers in parallel. */
+  std::mutex mutex; /**< Synchronizes the access to the members below. */
+  std::condition_variable changed; /**< Signals that providers became ready or were finished. */
+  std::deque<Provider*> ready; /**< The providers the dependencies of which were already executed in this frame. All workers share this queue instead of stealing work from each other, because a frame only has a few dozen providers. */
+  std::deque<Provider*> readyPinned; /**< The pinned providers the dependencies of which were already executed in this frame. */
+  std::size_t finished = 0; /**< The number of providers already executed in this frame. */
+  bool terminating = false; /**< Should the workers terminate? */
+  std::vector<MessageQueue*> workerDebugOuts; /**< The debug message queues of the workers. Their messages are moved to the queue of the thread this runner belongs to after each frame. */
+
+  /**
+   * The thread wide instances of the thread this runner belongs to. Its
+   * workers use them as well, except for the outgoing debug message queue,
+   * which is not thread-safe.
+   */
+  struct Globals
+  {
+    AnnotationManager* annotationManager;
+    Settings* settings;
+    DebugRequestTable* debugRequestTable;
+    DebugDataTable* debugDataTable;
+    DrawingManager* drawingManager;
+    DrawingManager3D* drawingManager3D;
+    TimingManager* timingManager;
+    asmjit::JitRuntime* asmjitRuntime;
+    Blackboard* blackboard;
+  } globals;
+
 public:
   /**
    * The constructor.
    * @param numberOfThreads The number of threads.
+   * @param numberOfWorkers The number of additional threads that execute independent
+   *                        providers in parallel. If 0, all providers are executed
+   *                        sequentially.
+   * @param priority The priority of the workers.
    */
-  ModuleGraphRunner(size_t numberOfThreads) : toReceive(numberOfThreads), toSend(numberOfThreads)
-  {
-    for(ModuleBase* i = ModuleBase::first; i; i = i->next)
-      allModules.emplace(i->name, i);
-  }
+  ModuleGraphRunner(size_t numberOfThreads, unsigned numberOfWorkers = 0, int priority = 0);
 
   /**
    * Destructor.
-   * Destructs all modules currently constructed.
+   * Stops the workers and destructs all modules currently constructed.
    */
-  ~ModuleGraphRunner() { destroy(); };
+  ~ModuleGraphRunner();
 
   /**
    * Returns whether a valid module configuration is present.
@@ -121,6 +160,15 @@ public:
 
   /**
    * The function executes all selected modules.
+   * If workers are available, providers that do not depend on each other
+   * are executed in parallel. However, this is only done while no debug
+   * requests are active, because most of the debugging infrastructure is
+   * not thread-safe. Debug messages that are written anyway, e.g. warnings,
+   * are collected per worker and appended to the outgoing debug message
+   * queue of this thread after the frame. Parallel execution is also not
+   * done in the first frame after the
+   * configuration has changed, because modules are constructed and
+   * representations are allocated in that frame.
    */
   void execute();
 
@@ -158,4 +206,57 @@ public:
   {
     return toSend[index].empty();
   }
+
+private:
+  /**
+   * The function determines which providers must be executed before which
+   * other providers, so that the results are the same as when executing
+   * them in sequence:
+   * - A provider is executed after the providers of representations its
+   *   module requires or uses that are earlier in the sequence.
+   * - A provider is executed before the providers of representations its
+   *   module uses that are later in the sequence, i.e. it reads them before
+   *   they are overwritten.
+   * - A provider is executed after the previous provider of the same module.
+   * - Pinned providers are executed after all previous providers and before
+   *   all later ones, because the side effects of their modules (e.g. of
+   *   cards or of the callbacks of message components) are not declared.
+   */
+  void determineDependencies();
+
+  /**
+   * The function determines whether a provider must be executed by the
+   * thread this runner belongs to. This is the case for all modules of
+   * categories that rely on thread wide state other than the one in the
+   * class Global, e.g. Cognition::isUpper, the instances of the card and
+   * skill registries, the instances of some infrastructure modules, the
+   * message handlers, and the callbacks of the message components.
+   * @param moduleState The state of the module of the provider.
+   * @return Must the provider be executed by the thread this runner belongs to?
+   */
+  static bool isPinned(const ModuleState& moduleState);
+
+  /**
+   * The function executes a single provider.
+   * @param provider The provider to execute.
+   */
+  void execute(Provider& provider);
+
+  /**
+   * The function executes the providers of the current frame in parallel
+   * with the workers and returns after all of them have been executed.
+   */
+  void executeInParallel();
+
+  /**
+   * The function executes the next ready provider and updates the state of
+   * all providers depending on it.
+   * @param lock The lock on the mutex. It is released while the provider
+   *             is executed.
+   * @param queue The queue the provider is taken from.
+   */
+  void executeNext(std::unique_lock<std::mutex>& lock, std::deque<Provider*>& queue);
+
+  /** The main function of the workers. */
+  void work();
 };
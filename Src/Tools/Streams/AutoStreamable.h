@@ -58,6 +58,11 @@
  *
  * In this example, all attributes except from anInt and aLetter would be initialized.
  *
+ * When streaming from or to a binary stream, attributes whose binary representation is identical
+ * to their representation in memory (see Streaming::IsRaw) are copied as a whole, and so are
+ * std::vectors of them. Such attributes are neither selected nor streamed value by value, but
+ * the data streamed is the same.
+ *
  * @author Thomas Röfer
  */
 
@@ -253,6 +258,9 @@
 /** Generate streaming code from declaration. */
 #define _STREAM_SER(seq) {auto& _var = _STREAM_VAR(seq); Streaming::streamIt(stream, #seq, _var);}
 
+/** Generate streaming code for binary streams from declaration. */
+#define _STREAM_SER_BIN(seq) {auto& _var = _STREAM_VAR(seq); Streaming::streamBinary(stream, #seq, _var);}
+
 /** Generate the actual declaration. */
 #define _STREAM_DECL(seq) decltype(Streaming::TypeWrapper<_STREAM_DECL_I seq))>::type) _STREAM_VAR(seq) _STREAM_INIT(seq);
 #define _STREAM_DECL_I(...) _STREAM_VAR(__VA_ARGS__) _STREAM_DROP(_STREAM_DROP(
@@ -273,8 +281,8 @@
   struct name : public base \
   _STREAM_UNWRAP header; \
   _STREAM_STREAMABLE_I(_STREAM_TUPLE_SIZE(__VA_ARGS__), name, base, readBase, writeBase, __VA_ARGS__)
-#define _STREAM_STREAMABLE_I(n, name, base, readBase, writeBase, ...) _STREAM_STREAMABLE_II(n, name, base, readBase, writeBase, (_STREAM_SER, __VA_ARGS__), (_STREAM_DECL, __VA_ARGS__), (_STREAM_REG, __VA_ARGS__))
-#define _STREAM_STREAMABLE_II(n, theName, base, readBase, writeBase, params1, params2, params3) \
+#define _STREAM_STREAMABLE_I(n, name, base, readBase, writeBase, ...) _STREAM_STREAMABLE_II(n, name, base, readBase, writeBase, (_STREAM_SER, __VA_ARGS__), (_STREAM_DECL, __VA_ARGS__), (_STREAM_REG, __VA_ARGS__), (_STREAM_SER_BIN, __VA_ARGS__))
+#define _STREAM_STREAMABLE_II(n, theName, base, readBase, writeBase, params1, params2, params3, params4) \
     _STREAM_ATTR_##n params2 \
   protected: \
     friend struct Streaming::OnRead<theName, true>; \
@@ -283,14 +291,28 @@
       static_cast<void>(stream); \
       PUBLISH(_reg); \
       readBase; \
-      _STREAM_ATTR_##n params1 \
+      if(stream.isBinary()) \
+      { \
+        _STREAM_ATTR_##n params4 \
+      } \
+      else \
+      { \
+        _STREAM_ATTR_##n params1 \
+      } \
       Streaming::onRead(*this); \
     } \
     void write(Out& stream) const override \
     { \
       static_cast<void>(stream); \
       writeBase; \
-      _STREAM_ATTR_##n params1 \
+      if(stream.isBinary()) \
+      { \
+        _STREAM_ATTR_##n params4 \
+      } \
+      else \
+      { \
+        _STREAM_ATTR_##n params1 \
+      } \
     } \
   private: \
     static void _reg() \
@@ -619,3 +619,18 @@ Out& operator<<(Out& stream, const Eigen::AngleAxis<T>& angleAxis)
 
   return stream;
 }
+
+namespace Streaming
+{
+  /**
+   * All streaming operators above write the coefficients of fixed-sized matrices in memory
+   * order, so matrices of raw elements are raw as well.
+   * @tparam T The type of the elements.
+   * @tparam ROWS The number of rows of the matrix.
+   * @tparam COLS The number of columns of the matrix.
+   * @tparam OPTIONS Mainly describes whether the matrix is row major or column major.
+   */
+  template<typename T, int ROWS, int COLS, int OPTIONS> struct IsRaw<Eigen::Matrix<T, ROWS, COLS, OPTIONS, ROWS, COLS>>
+    : std::integral_constant<bool, IsRaw<T>::value && ROWS != Eigen::Dynamic && COLS != Eigen::Dynamic &&
+                                   sizeof(Eigen::Matrix<T, ROWS, COLS, OPTIONS, ROWS, COLS>) == ROWS * COLS * sizeof(T)> {};
+}
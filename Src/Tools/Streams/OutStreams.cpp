@@ -306,6 +306,15 @@ void OutMemory::writeToStream(const void* p, size_t size)
   bytes += size;
 }
 
+void OutMemory::shrink(size_t capacity)
+{
+  if(dynamic && buffer && capacity < reserved && bytes <= capacity && capacity > 0)
+  {
+    buffer = reinterpret_cast<char*>(std::realloc(buffer, capacity));
+    reserved = capacity;
+  }
+}
+
 char* OutMemory::obtainData()
 {
   char* data = buffer;
@@ -761,6 +761,25 @@ public:
    */
   const char* data() const { return buffer; }
 
+  /**
+   * Discards all data written so far, but keeps the buffer, so that
+   * the stream can be filled again without allocating memory.
+   */
+  void clear() { bytes = 0; }
+
+  /**
+   * Returns the number of bytes currently reserved for the buffer.
+   */
+  size_t capacity() const { return reserved; }
+
+  /**
+   * Reduces the memory reserved for a dynamic buffer to the given capacity.
+   * Nothing happens if the buffer is not dynamic, already not larger, or if
+   * more bytes than the given capacity were already written.
+   * @param capacity The number of bytes that should remain reserved.
+   */
+  void shrink(size_t capacity);
+
   /**
    * Obtain ownership of the memory. The caller must free the memory.
    * This stream looses access to the memory.
@@ -13,6 +13,7 @@
 #include <array>
 #include <list>
 #include <optional>
+#include <type_traits>
 #include <vector>
 #include "InOut.h"
 #include "TypeRegistry.h"
@@ -437,6 +438,76 @@ namespace Streaming
     streamIt(stream, skipDot(name), s);
   }
 
+  /**
+   * Is the representation of a type in binary streams identical to its representation
+   * in memory? The binary fast path of STREAMABLE classes copies attributes of such
+   * types as a whole. bool is excluded, because reading arbitrary bytes into a bool is
+   * undefined. Enums are streamed as unsigned char or int, so only enums of these sizes
+   * qualify.
+   */
+  template<typename T> struct IsRaw : std::integral_constant<bool,
+    std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value ||
+    std::is_same<T, short>::value || std::is_same<T, unsigned short>::value ||
+    std::is_same<T, int>::value || std::is_same<T, unsigned int>::value ||
+    std::is_same<T, float>::value || std::is_same<T, double>::value ||
+    (std::is_enum<T>::value && (sizeof(T) == 1 || sizeof(T) == sizeof(int)))> {};
+  template<> struct IsRaw<Angle> : std::true_type {};
+  template<typename E, size_t N> struct IsRaw<E[N]> : IsRaw<E> {};
+  template<typename E, size_t n> struct IsRaw<std::array<E, n>> : std::integral_constant<bool, IsRaw<E>::value && sizeof(std::array<E, n>) == n * sizeof(E)> {};
+
+  /**
+   * Read an attribute of a STREAMABLE class from a binary stream. Raw attributes are
+   * read as a whole. All others are streamed normally.
+   */
+  template<typename S> void streamBinary(In& stream, const char* name, S& s)
+  {
+    if constexpr(IsRaw<S>::value)
+      stream.read(&s, sizeof(s));
+    else
+      streamIt(stream, name, s);
+  }
+
+  /** Read a vector from a binary stream. Vectors of raw elements are read as a whole. */
+  template<typename E, typename A> void streamBinary(In& stream, const char* name, std::vector<E, A>& s)
+  {
+    if constexpr(IsRaw<E>::value)
+    {
+      unsigned size;
+      stream.read(&size, sizeof(size));
+      s.resize(size);
+      if(!s.empty())
+        stream.read(s.data(), s.size() * sizeof(E));
+    }
+    else
+      streamIt(stream, name, s);
+  }
+
+  /**
+   * Write an attribute of a STREAMABLE class to a binary stream. Raw attributes are
+   * written as a whole. All others are streamed normally.
+   */
+  template<typename S> void streamBinary(Out& stream, const char* name, const S& s)
+  {
+    if constexpr(IsRaw<S>::value)
+      stream.write(&s, sizeof(s));
+    else
+      streamIt(stream, name, s);
+  }
+
+  /** Write a vector to a binary stream. Vectors of raw elements are written as a whole. */
+  template<typename E, typename A> void streamBinary(Out& stream, const char* name, const std::vector<E, A>& s)
+  {
+    if constexpr(IsRaw<E>::value)
+    {
+      const unsigned size = static_cast<unsigned>(s.size());
+      stream.write(&size, sizeof(size));
+      if(!s.empty())
+        stream.write(s.data(), s.size() * sizeof(E));
+    }
+    else
+      streamIt(stream, name, s);
+  }
+
   /**
    * Together with decltype, the following template allows to use any type
    * for declarations, even array types such as int[4]. It also works with
@@ -0,0 +1,45 @@
+/**
+ * @file Utils/LogReplayer/LogReplayer.cpp
+ *
+ * This file implements a robot that replays a log file without a GUI.
+ */
+
+#include "LogReplayer.h"
+#include "ReplayThread.h"
+#include "Threads/Debug.h"
+
+LogReplayer::LogReplayer(const Settings& settings, const std::string& logFile, const std::vector<std::string>& representations) :
+  Robot(settings, std::string())
+{
+  std::vector<std::string> threads;
+  for(const ThreadFrame* thread : *this)
+    threads.emplace_back(thread->getName());
+  replayThread = new ReplayThread(settings, std::string(), static_cast<Debug*>(front()), logFile, representations, threads);
+  push_back(replayThread);
+}
+
+bool LogReplayer::isOpen() const
+{
+  return replayThread->isOpen();
+}
+
+bool LogReplayer::run(unsigned timeout)
+{
+  DebugSenderBase::terminating = false;
+  start();
+  const bool completed = replayThread->waitForEnd(timeout);
+
+  // Threads blocking in sending to each other must give up while stopping.
+  DebugSenderBase::terminating = true;
+  announceStop();
+  stop();
+
+  if(!completed)
+    replayThread->writeStall(stderr);
+  return completed;
+}
+
+void LogReplayer::writeReport(FILE* file) const
+{
+  replayThread->writeReport(file);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file Utils/LogReplayer/LogReplayer.h
+ *
+ * This file declares a robot that replays a log file without a GUI.
+ */
+
+#pragma once
+
+#include "Tools/Framework/Robot.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class ReplayThread;
+
+/**
+ * @class LogReplayer
+ *
+ * The threads of a robot as configured in threads.cfg plus a thread that
+ * feeds them with the frames of a log file.
+ */
+class LogReplayer : public Robot
+{
+private:
+  ReplayThread* replayThread; /**< The thread that replays the log file. Owned by the thread list. */
+
+public:
+  /**
+   * The constructor.
+   * @param settings The settings for the robot.
+   * @param logFile The name of the log file to replay.
+   * @param representations The representations digests are created for.
+   */
+  LogReplayer(const Settings& settings, const std::string& logFile, const std::vector<std::string>& representations);
+
+  /**
+   * Could the log file be opened?
+   * @return Whether replaying is possible.
+   */
+  bool isOpen() const;
+
+  /**
+   * Runs all threads until the whole log file was processed.
+   * @param timeout The maximum time a thread may take to process a frame (in ms).
+   * @return Was the whole log file processed? If not, the threads that did
+   *         not acknowledge their last frame were written to stderr.
+   */
+  bool run(unsigned timeout);
+
+  /**
+   * Writes the timing histograms and digests collected.
+   * @param file The file to write to.
+   */
+  void writeReport(FILE* file) const;
+};
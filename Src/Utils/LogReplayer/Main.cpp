@@ -0,0 +1,81 @@
+/**
+ * @file Utils/LogReplayer/Main.cpp
+ *
+ * The main function of the LogReplayer. It replays a log file through the
+ * threads of the robot code as fast as possible and reports how long each
+ * provider took as well as digests of selected representations. This allows
+ * to detect changes in throughput and behavior on real data without SimRobot.
+ */
+
+#include "LogReplayer.h"
+#include "Platform/SystemCall.h"
+#include "Tools/FunctionList.h"
+#include "Tools/Settings.h"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+SystemCall::Mode SystemCall::getMode()
+{
+  return logFileReplay;
+}
+
+int main(int argc, char* argv[])
+{
+  std::string logFile;
+  std::string reportFile;
+  std::vector<std::string> representations;
+  int timeout = 60;
+  for(int i = 1; i < argc; ++i)
+    if(!strcmp(argv[i], "-r") && i + 1 < argc)
+      representations.emplace_back(argv[++i]);
+    else if(!strcmp(argv[i], "-t") && i + 1 < argc)
+      timeout = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-o") && i + 1 < argc)
+      reportFile = argv[++i];
+    else if(argv[i][0] != '-' && logFile.empty())
+      logFile = argv[i];
+    else
+    {
+      logFile.clear();
+      break;
+    }
+
+  if(logFile.empty() || timeout < 1)
+  {
+    fprintf(stderr, "Usage: %s [-r <representation>]... [-t <seconds>] [-o <report>] <log file>\n\
+    -r <representation>  create a digest of this representation (can be repeated)\n\
+    -t <seconds>         fail if a thread takes longer to process a frame (default: 60)\n\
+    -o <report>          write the report to this file instead of stdout\n\
+The working directory must be inside the B-Human directory.\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // Relative paths would otherwise be relative to the configuration directories.
+  logFile = std::filesystem::absolute(logFile).string();
+
+  FunctionList::execute();
+
+  LogReplayer logReplayer(Settings(logFile), logFile, representations);
+  if(!logReplayer.isOpen())
+  {
+    fprintf(stderr, "Cannot open log file %s\n", logFile.c_str());
+    return EXIT_FAILURE;
+  }
+  if(!logReplayer.run(static_cast<unsigned>(timeout) * 1000))
+  {
+    fprintf(stderr, "Replaying %s stalled\n", logFile.c_str());
+    return EXIT_FAILURE;
+  }
+
+  FILE* file = reportFile.empty() ? stdout : fopen(reportFile.c_str(), "w");
+  if(!file)
+  {
+    fprintf(stderr, "Cannot write %s\n", reportFile.c_str());
+    return EXIT_FAILURE;
+  }
+  logReplayer.writeReport(file);
+  if(file != stdout)
+    fclose(file);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,249 @@
+/**
+ * @file Utils/LogReplayer/ReplayThread.cpp
+ *
+ * This file implements the thread that feeds a log file into the threads of
+ * the robot code without a GUI.
+ */
+
+#include "ReplayThread.h"
+#include "Platform/Time.h"
+#include "Threads/Debug.h"
+#include "Tools/Debugging/DebugRequest.h"
+#include "Tools/Module/Module.h"
+#include <algorithm>
+
+ReplayThread::ReplayThread(const Settings& settings, const std::string& robotName, Debug* debug,
+                           const std::string& logFile, const std::vector<std::string>& representations,
+                           const std::vector<std::string>& threads) :
+  ThreadFrame(settings, robotName, connectReceiverWithRobot(debug, this), connectSenderWithRobot(debug)),
+  logPlayer(*debugSender)
+{
+  for(const std::string& thread : threads)
+    acknowledged[thread] = true;
+
+  for(const std::string& representation : representations)
+  {
+    const MessageID id = ModuleBase::getMessageID(representation);
+    if(id == undefined)
+      fprintf(stderr, "Warning: %s has no message id, no digest is created for it.\n", representation.c_str());
+    else
+      representationsById[id] = representation;
+  }
+
+  opened = logPlayer.open(logFile);
+  if(opened)
+  {
+    logPlayer.setLoop(false);
+    logPlayer.play();
+  }
+}
+
+void ReplayThread::init()
+{
+  // Debug forwards the requests to all threads. Keeping all messages avoids
+  // that Debug drops timing data when several threads send in the same frame.
+  std::vector<std::string> requests = {"debug:keepAllMessages", "timing"};
+  for(const auto& [id, representation] : representationsById)
+    requests.emplace_back("representation:" + representation);
+  for(const std::string& request : requests)
+  {
+    debugSender->out.bin << DebugRequest(request);
+    debugSender->out.finishMessage(idDebugRequest);
+  }
+  startTime = Time::getRealSystemTime();
+  lastProgress = startTime;
+}
+
+bool ReplayThread::main()
+{
+  const auto finish = [this]
+  {
+    duration = Time::getRealTimeSince(startTime);
+    finished = true;
+    finishedSignal.post();
+  };
+
+  // Send frames until the next one is meant for a thread that is still busy.
+  while(!finished)
+  {
+    const std::string nextThread = logPlayer.getThreadIdentifierOfNextFrame();
+    const auto thread = acknowledged.find(nextThread);
+    if(!opened || logPlayer.currentFrameNumber >= logPlayer.numberOfFrames - 1)
+      finish();
+    else if(thread == acknowledged.end())
+    {
+      // Nobody would acknowledge this frame.
+      if(skippedThreads.insert(nextThread).second)
+        fprintf(stderr, "Warning: Skipping the frames of thread \"%s\", which does not run.\n", nextThread.c_str());
+      logPlayer.skipFrame();
+      ++framesSkipped;
+    }
+    else if(!thread->second)
+      break;
+    else if(logPlayer.replay())
+    {
+      thread->second = false;
+      lastProgress = Time::getRealSystemTime();
+      ++framesReplayed;
+    }
+    else
+      finish();
+  }
+  debugSender->send(true);
+  return true;
+}
+
+bool ReplayThread::waitForEnd(unsigned timeout)
+{
+  // init() might not have been executed yet.
+  lastProgress = Time::getRealSystemTime();
+  while(!finishedSignal.wait(100))
+    if(Time::getRealTimeSince(lastProgress) > timeout)
+      return false;
+  return true;
+}
+
+void ReplayThread::writeStall(FILE* file) const
+{
+  for(const auto& [thread, acknowledgedFrame] : acknowledged)
+    if(!acknowledgedFrame)
+      fprintf(file, "Thread \"%s\" did not acknowledge frame %d.\n", thread.c_str(), logPlayer.currentFrameNumber);
+}
+
+bool ReplayThread::handleMessage(InMessage& message)
+{
+  switch(message.getMessageID())
+  {
+    case idFrameBegin:
+      threadIdentifier = message.readThreadIdentifier();
+      return true;
+    case idFrameFinished:
+      return true;
+    case idLogResponse:
+    {
+      const auto thread = acknowledged.find(threadIdentifier);
+      if(thread != acknowledged.end())
+      {
+        thread->second = true;
+        lastProgress = Time::getRealSystemTime();
+      }
+      return true;
+    }
+    case idStopwatch:
+      addTiming(message);
+      return true;
+    case idText:
+      fprintf(stderr, "%s\n", message.text.readAll().c_str());
+      return true;
+    default:
+    {
+      const auto representation = representationsById.find(message.getMessageID());
+      if(representation != representationsById.end())
+      {
+        Digest& digest = digests[threadIdentifier][representation->second];
+        std::vector<unsigned char> data(message.getMessageSize());
+        message.bin.read(data.data(), data.size());
+        for(unsigned char byte : data)
+          digest.hash = (digest.hash ^ byte) * 1099511628211ull;
+        ++digest.count;
+      }
+      return true;
+    }
+  }
+}
+
+void ReplayThread::addTiming(InMessage& message)
+{
+  Timing& timing = timings[threadIdentifier];
+  unsigned short nameCount;
+  message.bin >> nameCount;
+  for(unsigned short i = 0; i < nameCount; ++i)
+  {
+    unsigned short watchId;
+    std::string watchName;
+    message.bin >> watchId >> watchName;
+    timing.names[watchId] = watchName;
+  }
+
+  unsigned short dataCount;
+  message.bin >> dataCount;
+  for(unsigned short i = 0; i < dataCount; ++i)
+  {
+    unsigned short watchId;
+    unsigned time;
+    message.bin >> watchId >> time;
+
+    // The TimingManager reports 0 for stopwatches that did not run in this frame.
+    if(time)
+      timing.samples[watchId].push_back(time);
+  }
+}
+
+void ReplayThread::writeReport(FILE* file) const
+{
+  fprintf(file, "# replay\nframes\tskipped\tduration\tframesPerSecond\n%u\t%u\t%u\t%.1f\n", framesReplayed, framesSkipped, duration,
+          duration ? static_cast<double>(framesReplayed) * 1000. / duration : 0.);
+
+  fprintf(file, "\n# timing (in us, histogram buckets are powers of 2)\nthread\tstopwatch\tcount\tmean\tmin\tp50\tp90\tp99\tmax\thistogram\n");
+  for(const auto& [thread, timing] : timings)
+  {
+    std::map<std::string, std::vector<unsigned>> samplesByName;
+    for(const auto& [watchId, samples] : timing.samples)
+    {
+      const auto name = timing.names.find(watchId);
+      samplesByName[name != timing.names.end() ? name->second : "#" + std::to_string(watchId)] = samples;
+    }
+
+    for(auto& [name, samples] : samplesByName)
+    {
+      std::sort(samples.begin(), samples.end());
+      unsigned long long sum = 0;
+      for(unsigned sample : samples)
+        sum += sample;
+      const auto percentile = [&samples = samples](size_t p) { return samples[std::min(samples.size() - 1, samples.size() * p / 100)]; };
+
+      fprintf(file, "%s\t%s\t%zu\t%.1f\t%u\t%u\t%u\t%u\t%u\t", thread.c_str(), name.c_str(), samples.size(),
+              static_cast<double>(sum) / samples.size(), samples.front(), percentile(50), percentile(90), percentile(99), samples.back());
+
+      // Bucket b counts the samples in [2^b, 2^(b+1)). Only non-empty buckets are listed.
+      std::vector<unsigned> histogram;
+      for(unsigned sample : samples)
+      {
+        unsigned bucket = 0;
+        while(sample >>= 1)
+          ++bucket;
+        if(histogram.size() <= bucket)
+          histogram.resize(bucket + 1);
+        ++histogram[bucket];
+      }
+      bool first = true;
+      for(size_t bucket = 0; bucket < histogram.size(); ++bucket)
+        if(histogram[bucket])
+        {
+          fprintf(file, "%s%u:%u", first ? "" : ",", 1u << bucket, histogram[bucket]);
+          first = false;
+        }
+      fprintf(file, "\n");
+    }
+  }
+
+  fprintf(file, "\n# digests\nthread\trepresentation\tcount\tdigest\n");
+  for(const auto& [thread, digestsOfThread] : digests)
+    for(const auto& [representation, digest] : digestsOfThread)
+      fprintf(file, "%s\t%s\t%u\t%016llx\n", thread.c_str(), representation.c_str(), digest.count, digest.hash);
+}
+
+DebugReceiver<MessageQueue>* ReplayThread::connectReceiverWithRobot(Debug* debug, ThreadFrame* thread)
+{
+  ASSERT(!debug->debugSender);
+  DebugReceiver<MessageQueue>* receiver = new DebugReceiver<MessageQueue>(thread, debug->getName());
+  debug->debugSender = new DebugSender<MessageQueue>(*receiver, "ReplayThread");
+  return receiver;
+}
+
+DebugSender<MessageQueue>* ReplayThread::connectSenderWithRobot(Debug* debug)
+{
+  ASSERT(!debug->debugReceiver);
+  debug->debugReceiver = new DebugReceiver<MessageQueue>(debug, "ReplayThread");
+  return new DebugSender<MessageQueue>(*debug->debugReceiver, debug->getName());
+}
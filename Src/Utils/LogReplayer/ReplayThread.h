@@ -0,0 +1,153 @@
+/**
+ * @file Utils/LogReplayer/ReplayThread.h
+ *
+ * This file declares the thread that feeds a log file into the threads of
+ * the robot code without a GUI and collects the timing of all stopwatches
+ * as well as digests of selected representations.
+ */
+
+#pragma once
+
+#include "Platform/Semaphore.h"
+#include "Tools/Framework/ThreadFrame.h"
+
+#include "Controller/LogPlayer.h" // Must be included after ThreadFrame.h
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Debug;
+
+/**
+ * @class ReplayThread
+ *
+ * The thread replays a log file frame by frame. As in LocalRobot, a frame is
+ * only sent after the thread it is meant for acknowledged its previous
+ * frame, i.e. there is never more than one frame in flight per thread. This
+ * keeps the replay reproducible while it still runs as fast as the modules
+ * can process the data. Frames of threads that do not run are skipped.
+ */
+class ReplayThread : public ThreadFrame
+{
+private:
+  /** The timing of all stopwatches of a thread. */
+  struct Timing
+  {
+    std::unordered_map<unsigned short, std::string> names; /**< The names of the stopwatches. */
+    std::unordered_map<unsigned short, std::vector<unsigned>> samples; /**< All measurements per stopwatch (in µs). */
+  };
+
+  /** A digest of all messages of a representation a thread sent. */
+  struct Digest
+  {
+    unsigned long long hash = 14695981039346656037ull; /**< 64 bit FNV-1a hash of all messages. */
+    unsigned count = 0; /**< The number of messages hashed. */
+  };
+
+  LogPlayer logPlayer; /**< The log file replayed. */
+  std::unordered_map<MessageID, std::string> representationsById; /**< The names of these representations by their message ids. */
+  std::string threadIdentifier; /**< The thread the messages currently received are from. */
+  std::map<std::string, bool> acknowledged; /**< Did each thread that runs acknowledge the last frame sent to it? */
+  std::set<std::string> skippedThreads; /**< The threads in the log file that do not run. */
+  bool opened; /**< Could the log file be opened? */
+  bool finished = false; /**< Was the whole log file processed? */
+  Semaphore finishedSignal; /**< Is posted when the whole log file was processed. */
+  std::atomic<unsigned> lastProgress{0}; /**< When was a frame sent or acknowledged the last time (real time in ms)? Also read by the thread waiting for the end. */
+  unsigned framesReplayed = 0; /**< The number of frames sent to the robot code. */
+  unsigned framesSkipped = 0; /**< The number of frames of threads that do not run. */
+  unsigned startTime = 0; /**< When did the replay start (real time in ms)? */
+  unsigned duration = 0; /**< How long did the replay take (in ms)? */
+  std::map<std::string, Timing> timings; /**< The timing per thread. */
+  std::map<std::string, std::map<std::string, Digest>> digests; /**< The digests per thread and representation. */
+
+public:
+  /**
+   * The constructor.
+   * @param settings The settings of the robot.
+   * @param robotName The name of the robot.
+   * @param debug The debug thread of the robot.
+   * @param logFile The name of the log file to replay.
+   * @param representations The representations digests are created for.
+   * @param threads The names of the threads that run.
+   */
+  ReplayThread(const Settings& settings, const std::string& robotName, Debug* debug,
+               const std::string& logFile, const std::vector<std::string>& representations,
+               const std::vector<std::string>& threads);
+
+  /**
+   * Could the log file be opened?
+   * @return Whether replaying is possible.
+   */
+  bool isOpen() const { return opened; }
+
+  /**
+   * Waits until the whole log file was processed.
+   * @param timeout The maximum time between a frame being sent and it being
+   *                acknowledged (in ms).
+   * @return Was the whole log file processed? If not, the replay stalled,
+   *         e.g. because a thread has no LogDataProvider or hangs.
+   */
+  bool waitForEnd(unsigned timeout);
+
+  /**
+   * Writes the threads that did not acknowledge their last frame. The robot
+   * code, including this thread, must have been stopped when this is called,
+   * because the acknowledgements are only synchronized by joining it.
+   * @param file The file to write to.
+   */
+  void writeStall(FILE* file) const;
+
+  /**
+   * Writes the timing histograms and digests. The robot code, including this
+   * thread, must have been stopped when this is called.
+   * @param file The file to write to.
+   */
+  void writeReport(FILE* file) const;
+
+protected:
+  int getPriority() const override { return 0; }
+
+  /** Sends the debug requests required to collect the data. */
+  void init() override;
+
+  /**
+   * Replays the next frame if the previous one was processed.
+   * @return Should wait for external trigger?
+   */
+  bool main() override;
+
+  void terminate() override {}
+
+  /**
+   * The function is called for every incoming debug message.
+   * @param message An interface to read the message from the queue.
+   * @return Has the message been handled?
+   */
+  bool handleMessage(InMessage& message) override;
+
+private:
+  /**
+   * The function connects the robot to the returned receiver.
+   * @param debug The debug thread of the robot.
+   * @param thread This thread.
+   * @return The receiver connected to the robot.
+   */
+  static DebugReceiver<MessageQueue>* connectReceiverWithRobot(Debug* debug, ThreadFrame* thread);
+
+  /**
+   * The function connects the robot to the returned sender.
+   * @param debug The debug thread of the robot.
+   * @return The sender connected to the robot.
+   */
+  static DebugSender<MessageQueue>* connectSenderWithRobot(Debug* debug);
+
+  /**
+   * Adds the measurements of a stopwatch message to the timing of the current thread.
+   * @param message The message. Its format is defined in TimingManager::prepareData.
+   */
+  void addTiming(InMessage& message);
+};
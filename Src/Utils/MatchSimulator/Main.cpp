@@ -0,0 +1,286 @@
+/**
+ * @file Utils/MatchSimulator/Main.cpp
+ *
+ * The main function of the MatchSimulator. It plays a series of headless 2D
+ * matches between two scenarios faster than real time and reports goals,
+ * possession and timing statistics. Matches run in separate processes, so
+ * that several of them can be played in parallel and a crashing or hanging
+ * robot code only spoils a single match.
+ */
+
+#include "Match.h"
+#include "Platform/SystemCall.h"
+#include "Platform/Thread.h"
+#include "Platform/Time.h"
+#include "Tools/FunctionList.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#ifndef WINDOWS
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+SystemCall::Mode SystemCall::getMode()
+{
+  return simulatedRobot;
+}
+
+#ifdef WINDOWS
+/**
+ * Plays a match in the current process.
+ * @param options The parameters of the match.
+ * @return The statistics of the match.
+ */
+static Match::Result play(const Match::Options& options)
+{
+  Match match(options);
+  return match.run();
+}
+#endif
+
+/**
+ * Plays all matches. Under Windows, they are played one after another.
+ * @param options The parameters of the matches. The seed and the kick-off
+ *                alternate between the matches.
+ * @param numOfMatches The number of matches.
+ * @param numOfJobs The maximum number of matches played at the same time.
+ * @param timeout Matches still running after this many seconds are killed and count as failed.
+ *                Not supported under Windows.
+ * @return The statistics of all matches.
+ */
+static std::vector<Match::Result> playAll(Match::Options options, int numOfMatches, int numOfJobs, int timeout)
+{
+  std::vector<Match::Result> results(numOfMatches);
+  const unsigned seed = options.seed;
+#ifdef WINDOWS
+  static_cast<void>(numOfJobs);
+  static_cast<void>(timeout);
+  for(int i = 0; i < numOfMatches; ++i)
+  {
+    options.seed = seed + i;
+    options.firstTeamKicksOff = i % 2 == 0;
+    results[i] = play(options);
+    fprintf(stderr, "Match %d %s\n", i + 1, results[i].completed ? "finished" : "failed");
+  }
+#else
+  // Each job slot has its own team ports, so that parallel matches do not listen to each other.
+  struct Job
+  {
+    pid_t pid = 0;
+    int pipe = -1;
+    int match = -1;
+    unsigned startTime = 0;
+    bool killed = false;
+  };
+  std::vector<Job> jobs(numOfJobs);
+  const int teamPort = options.teamPort;
+  int next = 0;
+  int running = 0;
+  while(next < numOfMatches || running > 0)
+  {
+    if(next < numOfMatches && running < numOfJobs)
+    {
+      const int slot = static_cast<int>(std::find_if(jobs.begin(), jobs.end(), [](const Job& job) {return job.pid == 0;}) - jobs.begin());
+      options.seed = seed + next;
+      options.firstTeamKicksOff = next % 2 == 0;
+      options.teamPort = teamPort + 2 * slot;
+      int fds[2];
+      if(pipe(fds) != 0)
+      {
+        perror("pipe");
+        exit(EXIT_FAILURE);
+      }
+      const pid_t pid = fork();
+      if(pid < 0)
+      {
+        perror("fork");
+        exit(EXIT_FAILURE);
+      }
+      else if(pid == 0)
+      {
+        // The match is never deleted, because stopping the threads of the robot code might hang.
+        // They end with the process instead.
+        close(fds[0]);
+        Match* match = new Match(options);
+        const Match::Result result = match->run();
+        _exit(write(fds[1], &result, sizeof(result)) == sizeof(result) ? EXIT_SUCCESS : EXIT_FAILURE);
+      }
+      close(fds[1]);
+      jobs[slot].pid = pid;
+      jobs[slot].pipe = fds[0];
+      jobs[slot].match = next++;
+      jobs[slot].startTime = Time::getRealSystemTime();
+      jobs[slot].killed = false;
+      ++running;
+    }
+    else
+    {
+      // Kill matches that take too long. They are reaped like all others.
+      for(Job& job : jobs)
+        if(job.pid != 0 && !job.killed && Time::getRealTimeSince(job.startTime) > timeout * 1000)
+        {
+          kill(job.pid, SIGKILL);
+          job.killed = true;
+        }
+
+      int status;
+      const pid_t pid = waitpid(-1, &status, WNOHANG);
+      if(pid < 0)
+      {
+        perror("waitpid");
+        exit(EXIT_FAILURE);
+      }
+      else if(pid == 0)
+      {
+        Thread::sleep(100);
+        continue;
+      }
+      for(Job& job : jobs)
+        if(job.pid == pid)
+        {
+          // The result is smaller than the buffer of the pipe, so it is already complete.
+          Match::Result& result = results[job.match];
+          if(job.killed || read(job.pipe, &result, sizeof(result)) != sizeof(result))
+            result = Match::Result();
+          close(job.pipe);
+          fprintf(stderr, "Match %d %s\n", job.match + 1, job.killed ? "timed out" : result.completed ? "finished" : "failed");
+          job = Job();
+          --running;
+        }
+    }
+  }
+#endif
+  return results;
+}
+
+/**
+ * Writes one line per match and a summary from the perspective of the first team.
+ * @param file The file to write to.
+ * @param options The parameters of the matches.
+ * @param results The statistics of all matches.
+ */
+static void writeReport(FILE* file, const Match::Options& options, const std::vector<Match::Result>& results)
+{
+  fprintf(file, "match\tseed\tgoalsA\tgoalsB\tpossessionA\tpossessionB\tterritoryA\tterritoryB\tkicksA\tkicksB\tsetPlaysA\tsetPlaysB\tpenaltiesA\tpenaltiesB\tsimulatedTime\trealTime\tcompleted\n");
+  int completed = 0;
+  int wins = 0;
+  int draws = 0;
+  float goals[2] = {0.f, 0.f};
+  float possession = 0.f;
+  float sumOfDifferences = 0.f;
+  float sumOfSquaredDifferences = 0.f;
+  float simulatedTime = 0.f;
+  float realTime = 0.f;
+  for(size_t i = 0; i < results.size(); ++i)
+  {
+    const Match::Result& r = results[i];
+    fprintf(file, "%d\t%u\t%d\t%d\t%.1f\t%.1f\t%.1f\t%.1f\t%d\t%d\t%d\t%d\t%d\t%d\t%.1f\t%.1f\t%d\n",
+            static_cast<int>(i + 1), options.seed + static_cast<unsigned>(i), r.goals[0], r.goals[1],
+            r.possession[0], r.possession[1], r.territory[0], r.territory[1], r.kicks[0], r.kicks[1],
+            r.setPlays[0], r.setPlays[1], r.penalties[0], r.penalties[1], r.simulatedTime, r.realTime, r.completed ? 1 : 0);
+    if(!r.completed)
+      continue;
+    ++completed;
+    wins += r.goals[0] > r.goals[1] ? 1 : 0;
+    draws += r.goals[0] == r.goals[1] ? 1 : 0;
+    goals[0] += static_cast<float>(r.goals[0]);
+    goals[1] += static_cast<float>(r.goals[1]);
+    const float difference = static_cast<float>(r.goals[0] - r.goals[1]);
+    sumOfDifferences += difference;
+    sumOfSquaredDifferences += difference * difference;
+    if(r.possession[0] + r.possession[1] > 0.f)
+      possession += r.possession[0] / (r.possession[0] + r.possession[1]);
+    simulatedTime += r.simulatedTime;
+    realTime += r.realTime;
+  }
+
+  fprintf(file, "# %s vs. %s, %d vs. %d players, %d s per half\n", options.scenarios[0].c_str(), options.scenarios[1].c_str(),
+          options.playersPerTeam, options.playersPerTeam, options.halfDuration);
+  fprintf(file, "# completed: %d of %d\n", completed, static_cast<int>(results.size()));
+  if(completed == 0)
+    return;
+  const float n = static_cast<float>(completed);
+  const float meanDifference = sumOfDifferences / n;
+  const float variance = completed > 1 ? (sumOfSquaredDifferences - n * meanDifference * meanDifference) / (n - 1.f) : 0.f;
+  fprintf(file, "# wins/draws/losses: %d/%d/%d\n", wins, draws, completed - wins - draws);
+  fprintf(file, "# mean goals: %.2f : %.2f\n", goals[0] / n, goals[1] / n);
+  fprintf(file, "# mean goal difference: %.2f +- %.2f\n", meanDifference, std::sqrt(std::max(variance, 0.f) / n));
+  fprintf(file, "# mean possession: %.1f%%\n", 100.f * possession / n);
+  fprintf(file, "# speedup: %.1f (%.1f s simulated in %.1f s)\n", realTime > 0.f ? simulatedTime / realTime : 0.f, simulatedTime, realTime);
+}
+
+int main(int argc, char* argv[])
+{
+  Match::Options options;
+  int numOfMatches = 1;
+  int numOfJobs = 1;
+  int timeout = 0;
+  std::string reportFile;
+  bool valid = true;
+  for(int i = 1; i < argc && valid; ++i)
+    if(!strcmp(argv[i], "-n") && i + 1 < argc)
+      numOfMatches = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-j") && i + 1 < argc)
+      numOfJobs = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-p") && i + 1 < argc)
+      options.playersPerTeam = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-t") && i + 1 < argc)
+      options.halfDuration = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-s") && i + 1 < argc)
+      options.seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+    else if(!strcmp(argv[i], "-a") && i + 1 < argc)
+      options.scenarios[0] = argv[++i];
+    else if(!strcmp(argv[i], "-b") && i + 1 < argc)
+      options.scenarios[1] = argv[++i];
+    else if(!strcmp(argv[i], "-l") && i + 1 < argc)
+      options.location = argv[++i];
+    else if(!strcmp(argv[i], "-w") && i + 1 < argc)
+      timeout = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-o") && i + 1 < argc)
+      reportFile = argv[++i];
+    else
+      valid = false;
+
+  if(!valid || numOfMatches < 1 || numOfJobs < 1 || timeout < 0 || options.playersPerTeam < 1 || options.playersPerTeam > 5 ||
+     options.halfDuration < 1 || options.halfDuration > GameController::halfTime)
+  {
+    fprintf(stderr, "Usage: %s [-n <matches>] [-j <jobs>] [-p <players>] [-t <seconds>] [-s <seed>] [-a <scenario>] [-b <scenario>] [-l <location>] [-w <seconds>] [-o <report>]\n\
+    -n <matches>   the number of matches to play (default: 1)\n\
+    -j <jobs>      the number of matches played in parallel (default: 1)\n\
+    -p <players>   the number of players per team, 1 ... 5 (default: 5)\n\
+    -t <seconds>   the playing time per half, 1 ... %d (default: %d)\n\
+    -s <seed>      the seed of the first match, the others count up (default: 0)\n\
+    -a <scenario>  the scenario of the first team (default: 2D)\n\
+    -b <scenario>  the scenario of the second team (default: 2D)\n\
+    -l <location>  the location of both teams (default: Default)\n\
+    -w <seconds>   kill matches that run longer, they count as failed\n\
+                   (default: the duration of a match in real time plus a minute)\n\
+    -o <report>    write the report to this file instead of stdout\n\
+The scenarios must run the Cognition2D thread. The working directory must be inside the B-Human directory.\n",
+            argv[0], GameController::halfTime, GameController::halfTime);
+    return EXIT_FAILURE;
+  }
+
+  // Matches are played faster than real time, so exceeding the real time of a match means that it hangs.
+  if(timeout == 0)
+    timeout = 2 * options.halfDuration + 60;
+
+  FunctionList::execute();
+
+  const std::vector<Match::Result> results = playAll(options, numOfMatches, numOfJobs, timeout);
+
+  FILE* file = reportFile.empty() ? stdout : fopen(reportFile.c_str(), "w");
+  if(!file)
+  {
+    fprintf(stderr, "Cannot write %s\n", reportFile.c_str());
+    return EXIT_FAILURE;
+  }
+  writeReport(file, options, results);
+  if(file != stdout)
+    fclose(file);
+  return EXIT_SUCCESS;
+}
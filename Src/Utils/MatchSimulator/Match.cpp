@@ -0,0 +1,388 @@
+/**
+ * @file Utils/MatchSimulator/Match.cpp
+ *
+ * This file implements a headless 2D match between two teams.
+ */
+
+#include "Match.h"
+#include "MatchPlayer.h"
+#include "Platform/BHAssert.h"
+#include "Platform/Time.h"
+#include "Tools/Framework/Communication.h"
+#include "Tools/Math/Random.h"
+#include "Tools/Settings.h"
+#include "Tools/Streams/InStreams.h"
+#include <algorithm>
+
+/**
+ * Pushes a disc out of a line segment or a point.
+ * @param position The center of the disc. It is moved if the disc overlaps with the segment.
+ * @param radius The radius of the disc.
+ * @param from The start of the segment.
+ * @param to The end of the segment. It is the same as the start for a point.
+ * @param normal The direction from the segment to the disc after the collision.
+ * @return Did the disc overlap with the segment?
+ */
+static bool pushOut(Vector2f& position, float radius, const Vector2f& from, const Vector2f& to, Vector2f& normal)
+{
+  const Vector2f direction = to - from;
+  const float squaredLength = direction.squaredNorm();
+  const float t = squaredLength > 0.f ? std::clamp((position - from).dot(direction) / squaredLength, 0.f, 1.f) : 0.f;
+  const Vector2f offset = position - (from + direction * t);
+  const float distance = offset.norm();
+  if(distance >= radius || distance == 0.f)
+    return false;
+  normal = offset / distance;
+  position += normal * (radius - distance);
+  return true;
+}
+
+/**
+ * Removes the part of a velocity that points into a surface, i.e. the
+ * collision is completely inelastic.
+ * @param velocity The velocity relative to the surface.
+ * @param normal The normal of the surface.
+ * @return The change of the velocity.
+ */
+static Vector2f stopAt(const Vector2f& velocity, const Vector2f& normal)
+{
+  const float normalVelocity = velocity.dot(normal);
+  return normalVelocity < 0.f ? Vector2f(-normal * normalVelocity) : Vector2f::Zero();
+}
+
+Match::Match(const Options& options) :
+  options(options)
+{
+  ASSERT(options.playersPerTeam >= 1 && options.playersPerTeam < GameController::numOfRobots / 2);
+
+  Time::initialize();
+  Time::setSimulatedTime(true);
+
+  gameController.setTeamInfos(Settings::black, Settings::blue);
+  gameController.setBall(*this);
+
+  // The poses of the first team in Game2D.ros2d. The second team is mirrored.
+  static const Pose2f firstTeamPoses[] =
+  {
+    Pose2f(90_deg, 3.9f, -3.f),
+    Pose2f(72.43_deg, 2.25f, -3.f),
+    Pose2f(104_deg, 0.75f, -3.f),
+    Pose2f(-104_deg, 0.75f, 3.f),
+    Pose2f(-72.43_deg, 2.25f, 3.f)
+  };
+  for(int team = 0; team < 2; ++team)
+    for(int number = 1; number <= options.playersPerTeam; ++number)
+    {
+      initialPoses.push_back(team == 0 ? firstTeamPoses[number - 1] : Pose2f(pi) + firstTeamPoses[number - 1]);
+      players.push_back(new MatchPlayer(*this,
+                                        Settings("Nao", "Nao", team + 1, team == 0 ? Settings::black : Settings::blue, number,
+                                                 options.location, options.scenarios[team], options.teamPort + team, 0),
+                                        gameController, initialPoses.back()));
+    }
+
+  // The players have set the file search path.
+  fieldDimensions.load();
+  {
+    InMapFile stream("ballSpecification.cfg");
+    ASSERT(stream.exists());
+    stream >> ballSpecification;
+  }
+
+  const float xBorder = fieldDimensions.xPosOpponentFieldBorder * 0.001f;
+  const float yBorder = fieldDimensions.yPosLeftFieldBorder * 0.001f;
+  walls.push_back({Vector2f(xBorder, yBorder), Vector2f(-xBorder, yBorder)});
+  walls.push_back({Vector2f(-xBorder, yBorder), Vector2f(-xBorder, -yBorder)});
+  walls.push_back({Vector2f(-xBorder, -yBorder), Vector2f(xBorder, -yBorder)});
+  walls.push_back({Vector2f(xBorder, -yBorder), Vector2f(xBorder, yBorder)});
+  for(float side : {-1.f, 1.f})
+  {
+    const float xPost = side * fieldDimensions.xPosOpponentGoalPost * 0.001f;
+    const float xNetFront = xPost + side * fieldDimensions.goalPostRadius * 0.001f;
+    const float xNetBack = side * fieldDimensions.xPosOpponentGoal * 0.001f;
+    const float yPost = fieldDimensions.yPosLeftGoal * 0.001f;
+    goalPosts.emplace_back(xPost, yPost);
+    goalPosts.emplace_back(xPost, -yPost);
+    walls.push_back({Vector2f(xNetFront, yPost), Vector2f(xNetBack, yPost)});
+    walls.push_back({Vector2f(xNetBack, yPost), Vector2f(xNetBack, -yPost)});
+    walls.push_back({Vector2f(xNetBack, -yPost), Vector2f(xNetFront, -yPost)});
+  }
+
+  for(auto& team : lastPenalties)
+    team.fill(PENALTY_NONE);
+
+  // Only the simulation itself is reproducible. The robot code has its own random generators.
+  Random::getGenerator().seed(options.seed);
+}
+
+Match::~Match()
+{
+  // Threads blocking in sending to each other must give up while stopping.
+  DebugSenderBase::terminating = true;
+  for(MatchPlayer* player : players)
+    player->announceStop();
+  for(MatchPlayer* player : players)
+  {
+    player->stop();
+    delete player;
+  }
+}
+
+const Match::Result& Match::run()
+{
+  const unsigned startTime = Time::getRealSystemTime();
+  DebugSenderBase::terminating = false;
+  for(MatchPlayer* player : players)
+    player->start();
+
+  result.completed = waitForPlayers() && playHalf(true) && playHalf(false);
+
+  result.goals[0] = gameController.getTeamInfo(true).score;
+  result.goals[1] = gameController.getTeamInfo(false).score;
+  result.realTime = static_cast<float>(Time::getRealTimeSince(startTime)) * 0.001f;
+  return result;
+}
+
+void Match::kick(const MatchPlayer& player, const Vector2f& velocity)
+{
+  ballVelocity = velocity;
+  touch(player);
+  if(gameController.getGameInfo().state == STATE_PLAYING)
+    ++result.kicks[player.isFirstTeam() ? 0 : 1];
+}
+
+void Match::getPosition(Vector2f& ballPosition) const
+{
+  ballPosition = this->ballPosition * 1000.f;
+}
+
+void Match::move(const Vector3f& pos, bool resetDynamics)
+{
+  ballPosition = pos.head<2>() * 0.001f;
+  if(resetDynamics)
+    ballVelocity = Vector2f::Zero();
+}
+
+bool Match::playHalf(bool firstHalf)
+{
+  if(!firstHalf)
+    command("initial");
+  command(firstHalf ? "firstHalf" : "secondHalf");
+  command(firstHalf == options.firstTeamKicksOff ? "kickOffFirstTeam" : "kickOffSecondTeam");
+  for(size_t i = 0; i < players.size(); ++i)
+    players[i]->place(initialPoses[i]);
+  ballPosition = ballVelocity = Vector2f::Zero();
+  lastTouch = -1;
+  command("ready");
+
+  for(;;)
+  {
+    if(!step())
+      return false;
+
+    // The remaining time is only updated when the game info is sent to the players.
+    if(GameController::halfTime - gameController.getGameInfo().secsRemaining >= options.halfDuration)
+    {
+      command("finished");
+      return true;
+    }
+  }
+}
+
+bool Match::waitForPlayers()
+{
+  GroundTruthWorldState worldState;
+  getWorldState(worldState);
+  for(MatchPlayer* player : players)
+    player->sendFrame(worldState);
+
+  // The first frames are ignored while the modules are still constructed.
+  const unsigned startTime = Time::getRealSystemTime();
+  std::vector<bool> ready(players.size(), false);
+  while(std::find(ready.begin(), ready.end(), false) != ready.end())
+  {
+    if(Time::getRealTimeSince(startTime) > static_cast<int>(startupTimeout))
+      return false;
+    for(size_t i = 0; i < players.size(); ++i)
+      if(!ready[i])
+      {
+        ready[i] = players[i]->receiveMotionRequest(100);
+        if(!ready[i])
+          players[i]->resendFrame();
+      }
+  }
+
+  // Copies of the first frame that are still processed are ignored by the
+  // players, because the next frames have different sequence numbers.
+  return true;
+}
+
+bool Match::step()
+{
+  const float stepDuration = static_cast<float>(stepLength) * 0.001f;
+
+  gameController.referee();
+
+  GroundTruthWorldState worldState;
+  getWorldState(worldState);
+  for(MatchPlayer* player : players)
+    player->sendFrame(worldState);
+  for(MatchPlayer* player : players)
+    if(!player->receiveMotionRequest(frameTimeout))
+      return false;
+
+  for(MatchPlayer* player : players)
+    player->executeMotionRequest(stepDuration);
+  movePlayers();
+  moveBall();
+
+  Time::addSimulatedTime(stepLength);
+  updateStatistics(stepDuration);
+  return true;
+}
+
+void Match::movePlayers()
+{
+  const float stepDuration = static_cast<float>(stepLength) * 0.001f;
+  for(MatchPlayer* player : players)
+    player->integrate(stepDuration);
+
+  for(size_t i = 0; i < players.size(); ++i)
+    for(size_t j = i + 1; j < players.size(); ++j)
+    {
+      const Vector2f offset = players[j]->getPose().translation - players[i]->getPose().translation;
+      const float distance = offset.norm();
+      if(distance < 2.f * robotRadius)
+      {
+        const Vector2f push = (distance > 0.f ? Vector2f(offset / distance) : Vector2f(1.f, 0.f)) * (robotRadius - distance * 0.5f);
+        players[i]->setPosition(players[i]->getPose().translation - push);
+        players[j]->setPosition(players[j]->getPose().translation + push);
+      }
+    }
+
+  const float goalPostRadius = fieldDimensions.goalPostRadius * 0.001f;
+  for(MatchPlayer* player : players)
+  {
+    Vector2f position = player->getPose().translation;
+    Vector2f normal;
+    for(const Vector2f& goalPost : goalPosts)
+      pushOut(position, robotRadius + goalPostRadius, goalPost, goalPost, normal);
+    for(const Segment& wall : walls)
+      pushOut(position, robotRadius, wall.from, wall.to, normal);
+    player->setPosition(position);
+  }
+}
+
+void Match::moveBall()
+{
+  const float stepDuration = static_cast<float>(stepLength) * 0.001f;
+  const float ballSpeed = ballVelocity.norm();
+  const float newBallSpeed = ballSpeed + ballSpecification.friction * stepDuration;
+  if(newBallSpeed <= 0.f)
+    ballVelocity = Vector2f::Zero();
+  else
+    ballVelocity *= newBallSpeed / ballSpeed;
+  ballPosition += ballVelocity * stepDuration;
+
+  // The ball only collides with the legs of the players, which form a rectangle.
+  const float ballRadius = ballSpecification.radius * 0.001f;
+  const Vector2f legsMin(-0.03f, -0.1f);
+  const Vector2f legsMax(0.11f, 0.1f);
+  for(const MatchPlayer* player : players)
+  {
+    const Pose2f& pose = player->getPose();
+    const Vector2f relative = pose.inverse() * ballPosition;
+    const Vector2f closest = relative.cwiseMax(legsMin).cwiseMin(legsMax);
+    Vector2f normal = relative - closest;
+    float distance = normal.norm();
+    if(distance >= ballRadius)
+      continue;
+    if(distance > 0.f)
+      normal /= distance;
+    else
+    {
+      // The center is inside the legs. Leave through the nearest side.
+      const float penetrations[] = {relative.x() - legsMin.x(), legsMax.x() - relative.x(), relative.y() - legsMin.y(), legsMax.y() - relative.y()};
+      const int side = static_cast<int>(std::min_element(std::begin(penetrations), std::end(penetrations)) - std::begin(penetrations));
+      normal = side < 2 ? Vector2f(side == 0 ? -1.f : 1.f, 0.f) : Vector2f(0.f, side == 2 ? -1.f : 1.f);
+      distance = -penetrations[side];
+    }
+    ballPosition = pose * Vector2f(relative + normal * (ballRadius - distance));
+    normal.rotate(pose.rotation);
+
+    // The legs are much heavier than the ball, i.e. they are not slowed down.
+    const Vector2f contact = ballPosition - pose.translation;
+    const Vector2f legsVelocity = player->getVelocity() + Vector2f(-contact.y(), contact.x()) * player->getAngularVelocity();
+    ballVelocity += stopAt(ballVelocity - legsVelocity, normal);
+    touch(*player);
+  }
+
+  Vector2f normal;
+  const float goalPostRadius = fieldDimensions.goalPostRadius * 0.001f;
+  for(const Vector2f& goalPost : goalPosts)
+    if(pushOut(ballPosition, ballRadius + goalPostRadius, goalPost, goalPost, normal))
+      ballVelocity += stopAt(ballVelocity, normal);
+  for(const Segment& wall : walls)
+    if(pushOut(ballPosition, ballRadius, wall.from, wall.to, normal))
+      ballVelocity += stopAt(ballVelocity, normal);
+}
+
+void Match::updateStatistics(float stepDuration)
+{
+  result.simulatedTime += stepDuration;
+
+  const RawGameInfo& gameInfo = gameController.getGameInfo();
+  if(gameInfo.state == STATE_PLAYING)
+  {
+    if(lastTouch >= 0)
+      result.possession[lastTouch] += stepDuration;
+
+    // The first team plays towards the negative x axis of the scene.
+    result.territory[ballPosition.x() < 0.f ? 0 : 1] += stepDuration;
+
+    if(gameInfo.setPlay != SET_PLAY_NONE && gameInfo.setPlay != lastSetPlay)
+      ++result.setPlays[gameInfo.kickingTeam == gameController.getTeamInfo(true).teamNumber ? 0 : 1];
+  }
+  lastSetPlay = gameInfo.setPlay;
+
+  for(int team = 0; team < 2; ++team)
+    for(int i = 0; i < options.playersPerTeam; ++i)
+    {
+      const uint8_t penalty = gameController.getTeamInfo(team == 0).players[i].penalty;
+      if(penalty != PENALTY_NONE && penalty != PENALTY_SUBSTITUTE && lastPenalties[team][i] == PENALTY_NONE)
+        ++result.penalties[team];
+      lastPenalties[team][i] = penalty;
+    }
+}
+
+void Match::getWorldState(GroundTruthWorldState& worldState) const
+{
+  worldState.firstTeamPlayers.clear();
+  worldState.secondTeamPlayers.clear();
+  worldState.balls.clear();
+
+  GroundTruthWorldState::GroundTruthBall ball;
+  ball.position = Vector3f(ballPosition.x(), ballPosition.y(), 0.05f) * 1000.f;
+  ball.velocity = Vector3f(ballVelocity.x(), ballVelocity.y(), 0.f) * 1000.f;
+  worldState.balls.push_back(ball);
+
+  for(const MatchPlayer* player : players)
+  {
+    GroundTruthWorldState::GroundTruthPlayer gtPlayer;
+    gtPlayer.number = player->getNumber();
+    gtPlayer.pose = Pose2f(player->getPose().rotation, player->getPose().translation * 1000.f);
+    gtPlayer.upright = true;
+    (player->isFirstTeam() ? worldState.firstTeamPlayers : worldState.secondTeamPlayers).push_back(gtPlayer);
+  }
+}
+
+void Match::touch(const MatchPlayer& player)
+{
+  lastTouch = player.isFirstTeam() ? 0 : 1;
+  gameController.setLastBallContactRobot(player.isFirstTeam(), player.getPose().translation * 1000.f);
+}
+
+void Match::command(const std::string& command)
+{
+  InConfigMemory stream(command.c_str(), command.size());
+  VERIFY(gameController.handleGlobalConsole(stream));
+}
@@ -0,0 +1,175 @@
+/**
+ * @file Utils/MatchSimulator/Match.h
+ *
+ * This file declares a headless 2D match between two teams that is
+ * simulated as fast as the robot code can process its frames.
+ */
+
+#pragma once
+
+#include "Controller/GameController.h"
+#include "Representations/Configuration/BallSpecification.h"
+#include "Representations/Configuration/FieldDimensions.h"
+#include "Representations/Infrastructure/GroundTruthWorldState.h"
+#include <array>
+#include <string>
+#include <vector>
+
+class MatchPlayer;
+
+/**
+ * @class Match
+ *
+ * The class simulates a match in the same abstraction as the 2D scenes of
+ * SimRobot, but without a physics engine and without a GUI. Players are
+ * discs that are moved by the motion emulation of SimulatedRobot2D, the
+ * ball rolls with constant deceleration and stops at the legs of the
+ * players, the goal posts, the goal nets, and the border of the carpet.
+ * The simulation only advances after all players processed their frames,
+ * so the result does not depend on how fast the computer is.
+ */
+class Match : public GameController::Ball
+{
+public:
+  /** The parameters of a match. */
+  struct Options
+  {
+    int playersPerTeam = 5; /**< The number of players per team [1 ... 5]. */
+    int halfDuration = GameController::halfTime; /**< The playing time per half (in s). */
+    unsigned seed = 0; /**< The seed of the random numbers of the simulation. */
+    bool firstTeamKicksOff = true; /**< Has the first team the kick-off in the first half? */
+    std::string location = "Default"; /**< The location of both teams. */
+    std::array<std::string, 2> scenarios = {{"2D", "2D"}}; /**< The scenarios of the first and the second team. */
+    int teamPort = 20001; /**< The team port of the first team. The second team uses the next one. */
+  };
+
+  /** The statistics of a match. Per team, the first team comes first. */
+  struct Result
+  {
+    bool completed = false; /**< Was the match played until the end? */
+    std::array<int, 2> goals = {{0, 0}}; /**< The goals scored. */
+    std::array<float, 2> possession = {{0.f, 0.f}}; /**< The playing time in which the team touched the ball last (in s). */
+    std::array<float, 2> territory = {{0.f, 0.f}}; /**< The playing time in which the ball was in the opponent half (in s). */
+    std::array<int, 2> kicks = {{0, 0}}; /**< The number of kicks. */
+    std::array<int, 2> setPlays = {{0, 0}}; /**< The number of set plays awarded. */
+    std::array<int, 2> penalties = {{0, 0}}; /**< The number of penalties received. */
+    float simulatedTime = 0.f; /**< The time simulated (in s). */
+    float realTime = 0.f; /**< The time the simulation took (in s). */
+  };
+
+private:
+  static constexpr int stepLength = 17; /**< The duration of a simulation step (in ms). */
+  static constexpr float robotRadius = 0.12f; /**< The radius of the disc that approximates a player (in m). */
+  static constexpr unsigned startupTimeout = 60000; /**< The time the robot code may take to process its first frame (in ms). */
+  static constexpr unsigned frameTimeout = 30000; /**< The time the robot code may take to process any other frame (in ms). */
+
+  /** A straight part of a wall. */
+  struct Segment
+  {
+    Vector2f from; /**< The start point (in m). */
+    Vector2f to; /**< The end point (in m). */
+  };
+
+  const Options options; /**< The parameters of this match. */
+  GameController gameController; /**< The referee. */
+  std::vector<MatchPlayer*> players; /**< All players. The players of the first team come first. */
+  std::vector<Pose2f> initialPoses; /**< The poses of the players at the beginning of each half (in m). */
+  FieldDimensions fieldDimensions; /**< The dimensions of the field. */
+  BallSpecification ballSpecification; /**< The properties of the ball. */
+  std::vector<Vector2f> goalPosts; /**< The centers of the goal posts (in m). */
+  std::vector<Segment> walls; /**< The goal nets and the border of the carpet (in m). */
+  Vector2f ballPosition = Vector2f::Zero(); /**< The position of the ball (in m). */
+  Vector2f ballVelocity = Vector2f::Zero(); /**< The velocity of the ball (in m/s). */
+  int lastTouch = -1; /**< The team that touched the ball last (0: first, 1: second, -1: none). */
+  uint8_t lastSetPlay = SET_PLAY_NONE; /**< The set play in the previous step. */
+  std::array<std::array<uint8_t, MAX_NUM_PLAYERS>, 2> lastPenalties; /**< The penalties of all players in the previous step. */
+  Result result; /**< The statistics collected so far. */
+
+public:
+  /**
+   * The constructor creates all players, but does not start them.
+   * @param options The parameters of the match.
+   */
+  Match(const Options& options);
+
+  /** The destructor stops all players. */
+  ~Match();
+
+  /**
+   * Plays both halves.
+   * @return The statistics of the match.
+   */
+  const Result& run();
+
+  /**
+   * A player kicks the ball.
+   * @param player The player.
+   * @param velocity The new velocity of the ball (in m/s).
+   */
+  void kick(const MatchPlayer& player, const Vector2f& velocity);
+
+  /**
+   * Returns the position of the ball for the GameController.
+   * @param ballPosition The position (in mm).
+   */
+  void getPosition(Vector2f& ballPosition) const override;
+
+  /**
+   * Places the ball for the GameController.
+   * @param pos The position (in mm).
+   * @param resetDynamics Whether the ball should be stopped.
+   */
+  void move(const Vector3f& pos, bool resetDynamics) override;
+
+private:
+  /**
+   * Plays one half.
+   * @param firstHalf Is this the first half?
+   * @return Did the robot code keep up?
+   */
+  bool playHalf(bool firstHalf);
+
+  /**
+   * Sends frames until all players processed one, which can take a while
+   * after they were started.
+   * @return Did all players process a frame in time?
+   */
+  bool waitForPlayers();
+
+  /**
+   * Simulates a single step: all players receive a frame, their motion
+   * requests are executed, and the scene is updated.
+   * @return Did all players process their frames in time?
+   */
+  bool step();
+
+  /** Moves the players and resolves their collisions. */
+  void movePlayers();
+
+  /** Moves the ball and resolves its collisions. */
+  void moveBall();
+
+  /**
+   * Collects the statistics for the step just simulated.
+   * @param stepDuration The duration of the step (in s).
+   */
+  void updateStatistics(float stepDuration);
+
+  /**
+   * Returns the state of the match in scene coordinates.
+   * @param worldState The state with all players and the ball (in mm).
+   */
+  void getWorldState(GroundTruthWorldState& worldState) const;
+
+  /**
+   * Records that a player touched the ball.
+   * @param player The player.
+   */
+  void touch(const MatchPlayer& player);
+
+  /**
+   * Sends a command to the GameController.
+   * @param command The command as it would be typed after "gc" in SimRobot.
+   */
+  void command(const std::string& command);
+};
@@ -0,0 +1,99 @@
+/**
+ * @file Utils/MatchSimulator/MatchPlayer.cpp
+ *
+ * This file implements a player of a headless 2D match.
+ */
+
+#include "MatchPlayer.h"
+#include "Match.h"
+#include "Threads/Debug.h"
+#include "Tools/Settings.h"
+
+MatchPlayer::MatchPlayer(Match& match, const Settings& settings, GameController& gameController, const Pose2f& pose) :
+  Robot(settings, "robot" + std::to_string(settings.playerNumber + (settings.teamNumber == 1 ? 0 : 6))),
+  match(match),
+  firstTeam(settings.teamNumber == 1),
+  number(settings.playerNumber),
+  pose(pose)
+{
+  const int robot = number - 1 + (firstTeam ? 0 : GameController::numOfRobots / 2);
+  matchThread = new MatchThread(settings, getName(), static_cast<Debug*>(front()), gameController, robot);
+  push_back(matchThread);
+  gameController.registerSimulatedRobot(robot, *this);
+}
+
+void MatchPlayer::sendFrame(const GroundTruthWorldState& worldState)
+{
+  // The robot code expects everything relative to the side of its own team.
+  frame.worldState.firstTeamPlayers.clear();
+  frame.worldState.secondTeamPlayers.clear();
+  frame.worldState.balls = worldState.balls;
+  for(const GroundTruthWorldState::GroundTruthPlayer& player : worldState.firstTeamPlayers)
+    if(!firstTeam || player.number != number)
+      frame.worldState.firstTeamPlayers.push_back(player);
+  for(const GroundTruthWorldState::GroundTruthPlayer& player : worldState.secondTeamPlayers)
+    if(firstTeam || player.number != number)
+      frame.worldState.secondTeamPlayers.push_back(player);
+  if(firstTeam)
+  {
+    for(GroundTruthWorldState::GroundTruthBall& ball : frame.worldState.balls)
+    {
+      ball.position.head<2>() *= -1.f;
+      ball.velocity.head<2>() *= -1.f;
+    }
+    for(GroundTruthWorldState::GroundTruthPlayer& player : frame.worldState.firstTeamPlayers)
+      player.pose = Pose2f(pi) + player.pose;
+    for(GroundTruthWorldState::GroundTruthPlayer& player : frame.worldState.secondTeamPlayers)
+      player.pose = Pose2f(pi) + player.pose;
+  }
+  getRobotPose(frame.worldState.ownPose);
+
+  // Odometry is the pose in the scene, as in SimRobot.
+  static_cast<Pose2f&>(frame.odometryData) = Pose2f(pose.rotation, pose.translation * 1000.f);
+
+  frame.cameraInfo = cameraInfos[currentCamera];
+  currentCamera = currentCamera == CameraInfo::upper ? CameraInfo::lower : CameraInfo::upper;
+  frame.motionInfo = motionInfo;
+  matchThread->send(frame);
+}
+
+bool MatchPlayer::receiveMotionRequest(unsigned timeout)
+{
+  return matchThread->waitForAcknowledgement(motionRequest, timeout);
+}
+
+void MatchPlayer::integrate(float stepDuration)
+{
+  pose.translation += velocity * stepDuration;
+  pose.rotation = Angle::normalize(pose.rotation + angularVelocity * stepDuration);
+}
+
+void MatchPlayer::place(const Pose2f& pose)
+{
+  this->pose = pose;
+  velocity = Vector2f::Zero();
+  angularVelocity = 0.f;
+}
+
+void MatchPlayer::getRobotPose(Pose2f& robotPose) const
+{
+  robotPose = Pose2f(pose.rotation, pose.translation * 1000.f);
+  if(firstTeam)
+    robotPose = Pose2f(pi) + robotPose;
+}
+
+void MatchPlayer::moveRobot(const Vector3f& pos, const Vector3f& rot, bool changeRotation)
+{
+  place(Pose2f(changeRotation ? Angle(rot.z()) : pose.rotation, pos.head<2>() * 0.001f));
+}
+
+void MatchPlayer::setBodyVelocity(const Vector2f& linear, float angular)
+{
+  velocity = linear;
+  angularVelocity = angular;
+}
+
+void MatchPlayer::kickBall(const Vector2f& velocity)
+{
+  match.kick(*this, velocity);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file Utils/MatchSimulator/MatchPlayer.h
+ *
+ * This file declares a player of a headless 2D match, i.e. the threads of
+ * its robot code together with the abstract motion emulation of its body.
+ */
+
+#pragma once
+
+#include "MatchThread.h"
+#include "Controller/AbstractSimulatedRobot2D.h"
+#include "Controller/GameController.h"
+#include "Representations/MotionControl/MotionInfo.h"
+#include "Tools/Framework/Robot.h"
+#include "Tools/Math/Pose2f.h"
+
+class Match;
+
+/**
+ * @class MatchPlayer
+ *
+ * The threads of a robot as configured in threads.cfg plus a thread that
+ * exchanges frames with them. The body of the player is a simple kinematic
+ * object in the scene that is moved by the motion emulation.
+ */
+class MatchPlayer : public Robot, public AbstractSimulatedRobot2D, public GameController::Player
+{
+private:
+  Match& match; /**< The match this player takes part in. */
+  MatchThread* matchThread; /**< The thread that exchanges frames with the robot code. Owned by the thread list. */
+  const bool firstTeam; /**< Is this player a member of the first team? */
+  const int number; /**< The player number of this player [1 ... 5]. */
+  Pose2f pose; /**< The pose of the body in the scene (in m). */
+  Vector2f velocity = Vector2f::Zero(); /**< The linear velocity of the body in the scene (in m/s). */
+  float angularVelocity = 0.f; /**< The angular velocity of the body (in radians/s). */
+  MotionRequest motionRequest; /**< The motion request received last. */
+  MotionInfo motionInfo; /**< The motion executed last. */
+  MatchThread::Frame frame; /**< The frame sent last. */
+
+public:
+  /**
+   * The constructor.
+   * @param match The match this player takes part in.
+   * @param settings The settings for the robot. They determine the team and the player number.
+   * @param gameController The GameController the player is registered with.
+   * @param pose The initial pose of the body in the scene (in m).
+   */
+  MatchPlayer(Match& match, const Settings& settings, GameController& gameController, const Pose2f& pose);
+
+  /**
+   * Sends the next frame to the robot code.
+   * @param worldState The state of the match in scene coordinates (in mm).
+   */
+  void sendFrame(const GroundTruthWorldState& worldState);
+
+  /** Sends the frame sent last again, e.g. because the robot code was not ready for it. */
+  void resendFrame() { matchThread->resend(); }
+
+  /**
+   * Waits until the robot code processed the frame sent last. Frames
+   * processed that were sent earlier are ignored.
+   * @param timeout The maximum time to wait (in ms).
+   * @return Was the frame processed in time?
+   */
+  bool receiveMotionRequest(unsigned timeout);
+
+  /**
+   * Executes the motion request received last for one simulation step.
+   * @param stepDuration The duration of the simulation step (in s).
+   */
+  void executeMotionRequest(float stepDuration) { emulateMotion(motionRequest, motionInfo, stepDuration); }
+
+  /**
+   * Moves the body with its current velocity.
+   * @param stepDuration The duration of the simulation step (in s).
+   */
+  void integrate(float stepDuration);
+
+  /**
+   * Places the body in the scene and stops it.
+   * @param pose The new pose of the body in the scene (in m).
+   */
+  void place(const Pose2f& pose);
+
+  /**
+   * Moves the body without changing its rotation or velocity, e.g. to
+   * resolve collisions.
+   * @param position The new position of the body in the scene (in m).
+   */
+  void setPosition(const Vector2f& position) { pose.translation = position; }
+
+  const Pose2f& getPose() const { return pose; }
+  const Vector2f& getVelocity() const { return velocity; }
+  float getAngularVelocity() const { return angularVelocity; }
+  bool isFirstTeam() const { return firstTeam; }
+  int getNumber() const { return number; }
+
+  /**
+   * Returns the pose of this player in the coordinate system of its team.
+   * @param robotPose The pose (in mm).
+   */
+  void getRobotPose(Pose2f& robotPose) const override;
+
+  /**
+   * Places the player in the scene.
+   * @param pos The position (in mm).
+   * @param rot The rotation (in radians).
+   * @param changeRotation Whether the rotation should be changed.
+   */
+  void moveRobot(const Vector3f& pos, const Vector3f& rot, bool changeRotation) override;
+
+protected:
+  float getBodyRotation() const override { return pose.rotation; }
+  Vector2f getBodyPosition() const override { return pose.translation; }
+  void setBodyVelocity(const Vector2f& linear, float angular) override;
+  void moveBody(const Vector2f& position) override { pose.translation = position; }
+  void kickBall(const Vector2f& velocity) override;
+};
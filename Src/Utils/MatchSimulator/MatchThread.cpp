@@ -0,0 +1,178 @@
+/**
+ * @file Utils/MatchSimulator/MatchThread.cpp
+ *
+ * This file implements the thread that exchanges the data of a simulated
+ * player with the threads of its robot code.
+ */
+
+#include "MatchThread.h"
+#include "Controller/GameController.h"
+#include "Platform/Time.h"
+#include "Representations/Infrastructure/FrameInfo.h"
+#include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Representations/Sensing/FallDownState.h"
+#include "Representations/Sensing/GroundContactState.h"
+#include "Threads/Debug.h"
+#include "Tools/Debugging/DebugRequest.h"
+#include <algorithm>
+
+MatchThread::MatchThread(const Settings& settings, const std::string& robotName, Debug* debug, GameController& gameController, int robot) :
+  ThreadFrame(settings, robotName, connectReceiverWithRobot(debug, this), connectSenderWithRobot(debug)),
+  gameController(gameController),
+  robot(robot)
+{}
+
+void MatchThread::send(const Frame& frame)
+{
+  {
+    SYNC;
+    // The sequence numbers must increase even if the simulated time did not.
+    sequenceNumber = std::max(Time::getCurrentSystemTime(), sequenceNumber + 1);
+    frameAcknowledged = false;
+    this->frame = &frame;
+    while(frameProcessed.tryWait());
+  }
+  frameRequested.post();
+  trigger();
+}
+
+void MatchThread::resend()
+{
+  frameRequested.post();
+  trigger();
+}
+
+bool MatchThread::waitForAcknowledgement(MotionRequest& motionRequest, unsigned timeout)
+{
+  if(!frameProcessed.wait(timeout))
+    return false;
+  SYNC;
+  motionRequest = motionRequestOfFrame;
+  return true;
+}
+
+void MatchThread::init()
+{
+  // Debug forwards the requests to all threads. Keeping all messages avoids
+  // that Debug drops the acknowledgement if another message of the same
+  // type is sent in the same frame.
+  for(const char* request : {"debug:keepAllMessages", "representation:MotionRequest", "representation:FrameInfo"})
+  {
+    debugSender->out.bin << DebugRequest(request);
+    debugSender->out.finishMessage(idDebugRequest);
+  }
+}
+
+bool MatchThread::main()
+{
+  if(frameRequested.tryWait())
+  {
+    debugSender->out.bin << "Cognition";
+    debugSender->out.finishMessage(idFrameBegin);
+    FrameInfo frameInfo;
+    {
+      SYNC;
+      frameInfo.time = sequenceNumber;
+    }
+    debugSender->out.bin << frameInfo;
+    debugSender->out.finishMessage(idFrameInfo);
+    debugSender->out.bin << frame->cameraInfo;
+    debugSender->out.finishMessage(idCameraInfo);
+    debugSender->out.bin << frame->odometryData;
+    debugSender->out.finishMessage(idGroundTruthOdometryData);
+    {
+      FallDownState fallDownState;
+      fallDownState.state = FallDownState::upright;
+      debugSender->out.bin << fallDownState;
+      debugSender->out.finishMessage(idFallDownState);
+    }
+    {
+      GroundContactState groundContactState;
+      groundContactState.contact = true;
+      debugSender->out.bin << groundContactState;
+      debugSender->out.finishMessage(idGroundContactState);
+    }
+    {
+      CameraMatrix cameraMatrix;
+      cameraMatrix.isValid = false;
+      debugSender->out.bin << cameraMatrix;
+      debugSender->out.finishMessage(idCameraMatrix);
+    }
+    debugSender->out.bin << frame->motionInfo;
+    debugSender->out.finishMessage(idMotionInfo);
+    gameController.writeGameInfo(debugSender->out.bin);
+    debugSender->out.finishMessage(idGameInfo);
+    gameController.writeOwnTeamInfo(robot, debugSender->out.bin);
+    debugSender->out.finishMessage(idOwnTeamInfo);
+    gameController.writeOpponentTeamInfo(robot, debugSender->out.bin);
+    debugSender->out.finishMessage(idOpponentTeamInfo);
+    gameController.writeRobotInfo(robot, debugSender->out.bin);
+    debugSender->out.finishMessage(idRobotInfo);
+    debugSender->out.bin << frame->worldState;
+    debugSender->out.finishMessage(idGroundTruthWorldState);
+    debugSender->out.bin << "Cognition";
+    debugSender->out.finishMessage(idFrameFinished);
+  }
+  debugSender->send(true);
+  return true;
+}
+
+bool MatchThread::handleMessage(InMessage& message)
+{
+  switch(message.getMessageID())
+  {
+    case idFrameBegin:
+      threadIdentifier = message.readThreadIdentifier();
+      acknowledged = false;
+      receivedSequenceNumber = 0;
+      return true;
+    case idLogResponse:
+      acknowledged = true;
+      return true;
+    case idFrameInfo:
+    {
+      FrameInfo frameInfo;
+      message.bin >> frameInfo;
+      receivedSequenceNumber = frameInfo.time;
+      return true;
+    }
+    case idMotionRequest:
+      message.bin >> motionRequest;
+      return true;
+    case idFrameFinished:
+      // The motion request of the frame is complete only now. Acknowledgements
+      // of frames sent earlier and of copies of the frame sent last are ignored.
+      if(acknowledged && threadIdentifier == "Cognition")
+      {
+        SYNC;
+        if(receivedSequenceNumber == sequenceNumber && !frameAcknowledged)
+        {
+          frameAcknowledged = true;
+          motionRequestOfFrame = motionRequest;
+          frameProcessed.post();
+        }
+      }
+      acknowledged = false;
+      return true;
+    case idText:
+      fprintf(stderr, "%s: %s\n", robotName.c_str(), message.text.readAll().c_str());
+      return true;
+    default:
+      return true;
+  }
+}
+
+DebugReceiver<MessageQueue>* MatchThread::connectReceiverWithRobot(Debug* debug, ThreadFrame* thread)
+{
+  ASSERT(!debug->debugSender);
+  DebugReceiver<MessageQueue>* receiver = new DebugReceiver<MessageQueue>(thread, debug->getName());
+  debug->debugSender = new DebugSender<MessageQueue>(*receiver, "MatchThread");
+  return receiver;
+}
+
+DebugSender<MessageQueue>* MatchThread::connectSenderWithRobot(Debug* debug)
+{
+  ASSERT(!debug->debugReceiver);
+  debug->debugReceiver = new DebugReceiver<MessageQueue>(debug, "MatchThread");
+  return new DebugSender<MessageQueue>(*debug->debugReceiver, debug->getName());
+}
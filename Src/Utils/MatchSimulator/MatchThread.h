@@ -0,0 +1,126 @@
+/**
+ * @file Utils/MatchSimulator/MatchThread.h
+ *
+ * This file declares the thread that exchanges the data of a simulated
+ * player with the threads of its robot code.
+ */
+
+#pragma once
+
+#include "Platform/Semaphore.h"
+#include "Platform/Thread.h"
+#include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Infrastructure/GroundTruthWorldState.h"
+#include "Representations/MotionControl/MotionInfo.h"
+#include "Representations/MotionControl/MotionRequest.h"
+#include "Representations/MotionControl/OdometryData.h"
+#include "Tools/Framework/ThreadFrame.h"
+#include <string>
+
+class Debug;
+class GameController;
+
+/**
+ * @class MatchThread
+ *
+ * The thread sends the same Cognition frames as a local robot in a 2D scene
+ * in SimRobot, but only when it is asked to. It reports the motion request
+ * after the robot code acknowledged the frame, so that the simulation and
+ * the robot code can proceed in lockstep. Each frame is tagged with a
+ * sequence number. It is sent as the time of the frame, because the robot
+ * code reports the FrameInfo back together with the acknowledgement. Thereby,
+ * acknowledgements of frames sent earlier, e.g. of copies sent again while
+ * the robot code was starting, can be told apart and are ignored.
+ */
+class MatchThread : public ThreadFrame
+{
+public:
+  /** The data of a frame that is not provided by the GameController. */
+  struct Frame
+  {
+    CameraInfo cameraInfo; /**< The camera the frame was taken with. */
+    OdometryData odometryData; /**< The ground truth odometry of the robot. */
+    MotionInfo motionInfo; /**< The motion executed. */
+    GroundTruthWorldState worldState; /**< The state of the whole match. */
+  };
+
+private:
+  DECLARE_SYNC; /**< Synchronizes the sequence number and the acknowledgement of the frame sent last. */
+  GameController& gameController; /**< The GameController that provides the game state. */
+  const int robot; /**< The number of the robot in the GameController [0 ... 11]. */
+  const Frame* frame = nullptr; /**< The frame to send next. */
+  unsigned sequenceNumber = 0; /**< The sequence number of the frame sent last. */
+  bool frameAcknowledged = false; /**< Was the frame sent last already acknowledged? */
+  Semaphore frameRequested; /**< Is posted when a frame should be sent. */
+  Semaphore frameProcessed; /**< Is posted when the robot code acknowledged the frame sent last. */
+  std::string threadIdentifier; /**< The thread the messages currently received are from. */
+  bool acknowledged = false; /**< Did the current frame of Cognition contain an acknowledgement? */
+  unsigned receivedSequenceNumber = 0; /**< The sequence number of the frame the current frame of Cognition processed. */
+  MotionRequest motionRequest; /**< The motion request received last. */
+  MotionRequest motionRequestOfFrame; /**< The motion request that belongs to the frame acknowledged last. */
+
+public:
+  /**
+   * The constructor.
+   * @param settings The settings of the robot.
+   * @param robotName The name of the robot.
+   * @param debug The debug thread of the robot.
+   * @param gameController The GameController that provides the game state.
+   * @param robot The number of the robot in the GameController [0 ... 11].
+   */
+  MatchThread(const Settings& settings, const std::string& robotName, Debug* debug, GameController& gameController, int robot);
+
+  /**
+   * Sends a new frame to the robot code. It gets the next sequence number.
+   * @param frame The data of the frame. It must not change until the frame was acknowledged.
+   */
+  void send(const Frame& frame);
+
+  /** Sends the frame sent last again with the same sequence number. */
+  void resend();
+
+  /**
+   * Waits until the robot code acknowledged the frame sent last.
+   * @param motionRequest The motion request the robot code computed in that frame.
+   * @param timeout The maximum time to wait (in ms).
+   * @return Was the frame acknowledged in time?
+   */
+  bool waitForAcknowledgement(MotionRequest& motionRequest, unsigned timeout);
+
+protected:
+  int getPriority() const override { return 0; }
+
+  /** Requests the motion request and the frame info from the robot code. */
+  void init() override;
+
+  /**
+   * Sends the frame requested if there is one.
+   * @return Should wait for external trigger?
+   */
+  bool main() override;
+
+  void terminate() override {}
+
+  /**
+   * The function is called for every incoming debug message.
+   * @param message An interface to read the message from the queue.
+   * @return Has the message been handled?
+   */
+  bool handleMessage(InMessage& message) override;
+
+private:
+  /**
+   * The function connects the robot to the returned receiver.
+   * @param debug The debug thread of the robot.
+   * @param thread This thread.
+   * @return The receiver connected to the robot.
+   */
+  static DebugReceiver<MessageQueue>* connectReceiverWithRobot(Debug* debug, ThreadFrame* thread);
+
+  /**
+   * The function connects the robot to the returned sender.
+   * @param debug The debug thread of the robot.
+   * @return The sender connected to the robot.
+   */
+  static DebugSender<MessageQueue>* connectSenderWithRobot(Debug* debug);
+};
@@ -0,0 +1,82 @@
+#include "Tools/ImageProcessing/ConnectedComponents.h"
+#include "Tools/Math/Random.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+/**
+ * Reference implementation: Determines the bounding boxes of the 4-connected
+ * components with a flood fill started at each set cell in row-major order.
+ */
+static std::vector<Boundaryi> floodFill(std::vector<char> grid, int width, int height)
+{
+  std::vector<Boundaryi> components;
+  std::vector<std::pair<int, int>> stack;
+  for(int y = 0; y < height; ++y)
+    for(int x = 0; x < width; ++x)
+      if(grid[y * width + x])
+      {
+        Boundaryi component(Rangei(x, x), Rangei(y, y));
+        grid[y * width + x] = 0;
+        stack.emplace_back(x, y);
+        while(!stack.empty())
+        {
+          const auto [px, py] = stack.back();
+          stack.pop_back();
+          component.x.add(px);
+          component.y.add(py);
+          for(const auto& [nx, ny] : {std::make_pair(px - 1, py), std::make_pair(px + 1, py), std::make_pair(px, py - 1), std::make_pair(px, py + 1)})
+            if(nx >= 0 && nx < width && ny >= 0 && ny < height && grid[ny * width + nx])
+            {
+              grid[ny * width + nx] = 0;
+              stack.emplace_back(nx, ny);
+            }
+        }
+        components.push_back(component);
+      }
+  return components;
+}
+
+GTEST_TEST(ConnectedComponents, MatchesFloodFill)
+{
+  ConnectedComponents connectedComponents;
+  for(int i = 0; i < 200; ++i)
+  {
+    // Widths around multiples of 16 exercise both the SIMD and the scalar part of the row scan.
+    const int width = Random::uniformInt(1, 50);
+    const int height = Random::uniformInt(1, 40);
+    const float density = Random::uniform(0.f, 1.f);
+    std::vector<char> grid(width * height);
+    for(char& cell : grid)
+      cell = Random::bernoulli(density) ? 1 : 0;
+
+    connectedComponents.label(grid.data(), width, height, width);
+    const std::vector<Boundaryi> expected = floodFill(grid, width, height);
+    const std::vector<Boundaryi>& components = connectedComponents.getComponents();
+    ASSERT_EQ(expected.size(), components.size());
+    for(size_t j = 0; j < expected.size(); ++j)
+    {
+      EXPECT_EQ(expected[j].x.min, components[j].x.min);
+      EXPECT_EQ(expected[j].x.max, components[j].x.max);
+      EXPECT_EQ(expected[j].y.min, components[j].y.min);
+      EXPECT_EQ(expected[j].y.max, components[j].y.max);
+    }
+
+    int cells = 0;
+    for(const ConnectedComponents::Run& run : connectedComponents.getRuns())
+    {
+      ASSERT_LT(run.component, static_cast<int>(components.size()));
+      for(int x = run.xBegin; x < run.xEnd; ++x)
+      {
+        EXPECT_TRUE(grid[run.y * width + x]);
+        EXPECT_TRUE(components[run.component].isInside(Vector2i(x, run.y)));
+        ++cells;
+      }
+    }
+    int setCells = 0;
+    for(char cell : grid)
+      setCells += cell ? 1 : 0;
+    EXPECT_EQ(setCells, cells);
+  }
+}
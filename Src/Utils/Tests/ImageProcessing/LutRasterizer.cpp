@@ -0,0 +1,208 @@
+#include "Tools/ImageProcessing/CNS/LutRasterizer.h"
+#include "Tools/ImageProcessing/CNS/CNSSSE.h"
+#include "Tools/Math/Constants.h"
+#include "Tools/Math/Random.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+/**
+ * Reference implementation: Rasterizes the contour one vertex after the other
+ * with the scalar projection, as LutRasterizer::rasterize did before the
+ * vertices were projected four at a time.
+ */
+static void rasterizeReference(const LutRasterizer& lr, CodedContour& contour, const Eigen::Isometry3d& object2World, const CameraModelOpenCV& camera)
+{
+  contour.clear();
+
+  Eigen::Isometry3d object2Camera = camera.camera2World.inverse() * object2World;
+  if(lr.object.isRotationalSymmetricZ)
+  {
+    const Eigen::Vector3d viewpointInObject = object2Camera.inverse().translation();
+    const double len = std::sqrt(viewpointInObject(0) * viewpointInObject(0) + viewpointInObject(1) * viewpointInObject(1));
+    if(len != 0)
+      object2Camera = object2Camera * Eigen::AngleAxisd(std::atan2(viewpointInObject(1) / len, viewpointInObject(0) / len), Eigen::Vector3d::UnitZ());
+  }
+  const int idx = lr.indexOfNormalizedViewpoint(object2Camera.inverse().translation());
+
+  alignas(16) float P0[4];
+  alignas(16) float P1[4];
+  alignas(16) float P2[4];
+  alignas(16) float clipRange[4];
+  for(int i = 0; i < 4; ++i)
+  {
+    P0[i] = static_cast<float>(object2Camera(0, i) * camera.scale_x);
+    P1[i] = static_cast<float>(object2Camera(1, i) * camera.scale_y);
+    P2[i] = static_cast<float>(object2Camera(2, i));
+  }
+  float centerInImage[2];
+  if(idx < 0 || !projectUsingSSE(centerInImage, const_cast<float*>(lr.centerWith1.data()), P0, P1, P2))
+    return;
+  contour.referenceX = static_cast<int>(std::round(centerInImage[0] + camera.offset_x));
+  contour.referenceY = static_cast<int>(std::round(centerInImage[1] + camera.offset_y));
+  const float origin[2] = {static_cast<float>(camera.offset_x - contour.referenceX), static_cast<float>(camera.offset_y - contour.referenceY)};
+  for(int i = 0; i < 4; ++i)
+  {
+    P0[i] += P2[i] * origin[0];
+    P1[i] += P2[i] * origin[1];
+  }
+  clipRange[0] = static_cast<float>(std::max(0 - contour.referenceX, -127));
+  clipRange[1] = static_cast<float>(std::max(0 - contour.referenceY, -127));
+  clipRange[2] = static_cast<float>(std::min(camera.width - contour.referenceX - 1, 127.0));
+  clipRange[3] = static_cast<float>(std::min(camera.height - contour.referenceY - 1, 127.0));
+
+  alignas(16) float p[4];
+  bool isNewEdge = true;
+  int clippedCtr = 0;
+  for(unsigned i = lr.vertexListBegin[idx]; i < lr.vertexListBegin[idx + 1]; ++i)
+  {
+    const int vIdx = lr.vertexListData[i];
+    if(vIdx != LutRasterizer::NEWSTART)
+    {
+      shift4Floats(p);
+      projectUsingSSE(p + 2, const_cast<float*>(lr.vertexWith1[vIdx].data()), P0, P1, P2);
+      if(!isNewEdge)
+      {
+        const CodedContourPoint ccp = code2DEdgeUsingSSE(p, clipRange);
+        if(ccp != EMPTYCONTOURPOINT)
+          contour.push_back(ccp);
+        else
+          clippedCtr++;
+      }
+      isNewEdge = false;
+    }
+    else
+      isNewEdge = true;
+  }
+
+  const int factorI = static_cast<int>(std::round(factorOfN(static_cast<int>(static_cast<float>(contour.size()) + clippedCtr * contour.mapping.clippedDenom), true) * (256.0 / 127.0)));
+  for(CodedContourPoint& ccp : contour)
+    scaleNormalVector(ccp, factorI);
+}
+
+/** Expects two contours to be identical, bit by bit. */
+static void expectEqual(const CodedContour& expected, const CodedContour& actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  if(expected.empty())
+    return;
+  EXPECT_EQ(expected.referenceX, actual.referenceX);
+  EXPECT_EQ(expected.referenceY, actual.referenceY);
+  for(size_t i = 0; i < expected.size(); ++i)
+    EXPECT_EQ(expected[i], actual[i]);
+}
+
+/** The penalty mark as modeled by the PenaltyMarkPerceptor. */
+static TriangleMesh penaltyMark()
+{
+  const float outer = 50.f;
+  const float inner = 25.f;
+  return TriangleMesh(
+  {
+    -inner, -outer, 0.f,  inner, -outer, 0.f,
+    -outer, -inner, 0.f, -inner, -inner, 0.f, inner, -inner, 0.f, outer, -inner, 0.f,
+    -outer,  inner, 0.f, -inner,  inner, 0.f, inner,  inner, 0.f, outer,  inner, 0.f,
+    -inner,  outer, 0.f,  inner,  outer, 0.f,
+    0.f,    0.f,  -1.f,
+  },
+  {
+    0, 3, 1, 1, 3, 4, 2, 6, 3, 3, 6, 7, 3, 7, 4, 4, 7, 8, 4, 8, 5, 5, 8, 9, 7, 10, 8, 8, 10, 11,
+    0, 1, 12, 1, 4, 12, 4, 5, 12, 5, 9, 12, 9, 8, 12, 8, 11, 12, 11, 10, 12, 10, 7, 12, 7, 6, 12, 6, 2, 12, 2, 3, 12, 3, 0, 12,
+  });
+}
+
+static const Eigen::AlignedBox3d viewpointRange(Eigen::Vector3d(-3000, -3000, 300), Eigen::Vector3d(3000, 3000, 600));
+
+GTEST_TEST(LutRasterizer, MatchesScalarRasterizer)
+{
+  LutRasterizer lr;
+  lr.create(penaltyMark(), viewpointRange, 100);
+
+  CameraModelOpenCV camera;
+  camera.width = 640;
+  camera.height = 480;
+  camera.scale_x = camera.scale_y = 560;
+  camera.offset_x = 320;
+  camera.offset_y = 240;
+  camera.camera2World = Eigen::Isometry3d(Eigen::AngleAxisd(-2.2, Eigen::Vector3d::UnitX()));
+  camera.camera2World.translation() = Eigen::Vector3d(0, 0, 500);
+
+  std::vector<Eigen::Isometry3d> poses;
+  std::vector<CodedContour> contours;
+  CodedContour expected;
+  CodedContour actual;
+  for(int i = 0; i < 100; ++i)
+  {
+    // The batch sizes vary, so the reused buffers shrink and grow between calls.
+    poses.resize(Random::uniformInt(1, 50));
+    for(Eigen::Isometry3d& pose : poses)
+    {
+      pose = Eigen::AngleAxisd(Random::uniform(-pi, pi), Eigen::Vector3d::UnitZ());
+      pose.translation() = Eigen::Vector3d(Random::uniform(-2000.0, 2000.0), Random::uniform(200.0, 4200.0), 0);
+    }
+    lr.rasterize(contours, poses, camera);
+    ASSERT_EQ(poses.size(), contours.size());
+    for(size_t j = 0; j < poses.size(); ++j)
+    {
+      rasterizeReference(lr, expected, poses[j], camera);
+      expectEqual(expected, contours[j]);
+      lr.rasterize(actual, poses[j], camera);
+      expectEqual(expected, actual);
+    }
+  }
+}
+
+/** Expects two look-up-tables to contain the same vertex lists. */
+static void expectSameLut(const LutRasterizer& expected, const LutRasterizer& actual)
+{
+  const int numOfViewpoints = expected.vertexListSize[0] * expected.vertexListSize[1] * expected.vertexListSize[2];
+  ASSERT_EQ(0, std::memcmp(expected.vertexListBegin, actual.vertexListBegin, (numOfViewpoints + 1) * sizeof(unsigned)));
+  ASSERT_EQ(0, std::memcmp(expected.vertexListData, actual.vertexListData, expected.vertexListBegin[numOfViewpoints]));
+}
+
+GTEST_TEST(LutRasterizer, RejectsCorruptCacheFile)
+{
+  // The table is not mapped from the cache file, because the file is overwritten below.
+  LutRasterizer expected;
+  expected.create(penaltyMark(), viewpointRange, 100);
+  const int numOfViewpoints = expected.vertexListSize[0] * expected.vertexListSize[1] * expected.vertexListSize[2];
+  const long offsetsPos = static_cast<long>(reinterpret_cast<const char*>(expected.vertexListBegin) - expected.lut.get());
+  const long dataPos = offsetsPos + (numOfViewpoints + 1) * static_cast<long>(sizeof(unsigned));
+
+  // Writes a valid cache file, overwrites a part of it, loads it and checks that the table was computed again.
+  const std::string filename = (std::filesystem::temp_directory_path() / "LutRasterizerTest.lut").string();
+  auto corruptAndLoad = [&](long pos, const void* data, size_t size)
+  {
+    std::remove(filename.c_str());
+    {
+      LutRasterizer lr;
+      lr.loadOrCreate(penaltyMark(), viewpointRange, 100, filename.c_str());
+    }
+    FILE* f = std::fopen(filename.c_str(), "r+b");
+    ASSERT_NE(nullptr, f);
+    std::fseek(f, pos, SEEK_SET);
+    std::fwrite(data, 1, size, f);
+    std::fclose(f);
+    LutRasterizer lr;
+    lr.loadOrCreate(penaltyMark(), viewpointRange, 100, filename.c_str());
+    expectSameLut(expected, lr);
+  };
+
+  // The first vertex list does not start at the beginning of the data.
+  const unsigned one = 1;
+  corruptAndLoad(offsetsPos, &one, sizeof(one));
+
+  // A vertex list ends far behind the data and the next one ends before it begins.
+  const unsigned behindData = 0x7fffffff;
+  corruptAndLoad(offsetsPos + static_cast<long>(sizeof(unsigned)), &behindData, sizeof(behindData));
+
+  // A vertex index that the object does not have.
+  const unsigned char badVertex = static_cast<unsigned char>(expected.vertexWith1.size());
+  corruptAndLoad(dataPos, &badVertex, sizeof(badVertex));
+
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,27 @@
+#include "Tools/Logging/LoggingTools.h"
+
+#include "gtest/gtest.h"
+
+GTEST_TEST(Compression, RoundTrip)
+{
+  std::vector<char> data(100000);
+  for(size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>((i / 7) % 13 + (i % 251 == 0 ? 100 : 0));
+
+  std::vector<char> compressed;
+  LoggingTools::compress(data.data(), data.size(), compressed, LoggingTools::snappy);
+  EXPECT_LT(compressed.size(), data.size() / 2);
+  std::vector<char> decompressed(data.size());
+  EXPECT_TRUE(LoggingTools::decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size()));
+  EXPECT_EQ(data, decompressed);
+}
+
+GTEST_TEST(Compression, CorruptData)
+{
+  std::vector<char> data(1000, 'a');
+  std::vector<char> compressed;
+  LoggingTools::compress(data.data(), data.size(), compressed, LoggingTools::snappy);
+  std::vector<char> decompressed(data.size());
+  EXPECT_FALSE(LoggingTools::decompress(compressed.data(), compressed.size() - 1, decompressed.data(), decompressed.size()));
+  EXPECT_FALSE(LoggingTools::decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size() - 1));
+}
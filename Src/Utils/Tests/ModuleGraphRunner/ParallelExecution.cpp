@@ -0,0 +1,183 @@
+/**
+ * @file Utils/Tests/ModuleGraphRunner/ParallelExecution.cpp
+ *
+ * This file implements tests for executing providers in parallel.
+ */
+
+#include "Tools/Debugging/DebugDataTable.h"
+#include "Tools/Debugging/DebugDrawings.h"
+#include "Tools/Debugging/DebugRequest.h"
+#include "Tools/Debugging/TimingManager.h"
+#include "Tools/FunctionList.h"
+#include "Tools/MessageQueue/MessageQueue.h"
+#include "Tools/Module/ModuleGraphRunner.h"
+#include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/OutStreams.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+static constexpr int numOfWorkers = 4; /**< The number of providers that can be executed in parallel. */
+static constexpr int messagesPerProvider = 200; /**< The number of text messages each of them writes per frame. */
+static constexpr int drawingsPerProvider = 20; /**< The number of drawings each of them declares. */
+
+/** The names of all drawings. They must stay at the same addresses, because the drawing manager uses them as keys. */
+static const std::vector<std::string> drawingNames = []
+{
+  std::vector<std::string> names;
+  for(int i = 0; i < numOfWorkers * drawingsPerProvider; ++i)
+    names.emplace_back("parallel:" + std::to_string(i));
+  return names;
+}();
+
+/**
+ * Writes the debug output of a provider that is executed in parallel.
+ * @param provider The number of the provider [0 ... numOfWorkers - 1].
+ * @param value The value it received.
+ * @return The value it provides.
+ */
+static int writeDebugOutput(int provider, int value)
+{
+  for(int i = 0; i < messagesPerProvider; ++i)
+  {
+    Global::getDebugOut().text << provider << ":" << value << ":" << i;
+    Global::getDebugOut().finishMessage(idText);
+    Global::getDrawingManager().addDrawingId(drawingNames[provider * drawingsPerProvider + i % drawingsPerProvider].c_str(), "drawingOnField");
+  }
+  return value + provider;
+}
+
+STREAMABLE(ParallelSource, {, (int)(0) value, });
+STREAMABLE(ParallelResult0, {, (int)(0) value, });
+STREAMABLE(ParallelResult1, {, (int)(0) value, });
+STREAMABLE(ParallelResult2, {, (int)(0) value, });
+STREAMABLE(ParallelResult3, {, (int)(0) value, });
+
+MODULE(ParallelSourceProvider,
+{,
+  PROVIDES(ParallelSource),
+});
+
+class ParallelSourceProvider : public ParallelSourceProviderBase
+{
+  void update(ParallelSource& parallelSource) override {++parallelSource.value;}
+};
+
+#define PARALLEL_RESULT_PROVIDER(n) \
+  MODULE(ParallelResult##n##Provider, \
+  {, \
+    REQUIRES(ParallelSource), \
+    PROVIDES(ParallelResult##n), \
+  }); \
+  \
+  class ParallelResult##n##Provider : public ParallelResult##n##ProviderBase \
+  { \
+    void update(ParallelResult##n& parallelResult) override {parallelResult.value = writeDebugOutput(n, theParallelSource.value);} \
+  }; \
+  \
+  MAKE_MODULE(ParallelResult##n##Provider, perception)
+
+MAKE_MODULE(ParallelSourceProvider, perception);
+PARALLEL_RESULT_PROVIDER(0);
+PARALLEL_RESULT_PROVIDER(1);
+PARALLEL_RESULT_PROVIDER(2);
+PARALLEL_RESULT_PROVIDER(3);
+
+/** Collects the text messages of a queue. */
+class TextCollector : public MessageHandler
+{
+public:
+  std::vector<std::string> texts;
+
+  bool handleMessage(InMessage& message) override
+  {
+    EXPECT_EQ(idText, message.getMessageID());
+    texts.emplace_back(message.text.readAll());
+    return true;
+  }
+};
+
+/**
+ * @class ModuleGraphRunnerTest
+ *
+ * The class provides the thread wide instances of the thread the test runs in.
+ */
+class ModuleGraphRunnerTest : public testing::Test
+{
+protected:
+  MessageQueue debugOut;
+  DebugRequestTable debugRequestTable;
+  DebugDataTable debugDataTable;
+  DrawingManager drawingManager;
+  TimingManager timingManager;
+  Blackboard blackboard;
+
+  ModuleGraphRunnerTest()
+  {
+    FunctionList::execute();
+    Global::theDebugOut = &debugOut.out;
+    Global::theDebugRequestTable = &debugRequestTable;
+    Global::theDebugDataTable = &debugDataTable;
+    Global::theDrawingManager = &drawingManager;
+    Global::theTimingManager = &timingManager;
+  }
+
+  ~ModuleGraphRunnerTest()
+  {
+    Global::theDebugOut = nullptr;
+    Global::theDebugRequestTable = nullptr;
+    Global::theDebugDataTable = nullptr;
+    Global::theDrawingManager = nullptr;
+    Global::theTimingManager = nullptr;
+  }
+};
+
+TEST_F(ModuleGraphRunnerTest, DebugOutputOfWorkers)
+{
+  ModuleGraphRunner runner(1, numOfWorkers);
+  {
+    ModuleGraphCreator::ExecutionValues values;
+    values.received.resize(1);
+    values.sent.resize(1);
+    values.modules.emplace_back("ParallelSourceProvider", true);
+    values.providers.emplace_back("ParallelSource", "ParallelSourceProvider");
+    for(int i = 0; i < numOfWorkers; ++i)
+    {
+      values.modules.emplace_back("ParallelResult" + std::to_string(i) + "Provider", true);
+      values.providers.emplace_back("ParallelResult" + std::to_string(i), "ParallelResult" + std::to_string(i) + "Provider");
+    }
+    OutBinaryMemory out(1000);
+    out << values << 1u;
+    InBinaryMemory in(out.data());
+    runner.update(in);
+  }
+
+  // The first frame is executed sequentially, all others in parallel.
+  for(int frame = 1; frame <= 20; ++frame)
+  {
+    debugOut.clear();
+    runner.execute();
+
+    TextCollector collector;
+    debugOut.handleAllMessages(collector);
+    std::vector<std::string> expected;
+    for(int provider = 0; provider < numOfWorkers; ++provider)
+      for(int i = 0; i < messagesPerProvider; ++i)
+        expected.emplace_back(std::to_string(provider) + ":" + std::to_string(frame) + ":" + std::to_string(i));
+    std::sort(expected.begin(), expected.end());
+    std::sort(collector.texts.begin(), collector.texts.end());
+    ASSERT_EQ(expected, collector.texts) << "frame " << frame;
+
+    EXPECT_EQ(frame, static_cast<const ParallelSource&>(blackboard["ParallelSource"]).value);
+    EXPECT_EQ(frame + 2, static_cast<const ParallelResult2&>(blackboard["ParallelResult2"]).value);
+  }
+
+  ASSERT_EQ(drawingNames.size(), drawingManager.drawings.size());
+  std::vector<char> ids;
+  for(const std::string& name : drawingNames)
+    ids.push_back(drawingManager.getDrawingId(name.c_str()));
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(ids.end(), std::unique(ids.begin(), ids.end()));
+}
@@ -0,0 +1,118 @@
+#include "Tools/Math/Angle.h"
+#include "Tools/Math/Eigen.h"
+#include "Tools/Streams/AutoStreamable.h"
+#include "Tools/Streams/Enum.h"
+#include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/OutStreams.h"
+
+#include "gtest/gtest.h"
+
+STREAMABLE(BinaryStreamingInner,
+{,
+  (short)(0) s,
+  (std::string) text,
+});
+
+STREAMABLE(BinaryStreamingExample,
+{
+  ENUM(Letter,
+  {,
+    a,
+    b,
+    c,
+  }),
+
+  (int)(0) anInt,
+  (bool)(false) aBool,
+  (float)(0.f) aFloat,
+  (Angle)(0_deg) anAngle,
+  (Letter)(a) aLetter,
+  (unsigned char[3]) bytes,
+  (std::array<double, 2>) doubles,
+  (Vector2f)(Vector2f::Zero()) aVector,
+  (Matrix2f)(Matrix2f::Zero()) aMatrix,
+  (std::vector<Vector3f>) vectors,
+  (std::vector<BinaryStreamingInner>) inners,
+  (std::vector<Letter>) letters,
+});
+
+static BinaryStreamingExample createExample()
+{
+  BinaryStreamingExample example;
+  example.anInt = -42;
+  example.aBool = true;
+  example.aFloat = 3.5f;
+  example.anAngle = 90_deg;
+  example.aLetter = BinaryStreamingExample::c;
+  example.bytes[0] = 1;
+  example.bytes[1] = 2;
+  example.bytes[2] = 3;
+  example.doubles = {0.25, -8.0};
+  example.aVector = Vector2f(1.f, 2.f);
+  example.aMatrix << 1.f, 2.f, 3.f, 4.f;
+  example.vectors = {Vector3f(1.f, 2.f, 3.f), Vector3f(4.f, 5.f, 6.f)};
+  example.inners.resize(2);
+  example.inners[0].s = 7;
+  example.inners[0].text = "seven";
+  example.inners[1].s = -7;
+  example.letters = {BinaryStreamingExample::b, BinaryStreamingExample::a};
+  return example;
+}
+
+GTEST_TEST(BinaryStreaming, SameDataAsValueByValue)
+{
+  const BinaryStreamingExample example = createExample();
+  OutBinaryMemory fast;
+  fast << example;
+
+  OutBinaryMemory expected;
+  expected << example.anInt << example.aBool << example.aFloat << example.anAngle << static_cast<unsigned char>(example.aLetter);
+  expected << example.bytes[0] << example.bytes[1] << example.bytes[2];
+  expected << example.doubles[0] << example.doubles[1];
+  expected << example.aVector.x() << example.aVector.y();
+  for(int i = 0; i < 4; ++i)
+    expected << example.aMatrix.data()[i];
+  expected << static_cast<unsigned>(example.vectors.size());
+  for(const Vector3f& v : example.vectors)
+    expected << v.x() << v.y() << v.z();
+  expected << static_cast<unsigned>(example.inners.size());
+  for(const BinaryStreamingInner& inner : example.inners)
+    expected << inner.s << inner.text;
+  expected << static_cast<unsigned>(example.letters.size());
+  for(const BinaryStreamingExample::Letter letter : example.letters)
+    expected << static_cast<unsigned char>(letter);
+
+  ASSERT_EQ(expected.size(), fast.size());
+  EXPECT_EQ(0, memcmp(expected.data(), fast.data(), fast.size()));
+}
+
+GTEST_TEST(BinaryStreaming, RoundTrip)
+{
+  const BinaryStreamingExample example = createExample();
+  OutBinaryMemory out;
+  out << example;
+
+  BinaryStreamingExample read;
+  InBinaryMemory in(out.data(), out.size());
+  in >> read;
+
+  EXPECT_EQ(example.anInt, read.anInt);
+  EXPECT_EQ(example.aBool, read.aBool);
+  EXPECT_EQ(example.aFloat, read.aFloat);
+  EXPECT_EQ(static_cast<float>(example.anAngle), static_cast<float>(read.anAngle));
+  EXPECT_EQ(example.aLetter, read.aLetter);
+  EXPECT_EQ(0, memcmp(example.bytes, read.bytes, sizeof(example.bytes)));
+  EXPECT_EQ(example.doubles, read.doubles);
+  EXPECT_TRUE(example.aVector == read.aVector);
+  EXPECT_TRUE(example.aMatrix == read.aMatrix);
+  ASSERT_EQ(example.vectors.size(), read.vectors.size());
+  for(size_t i = 0; i < example.vectors.size(); ++i)
+    EXPECT_TRUE(example.vectors[i] == read.vectors[i]);
+  ASSERT_EQ(example.inners.size(), read.inners.size());
+  for(size_t i = 0; i < example.inners.size(); ++i)
+  {
+    EXPECT_EQ(example.inners[i].s, read.inners[i].s);
+    EXPECT_EQ(example.inners[i].text, read.inners[i].text);
+  }
+  EXPECT_EQ(example.letters, read.letters);
+}